@@ -0,0 +1,30 @@
+# Compare the gravity computed with the tree code to the gravity
+# computed by direct summation. This script expects the output
+# directories created by the run_all_models script.
+
+import glob
+import numpy as np
+
+reference = np.loadtxt("output-direct_sum_0/output_gravity/gravity-00000")
+
+# columns (counting from zero): 9 gravity norm, 11 gravity potential,
+# 16 gravity anomaly norm, 17-19 diagonal of the gravity gradient
+columns = {"gravity": 9, "potential": 11, "anomaly": 16, "gradient_zz": 19}
+
+timings = {}
+for line in open("timings.txt"):
+    if line.startswith("#"):
+        continue
+    method, angle, time = line.split()
+    timings[(method, angle)] = float(time)
+
+print("# opening_angle wall_time " + " ".join("max_rel_error_" + name for name in columns))
+print("direct_sum %g" % timings[("direct_sum", "0")])
+for directory in sorted(glob.glob("output-tree_code_*")):
+    angle = directory.split("_")[-1]
+    data = np.loadtxt(directory + "/output_gravity/gravity-00000")
+    errors = []
+    for name, column in columns.items():
+        scale = np.max(np.abs(reference[:, column]))
+        errors.append(np.max(np.abs(data[:, column] - reference[:, column])) / scale)
+    print("%s %g " % (angle, timings[("tree_code", angle)]) + " ".join("%.3e" % e for e in errors))
@@ -25,8 +25,12 @@
 
 #include <aspect/adiabatic_conditions/interface.h>
 
+#include <aspect/material_model/interface.h>
+
 #include <deal.II/base/parsed_function.h>
 
+#include <array>
+
 namespace aspect
 {
   namespace AdiabaticConditions
@@ -132,6 +136,35 @@ namespace aspect
          */
         unsigned int n_points;
 
+        /**
+         * An enum describing the different methods to integrate the
+         * profile downward from the surface.
+         */
+        enum IntegrationScheme
+        {
+          explicit_euler,
+          adaptive_runge_kutta
+        };
+
+        /**
+         * Selected method to integrate the profile.
+         */
+        IntegrationScheme integration_scheme;
+
+        /**
+         * Relative tolerance for the error of each step of the adaptive
+         * Runge-Kutta integration.
+         */
+        double integration_tolerance;
+
+        /**
+         * The depths at which the steps of the last adaptive Runge-Kutta
+         * integration started, together with the size the error estimate
+         * proposed for the following step. These are used to limit the step
+         * sizes when the profile is recomputed.
+         */
+        std::vector<std::pair<double,double> > previous_step_sizes;
+
         /**
          * Vectors of values of temperatures and pressures on a transect into
          * depth at which we have computed them. The public member functions
@@ -182,6 +215,39 @@ namespace aspect
          */
         Functions::ParsedFunction<1> surface_condition_function;
 
+        /**
+         * Integrate the profile from the given surface pressure and
+         * temperature with the adaptive Dormand-Prince method and fill the
+         * tables of pressures, temperatures, and densities.
+         */
+        void integrate_adaptive_runge_kutta (const double surface_pressure,
+                                             const double surface_temperature,
+                                             const int gravity_direction);
+
+        /**
+         * Evaluate the material model at the given depth, pressure
+         * (first component of the second argument), and temperature (second
+         * component), and return the derivatives of pressure and temperature
+         * with respect to depth. @p pressure_derivative is an estimate of
+         * the pressure derivative that is used for the pressure gradient
+         * input of the material model. The material model inputs and outputs
+         * are used as scratch objects for one evaluation point.
+         */
+        std::array<double,2>
+        compute_profile_derivatives (const double depth,
+                                     const std::array<double,2> &pressure_and_temperature,
+                                     const double pressure_derivative,
+                                     const int gravity_direction,
+                                     MaterialModel::MaterialModelInputs<dim> &in,
+                                     MaterialModel::MaterialModelOutputs<dim> &out) const;
+
+        /**
+         * Fill @p composition with the reference composition at the given
+         * position.
+         */
+        void compute_reference_composition (const Point<dim> &position,
+                                            std::vector<double> &composition) const;
+
         /**
          * Internal helper function. Returns the reference property at a
          * given point of the domain.
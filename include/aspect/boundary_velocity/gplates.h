@@ -26,7 +26,7 @@
 #include <aspect/simulator_access.h>
 
 #include <array>
-#include <deal.II/base/function_lib.h>
+#include <deal.II/base/table.h>
 
 
 namespace aspect
@@ -60,12 +60,47 @@ namespace aspect
           screen_output(const Tensor<1,2> &surface_point_one,
                         const Tensor<1,2> &surface_point_two) const;
 
+          /**
+           * The grid points and weights that are needed to compute the
+           * velocity at one position. The velocity is the sum over all
+           * entries of the theta and phi velocities stored at the grid
+           * point, each multiplied by the corresponding weight vector. The
+           * weights contain the bilinear interpolation in the lat/long grid,
+           * the conversion of spherical into cartesian velocities, and for 2D
+           * models the rotation into the model plane. They only depend on
+           * the position and on the size of the grid, and can therefore be
+           * used for all data files with the same grid.
+           */
+          struct InterpolationWeights
+          {
+            struct Entry
+            {
+              TableIndices<2> grid_point;
+              Tensor<1,dim> theta_weight;
+              Tensor<1,dim> phi_weight;
+            };
+
+            /**
+             * Close to the poles two bilinear interpolations are blended,
+             * so there are at most eight entries.
+             */
+            std::array<Entry,8> entries;
+            unsigned int n_entries;
+          };
+
           /**
            * Loads a gplates .gpml velocity file. Throws an exception if the
            * file does not exist.
+           *
+           * Only the root process reads and parses the file, and sends the
+           * resulting velocity grid to all other processes. If
+           * @p cache_filename is not empty, the velocity grid is stored in
+           * this file in binary form, and read from there instead of parsing
+           * the gpml file again if the content of the gpml file did not change.
            */
           void load_file(const std::string &filename,
-                         const MPI_Comm &comm);
+                         const MPI_Comm &comm,
+                         const std::string &cache_filename = "");
 
           /**
            * Returns the computed surface velocity in cartesian coordinates.
@@ -76,11 +111,36 @@ namespace aspect
            */
           Tensor<1,dim> surface_velocity(const Point<dim> &position) const;
 
+          /**
+           * Returns the surface velocity in cartesian coordinates at the
+           * position for which @p weights were computed by
+           * interpolation_weights().
+           */
+          Tensor<1,dim> surface_velocity(const InterpolationWeights &weights) const;
+
+          /**
+           * Compute the grid points and weights that are needed to evaluate
+           * the velocity at @p position.
+           */
+          InterpolationWeights interpolation_weights(const Point<dim> &position) const;
+
+          /**
+           * Return whether the velocity grid of this object has the same
+           * number of points in both directions, the same spacing, and the
+           * same rotation as the one of @p other, in which case interpolation
+           * weights computed by one of the objects can be used for the other
+           * one.
+           */
+          bool has_same_grid(const GPlatesLookup<dim> &other) const;
+
         private:
           /**
-           * Interpolation functions to access the velocities.
+           * Two tables (one for the theta and one for the phi component)
+           * which contain the velocities at every point of the lat/long
+           * grid. The data for phi == 2*pi is a copy of the one for phi == 0,
+           * which simplifies the interpolation.
            */
-          std::array<std::unique_ptr<Functions::InterpolatedUniformGridData<2>>, 2> velocities;
+          std::array<Table<2,double>, 2> velocity_values;
 
           /**
            * Distances between adjacent point in the Lat/Long grid
@@ -138,11 +198,29 @@ namespace aspect
           cartesian_surface_coordinates(const Tensor<1,3> &sposition) const;
 
           /**
-           * This function looks up the north- and east-velocities at a given
-           * position and converts them to cartesian velocities.
+           * This function adds the weights that are needed to look up the
+           * north- and east-velocities at a given position and to convert
+           * them to cartesian velocities to @p weights, all scaled by
+           * @p factor.
+           */
+          void
+          add_cartesian_velocity_weights(const std::array<double,3> &spherical_point,
+                                         const double factor,
+                                         InterpolationWeights &weights) const;
+
+          /**
+           * Read the velocity grid from the gpml file @p filename, or from
+           * @p cache_filename if that is not empty and contains the data for
+           * the current content of the gpml file. @p grid_size contains the
+           * number of grid points in theta and phi direction on return, and
+           * @p velocity_data the theta and then the phi velocities at all grid
+           * points, including the padding at phi == 2*pi.
            */
-          Tensor<1,dim>
-          cartesian_velocity_at_surface_point(const std::array<double,3> &spherical_point) const;
+          void
+          read_velocity_data(const std::string &filename,
+                             const std::string &cache_filename,
+                             std::array<unsigned int,2> &grid_size,
+                             std::vector<double> &velocity_data) const;
 
           /**
            * Returns cartesian velocities calculated from surface velocities
@@ -289,6 +367,12 @@ namespace aspect
          */
         double scale_factor;
 
+        /**
+         * Directory in which binary copies of the parsed velocity files are
+         * stored. Caching is disabled if this is empty.
+         */
+        std::string cache_directory;
+
         /**
          * Two user defined points that prescribe the plane from which the 2D
          * model takes the velocity boundary condition. One can think of this,
@@ -347,6 +431,13 @@ namespace aspect
          */
         std::string
         create_filename (const int timestep) const;
+
+        /**
+         * Return the name of the binary cache file for the velocity file
+         * @p filename, or an empty string if caching is disabled.
+         */
+        std::string
+        create_cache_filename (const std::string &filename) const;
     };
   }
 }
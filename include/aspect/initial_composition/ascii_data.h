@@ -67,6 +67,15 @@ namespace aspect
         initial_composition (const Point<dim> &position,
                              const unsigned int n_comp) const override;
 
+        /**
+         * Return the initial values of all compositional fields at the given
+         * positions. This converts each position into the coordinate system
+         * of the data file only once for all fields.
+         */
+        void
+        initial_compositions (const std::vector<Point<dim> > &positions,
+                              std::vector<std::vector<double> > &compositions) const override;
+
         /**
          * Declare the parameters this class takes through input files.
          */
@@ -77,6 +77,20 @@ namespace aspect
         virtual
         double initial_composition (const Point<dim> &position, const unsigned int n_comp) const = 0;
 
+        /**
+         * Return the initial values of all compositional fields at all of the
+         * given @p positions. @p compositions needs to have one entry per
+         * compositional field, each of which is resized to the number of
+         * positions. The default implementation calls initial_composition()
+         * for every position and field. Derived classes can overload this
+         * function if they can share work between the fields at one position,
+         * for example if finding the composition requires an expensive
+         * geometric search.
+         */
+        virtual
+        void initial_compositions (const std::vector<Point<dim> > &positions,
+                                   std::vector<std::vector<double> > &compositions) const;
+
 
         /**
          * Declare the parameters this class takes through input files. The
@@ -143,6 +157,16 @@ namespace aspect
         initial_composition (const Point<dim> &position,
                              const unsigned int n_comp) const;
 
+        /**
+         * Like initial_composition(), but for all compositional fields and all
+         * of the given @p positions at once. @p compositions is resized to the
+         * number of compositional fields, and each of its entries to the
+         * number of positions.
+         */
+        void
+        initial_compositions (const std::vector<Point<dim> > &positions,
+                              std::vector<std::vector<double> > &compositions) const;
+
         /**
          * A function that is used to register initial composition objects in
          * such a way that the Manager can deal with all of them without having
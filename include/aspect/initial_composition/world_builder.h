@@ -61,6 +61,14 @@ namespace aspect
          */
         double initial_composition (const Point<dim> &position, const unsigned int n_comp) const override;
 
+        /**
+         * Return the initial values of all compositional fields at the given
+         * positions. The depth of each position is only computed once for
+         * all fields.
+         */
+        void initial_compositions (const std::vector<Point<dim> > &positions,
+                                   std::vector<std::vector<double> > &compositions) const override;
+
     };
   }
 }
@@ -77,6 +77,17 @@ namespace aspect
         virtual
         double initial_temperature (const Point<dim> &position) const = 0;
 
+        /**
+         * Return the initial temperature at all of the given @p positions
+         * in @p temperatures, which is resized to the number of positions.
+         * The default implementation calls initial_temperature() for every
+         * position. Derived classes can overload this function if they can
+         * share work between the positions.
+         */
+        virtual
+        void initial_temperatures (const std::vector<Point<dim> > &positions,
+                                   std::vector<double> &temperatures) const;
+
 
         /**
          * Declare the parameters this class takes through input files. The
@@ -140,6 +151,15 @@ namespace aspect
         double
         initial_temperature (const Point<dim> &position) const;
 
+        /**
+         * Like initial_temperature(), but for all of the given @p positions at
+         * once. The result is stored in @p temperatures, which is resized to
+         * the number of positions.
+         */
+        void
+        initial_temperatures (const std::vector<Point<dim> > &positions,
+                              std::vector<double> &temperatures) const;
+
         /**
          * A function that is used to register initial temperature objects in such
          * a way that the Manager can deal with all of them without having to
@@ -26,6 +26,8 @@
 
 #include <deal.II/fe/fe_values.h>
 
+#include <map>
+
 namespace aspect
 {
   using namespace dealii;
@@ -104,12 +106,27 @@ namespace aspect
    * function get_lateral_averaging(), and then query that for the desired
    * averaged quantity.
    *
+   * The assignment of quadrature points to depth slices and the volume of
+   * each depth slice are computed once per mesh and set of depth bounds,
+   * and are reused by all subsequent calls until the mesh is refined or
+   * deformed. Requesting several properties in one call to
+   * compute_lateral_averages() computes all of them in a single loop over
+   * all cells.
+   *
    * @ingroup Simulator
    */
   template <int dim>
   class LateralAveraging : public SimulatorAccess<dim>
   {
     public:
+      /**
+       * Connect to the signals that indicate that the mesh has changed,
+       * either by refinement or by mesh deformation, so that the cached
+       * assignment of quadrature points to depth slices can be invalidated.
+       * This function needs to be called after initialize_simulator().
+       */
+      void initialize ();
+
       /**
        * @deprecated: This function is deprecated and only maintained for backward compatibilty.
        * Use the function compute_lateral_averages() with the same arguments instead.
@@ -299,6 +316,51 @@ namespace aspect
        */
       void
       get_vertical_mass_flux_averages(std::vector<double> &values) const;
+
+    private:
+      /**
+       * The data that describes which depth slice each quadrature point of
+       * the locally owned cells belongs to, for one set of depth bounds.
+       */
+      struct SliceData
+      {
+        /**
+         * The index of the depth slice of every quadrature point, in the
+         * order in which the locally owned cells and their quadrature points
+         * are traversed. Points outside of all slices are marked by
+         * numbers::invalid_unsigned_int.
+         */
+        std::vector<unsigned int> slice_indices;
+
+        /**
+         * The volume of each depth slice, summed over all processes.
+         */
+        std::vector<double> volumes;
+      };
+
+      /**
+       * Delete all cached slice data. This is called whenever the mesh
+       * changes.
+       */
+      void clear_cache ();
+
+      /**
+       * The quadrature formula used for the averaging. It only depends on
+       * the finite element and the geometry model and is therefore created
+       * once on first use.
+       */
+      mutable std::unique_ptr<Quadrature<dim> > quadrature_formula;
+
+      /**
+       * The cached slice data for each set of depth bounds that has been
+       * requested since the last time the mesh changed. Different plugins
+       * typically request averages with the same depth bounds in every
+       * time step, so the assignment of quadrature points to slices (which
+       * requires computing the depth of every quadrature point) and the
+       * slice volumes (which require a collective communication) are only
+       * computed once per mesh.
+       */
+      mutable std::map<std::vector<double>, SliceData> slice_data_cache;
   };
 }
 
@@ -500,6 +500,51 @@ namespace aspect
 
         bool include_initial_topography;
 
+        /**
+         * Whether the AMG preconditioner for the mesh velocity system should
+         * be kept between time steps instead of being rebuilt every time
+         * the system is solved.
+         */
+        bool reuse_mesh_deformation_preconditioner;
+
+        /**
+         * The matrix of the vector Laplace problem that determines the
+         * mesh velocity. Its sparsity pattern is kept between time steps
+         * as long as the mesh and the structure of the constraints do not
+         * change, and only the entries are recomputed.
+         */
+        LinearAlgebra::SparseMatrix mesh_matrix;
+
+        /**
+         * Whether mesh_matrix has a sparsity pattern that matches the
+         * current degrees of freedom. This is reset in setup_dofs().
+         */
+        bool mesh_matrix_sparsity_is_current;
+
+        /**
+         * The structure of mesh_velocity_constraints at the time the
+         * sparsity pattern of mesh_matrix was built: for each constrained
+         * degree of freedom its index, the number of degrees of freedom
+         * it is constrained to, and their indices. Used to detect whether
+         * the sparsity pattern needs to be rebuilt.
+         */
+        std::vector<types::global_dof_index> mesh_velocity_constraint_structure;
+
+        /**
+         * The AMG preconditioner for mesh_matrix. If
+         * reuse_mesh_deformation_preconditioner is set, it is kept between
+         * time steps and only rebuilt if the sparsity pattern changes or if
+         * the number of solver iterations has grown significantly compared
+         * to the solve right after it was built.
+         */
+        std::unique_ptr<LinearAlgebra::PreconditionAMG> mesh_preconditioner;
+
+        /**
+         * The number of iterations the mesh velocity solve took right after
+         * mesh_preconditioner was last built.
+         */
+        unsigned int mesh_preconditioner_reference_iterations;
+
         friend class Simulator<dim>;
         friend class SimulatorAccess<dim>;
     };
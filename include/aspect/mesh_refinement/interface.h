@@ -25,8 +25,11 @@
 #include <aspect/global.h>
 #include <aspect/plugins.h>
 #include <aspect/simulator_access.h>
+#include <aspect/material_model/interface.h>
 
+#include <map>
 #include <memory>
+#include <deal.II/base/table.h>
 #include <deal.II/base/table_handler.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/distributed/tria.h>
@@ -128,6 +131,20 @@ namespace aspect
         void
         tag_additional_cells () const;
 
+        /**
+         * Return the material properties this plugin needs at the support
+         * points of the temperature element. Before the execute() functions
+         * of the plugins are called, the manager evaluates the material model
+         * once on every locally owned cell for all properties requested by
+         * any plugin, and plugins can then access the results through
+         * Manager::get_material_property_at_temperature_support_points()
+         * instead of evaluating the material model themselves. The default
+         * implementation requests no properties.
+         */
+        virtual
+        MaterialModel::MaterialProperties::Property
+        get_needed_material_properties () const;
+
         /**
          * Declare the parameters this class takes through input files.
          * Derived classes should overload this function if they actually do
@@ -206,6 +223,33 @@ namespace aspect
         void
         tag_additional_cells () const;
 
+        /**
+         * Return the values of the material property @p property at the
+         * support points of the temperature element on all locally owned
+         * cells, indexed by the active cell index and the number of the
+         * support point. Support points are numbered in the same way as the
+         * degrees of freedom of the temperature element.
+         *
+         * The values are computed at the beginning of execute() for all
+         * properties some plugin has requested through
+         * Interface::get_needed_material_properties(), and this function can
+         * therefore only be called from within the execute() functions of
+         * the plugins. Only viscosities, densities, thermal expansion
+         * coefficients, specific heats, thermal conductivities, and
+         * compressibilities are available.
+         */
+        const Table<2,double> &
+        get_material_property_at_temperature_support_points (const MaterialModel::MaterialProperties::Property property) const;
+
+        /**
+         * Return the temperatures at the support points of the temperature
+         * element that were used as inputs for the material model
+         * evaluation, see
+         * get_material_property_at_temperature_support_points().
+         */
+        const Table<2,double> &
+        get_temperatures_at_temperature_support_points () const;
+
         /**
          * Declare the parameters of all known mesh refinement plugins, as
          * well as of ones this class has itself.
@@ -319,6 +363,24 @@ namespace aspect
          * parameter file.
          */
         std::list<std::unique_ptr<Interface<dim> > > mesh_refinement_objects;
+
+        /**
+         * Evaluate the material model for the given @p properties at the
+         * support points of the temperature element on all locally owned
+         * cells, and store the results in the member variables below. The
+         * cells are worked on in parallel.
+         */
+        void
+        evaluate_material_model_at_temperature_support_points (const MaterialModel::MaterialProperties::Property properties) const;
+
+        /**
+         * The material properties and the temperatures at the support points
+         * of the temperature element, as computed by
+         * evaluate_material_model_at_temperature_support_points(). They are
+         * only kept during one call of execute().
+         */
+        mutable std::map<MaterialModel::MaterialProperties::Property, Table<2,double> > material_properties_at_support_points;
+        mutable Table<2,double> temperatures_at_support_points;
     };
 
 
@@ -52,6 +52,13 @@ namespace aspect
          */
         void
         execute (Vector<float> &error_indicators) const override;
+
+        /**
+         * Request the density and the specific heat, which the manager computes at the
+         * support points of the temperature element for all plugins at once.
+         */
+        MaterialModel::MaterialProperties::Property
+        get_needed_material_properties () const override;
     };
   }
 }
@@ -373,6 +373,70 @@ namespace aspect
       }
     };
 
+    /**
+     * This enum represents the different choices for the time integrator
+     * used to solve the reaction equations in the operator splitting
+     * scheme. See @p reaction_solver_type.
+     */
+    struct ReactionSolverType
+    {
+      enum Kind
+      {
+        fixed_step,
+        adaptive_step
+      };
+
+      static const std::string pattern()
+      {
+        return "fixed step|adaptive step";
+      }
+
+      static Kind
+      parse(const std::string &input)
+      {
+        if (input == "fixed step")
+          return fixed_step;
+        else if (input == "adaptive step")
+          return adaptive_step;
+        else
+          AssertThrow(false, ExcNotImplemented());
+
+        return Kind();
+      }
+    };
+
+    /**
+     * This enum represents the different methods that can be used to
+     * accelerate the convergence of the Picard (fixed point) iterations of
+     * the iterated Stokes solver schemes.
+     */
+    struct NonlinearSolverAcceleration
+    {
+      enum Kind
+      {
+        none,
+        anderson
+      };
+
+      static const std::string pattern()
+      {
+        return "none|Anderson";
+      }
+
+      static Kind
+      parse(const std::string &input)
+      {
+        if (input == "none")
+          return none;
+        else if (input == "Anderson")
+          return anderson;
+        else
+          AssertThrow(false, ExcNotImplemented());
+
+        return Kind();
+      }
+    };
+
     /**
      * Constructor. Fills the values of member functions from the given
      * parameter object.
@@ -443,6 +507,8 @@ namespace aspect
 
     typename AdvectionStabilizationMethod::Kind advection_stabilization_method;
     double                         nonlinear_tolerance;
+    typename NonlinearSolverAcceleration::Kind nonlinear_solver_acceleration;
+    unsigned int                   nonlinear_solver_acceleration_depth;
     bool                           resume_computation;
     double                         start_time;
     double                         CFL_number;
@@ -453,9 +519,11 @@ namespace aspect
     bool                           use_conduction_timestep;
     bool                           convert_to_years;
     std::string                    output_directory;
+    bool                           append_only_statistics;
     double                         surface_pressure;
     double                         adiabatic_surface_temperature;
     unsigned int                   timing_output_frequency;
+    bool                           detailed_timing_output;
     unsigned int                   max_nonlinear_iterations;
     unsigned int                   max_nonlinear_iterations_in_prerefinement;
     bool                           use_operator_splitting;
@@ -474,6 +542,7 @@ namespace aspect
 
     // subsection: Advection solver parameters
     unsigned int                   advection_gmres_restart_length;
+    bool                           reuse_material_model_evaluation_for_compositional_fields;
 
     // subsection: Stokes solver parameters
     bool                           use_direct_stokes_solver;
@@ -498,6 +567,8 @@ namespace aspect
     // subsection: Operator splitting parameters
     double                         reaction_time_step;
     unsigned int                   reaction_steps_per_advection_step;
+    typename ReactionSolverType::Kind reaction_solver_type;
+    double                         reaction_solver_tolerance;
 
     // subsection: Diffusion solver parameters
     double                         diffusion_length_scale;
@@ -586,9 +657,13 @@ namespace aspect
     double                         refinement_fraction;
     double                         coarsening_fraction;
     bool                           adapt_by_fraction_of_cells;
+    bool                           skip_unchanged_mesh_refinement;
     unsigned int                   min_grid_level;
     std::vector<double>            additional_refinement_times;
     unsigned int                   adaptive_refinement_interval;
+    bool                           adapt_refinement_interval_to_flow;
+    double                         cell_advection_between_refinements;
+    unsigned int                   refinement_buffer_layers;
     bool                           skip_solvers_on_initial_refinement;
     bool                           skip_setup_initial_conditions_on_initial_refinement;
     bool                           run_postprocessors_on_initial_refinement;
@@ -623,6 +698,7 @@ namespace aspect
      */
     int                            checkpoint_time_secs;
     int                            checkpoint_steps;
+    bool                           write_checkpoint_in_background_thread;
     /**
      * @}
      */
@@ -40,11 +40,27 @@ namespace aspect
     class CompositionStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the composition statistics.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some temperature statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The integrals, minima, and maxima of each compositional field over
+         * the whole domain.
+         */
+        std::vector<double> compositional_integrals;
+        std::vector<double> min_compositions;
+        std::vector<double> max_compositions;
     };
   }
 }
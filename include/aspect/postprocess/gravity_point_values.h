@@ -245,6 +245,29 @@ namespace aspect
           list_of_points
         } sampling_scheme;
 
+        /**
+         * Specify how the gravity field at the satellite points is computed
+         * from the density at the quadrature points: either by summing the
+         * contributions of all quadrature points directly, or by using a
+         * tree code that approximates the contribution of groups of distant
+         * quadrature points by a multipole expansion.
+         */
+        enum EvaluationMethod
+        {
+          direct_sum,
+          tree_code
+        } evaluation_method;
+
+        /**
+         * Parameter for the tree code evaluation method: The opening angle,
+         * i.e., the ratio between the size of a group of quadrature points
+         * and its distance to the satellite below which the contribution of
+         * the group is approximated by its multipole expansion. Smaller values
+         * are more accurate but more expensive; a value of zero reproduces
+         * the direct sum.
+         */
+        double opening_angle;
+
         /**
          * Parameter for the list of points sampling scheme:
          * List of radius coordinates for the list of points sampling scheme.
@@ -40,11 +40,27 @@ namespace aspect
     class HeatFluxStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the heat flux through each
+         * boundary part.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some heat_flux statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The heat flux through each boundary part, in the order of the
+         * boundary indicators returned by
+         * GeometryModel::Interface::get_used_boundary_indicators().
+         */
+        std::vector<double> boundary_fluxes;
     };
   }
 }
@@ -26,9 +26,12 @@
 #include <aspect/plugins.h>
 #include <aspect/simulator_access.h>
 
+#include <functional>
 #include <memory>
 #include <deal.II/base/table_handler.h>
 #include <deal.II/base/parameter_handler.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/fe/fe_values.h>
 
 #include <boost/serialization/split_member.hpp>
 #include <boost/core/demangle.hpp>
@@ -53,6 +56,162 @@ namespace aspect
   namespace Postprocess
   {
 
+    /**
+     * A class that collects values that need to be summed up, or whose
+     * maximum or minimum needs to be computed, over all processors, so that
+     * all of these reductions can be done in as few collective
+     * communications as possible. Values are registered by reference using
+     * the add_sum(), add_max() and add_min() functions, and are replaced by
+     * their reduced value over all processors when reduce() is called.
+     *
+     * The postprocessor manager creates one object of this class every time
+     * it runs the postprocessors, passes it to the
+     * Interface::compute_local_contributions() function of all of them, and
+     * then calls reduce() before the Interface::execute() functions are
+     * called. Consequently, postprocessors can register their local partial
+     * results in compute_local_contributions(), and use the global values in
+     * execute(), without having to communicate themselves.
+     *
+     * @ingroup Postprocessing
+     */
+    class ReductionBuffer
+    {
+      public:
+        /**
+         * Register @p value to be replaced by its sum over all processors.
+         */
+        void add_sum (double &value);
+
+        /**
+         * Register @p value to be replaced by its maximum over all
+         * processors.
+         */
+        void add_max (double &value);
+
+        /**
+         * Register @p value to be replaced by its minimum over all
+         * processors.
+         */
+        void add_min (double &value);
+
+        /**
+         * Register all elements of @p values to be replaced by their sums
+         * over all processors.
+         */
+        void add_sum (std::vector<double> &values);
+
+        /**
+         * Register all elements of @p values to be replaced by their maxima
+         * over all processors.
+         */
+        void add_max (std::vector<double> &values);
+
+        /**
+         * Register all elements of @p values to be replaced by their minima
+         * over all processors.
+         */
+        void add_min (std::vector<double> &values);
+
+        /**
+         * Compute the sums, maxima, and minima of all registered values over
+         * all processors in @p mpi_communicator, write them into the
+         * registered variables, and then forget about these variables. This
+         * requires at most two collective communications, independent of the
+         * number of registered values.
+         *
+         * This function needs to be called on all processors, and all of
+         * them need to have registered the same number of values of each
+         * kind.
+         */
+        void reduce (const MPI_Comm &mpi_communicator);
+
+      private:
+        /**
+         * Pointers to the values that are to be summed up, and to those
+         * whose maxima and minima are to be computed.
+         */
+        std::vector<double *> sum_values;
+        std::vector<double *> max_values;
+        std::vector<double *> min_values;
+    };
+
+
+
+    /**
+     * A class that lets several postprocessors compute quantities on all
+     * locally owned cells in one common loop over these cells, instead of
+     * each of them looping over all cells on its own. Postprocessors
+     * register functions ("kernels") that are called on every locally owned
+     * cell with an FEValues object that has been reinitialized on this
+     * cell. Kernels that use the same quadrature formula share the same
+     * FEValues object, which is created with the union of the update flags
+     * they request.
+     *
+     * The postprocessor manager creates one object of this class every time
+     * it runs the postprocessors, passes it to the
+     * Interface::compute_local_contributions() function of all of them, and
+     * then calls execute() before it reduces the values registered with the
+     * ReductionBuffer. Consequently, kernels can accumulate the local
+     * contributions to integrals and extrema into variables that have been
+     * registered with the ReductionBuffer.
+     *
+     * @ingroup Postprocessing
+     */
+    template <int dim>
+    class CellSweep
+    {
+      public:
+        /**
+         * The type of the functions that are called on every locally owned
+         * cell.
+         */
+        using Kernel = std::function<void (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                           const FEValues<dim> &fe_values)>;
+
+        /**
+         * Constructor. The objects given as arguments need to live at least
+         * as long as this object.
+         */
+        CellSweep (const Mapping<dim> &mapping,
+                   const DoFHandler<dim> &dof_handler);
+
+        /**
+         * Register a kernel that will be called on every locally owned cell
+         * with an FEValues object for the given quadrature formula that
+         * provides at least the given update flags.
+         */
+        void add_kernel (const Quadrature<dim> &quadrature,
+                         const UpdateFlags update_flags,
+                         const Kernel &kernel);
+
+        /**
+         * Loop over all locally owned cells and call all registered kernels
+         * on each of them, then forget about the kernels.
+         */
+        void execute ();
+
+      private:
+        /**
+         * A group of kernels that share a quadrature formula.
+         */
+        struct KernelGroup
+        {
+          Quadrature<dim> quadrature;
+          UpdateFlags update_flags;
+          std::vector<Kernel> kernels;
+        };
+
+        const Mapping<dim> &mapping;
+        const DoFHandler<dim> &dof_handler;
+
+        /**
+         * The registered kernels, grouped by their quadrature formula.
+         */
+        std::vector<KernelGroup> kernel_groups;
+    };
+
+
+
     /**
      * This class declares the public interface of postprocessors.
      * Postprocessors must implement a function that can be called at the end
@@ -89,6 +248,34 @@ namespace aspect
          */
         virtual void update ();
 
+        /**
+         * Compute the parts of the statistics of this postprocessor that
+         * need to be summed up, or whose maximum or minimum needs to be
+         * computed, over all processors, and register them with
+         * @p reductions. The manager calls this function for all
+         * postprocessors before the update() and execute() functions of any
+         * of them, and does all of the requested reductions at once, so that
+         * execute() can then use the global values without having to
+         * communicate. Postprocessors that do not depend on the results of
+         * other postprocessors for their global statistics should prefer this
+         * to calling Utilities::MPI::sum() or similar functions in execute().
+         *
+         * Contributions that require a loop over all cells should be
+         * computed by registering a kernel with @p cell_sweep rather than by
+         * looping over the cells in this function. All kernels of all
+         * postprocessors are executed in one common loop over the cells
+         * after this function has been called for all postprocessors, and
+         * before the reductions are done. Computations that can not be
+         * split into independent operations on each cell, such as the
+         * consistent boundary flux of the heat flux statistics, can be done
+         * in this function directly. Postprocessors that only need one of
+         * the two arguments ignore the other one.
+         *
+         * The default implementation does nothing.
+         */
+        virtual void compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                  ReductionBuffer &reductions);
+
         /**
          * Execute this postprocessor. Derived classes will implement this
          * function to do whatever they want to do to evaluate the solution at
@@ -352,6 +539,12 @@ namespace aspect
          * parameter file.
          */
         std::vector<std::unique_ptr<Interface<dim> > > postprocessors;
+
+        /**
+         * The names of the postprocessors in the list above, in the same
+         * order.
+         */
+        std::vector<std::string> sorted_postprocessor_names;
     };
 
 
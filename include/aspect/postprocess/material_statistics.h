@@ -41,11 +41,28 @@ namespace aspect
     class MaterialStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the mass, the integral of the
+         * viscosity, and the volume of the domain.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some material property statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The integrals of the density and the viscosity, and the volume of
+         * the domain.
+         */
+        double mass;
+        double viscosity_integral;
+        double volume;
     };
   }
 }
@@ -48,6 +48,13 @@ namespace aspect
          */
         PointValues ();
 
+        /**
+         * Connect to the signals that indicate that the mesh has changed,
+         * so that the cached locations of the evaluation points can be
+         * invalidated.
+         */
+        void initialize () override;
+
         /**
          * Evaluate the solution and determine the values at the
          * selected points.
@@ -96,6 +103,23 @@ namespace aspect
          */
         void set_last_output_time (const double current_time);
 
+        /**
+         * Find the locally owned cells that contain the evaluation points,
+         * and the coordinates of the points on the reference cell. This
+         * function builds an R-tree of the bounding boxes of all locally owned
+         * cells and then locates all points in one pass. The result is stored
+         * in @p cell_points and remains valid until the mesh changes, either
+         * through refinement or through mesh deformation.
+         */
+        void update_point_locations ();
+
+        /**
+         * Evaluate the solution at all evaluation points, using the cached
+         * point locations. Points are evaluated grouped by cell, and the
+         * values are communicated in a single collective operation.
+         */
+        std::vector<Vector<double> > evaluate_solution_at_points () const;
+
         /**
          * Interval between the generation of output in seconds.
          */
@@ -120,6 +144,48 @@ namespace aspect
          * as natural coordinates or not.
          */
         bool use_natural_coordinates;
+
+        /**
+         * A structure that stores all evaluation points that lie in a
+         * single locally owned cell.
+         */
+        struct CellPoints
+        {
+          /**
+           * The cell that contains the points.
+           */
+          typename DoFHandler<dim>::active_cell_iterator cell;
+
+          /**
+           * The location of the points on the reference cell.
+           */
+          std::vector<Point<dim> > reference_points;
+
+          /**
+           * The indices of the points in @p evaluation_points_cartesian.
+           */
+          std::vector<unsigned int> point_indices;
+        };
+
+        /**
+         * The cached list of locally owned cells that contain evaluation
+         * points, together with the location of these points.
+         */
+        std::vector<CellPoints> cell_points;
+
+        /**
+         * For each evaluation point, the number of processes that own a cell
+         * that contains the point. This is usually one, but can be larger
+         * than one for points on the boundary between cells owned by
+         * different processes.
+         */
+        std::vector<unsigned int> n_processes_per_point;
+
+        /**
+         * Whether the cached @p cell_points are up to date with the current
+         * mesh.
+         */
+        bool point_locations_valid;
     };
   }
 }
@@ -39,11 +39,27 @@ namespace aspect
     class PressureStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the pressure statistics.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some pressure statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The integral, minimum, and maximum of the pressure over the whole
+         * domain.
+         */
+        double pressure_integral;
+        double min_pressure;
+        double max_pressure;
     };
   }
 }
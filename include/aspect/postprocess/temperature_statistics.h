@@ -39,11 +39,27 @@ namespace aspect
     class TemperatureStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the temperature statistics.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some temperature statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The integral, minimum, and maximum of the temperature over the
+         * whole domain.
+         */
+        double temperature_integral;
+        double min_temperature;
+        double max_temperature;
     };
   }
 }
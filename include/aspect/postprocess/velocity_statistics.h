@@ -39,11 +39,26 @@ namespace aspect
     class VelocityStatistics : public Interface<dim>, public ::aspect::SimulatorAccess<dim>
     {
       public:
+        /**
+         * Compute the local contributions to the velocity statistics.
+         */
+        void
+        compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                     ReductionBuffer &reductions) override;
+
         /**
          * Evaluate the solution for some velocity statistics.
          */
         std::pair<std::string,std::string>
         execute (TableHandler &statistics) override;
+
+      private:
+        /**
+         * The integral of the square of the velocity, and the maximal
+         * velocity over the whole domain.
+         */
+        double velocity_square_integral;
+        double max_velocity;
     };
   }
 }
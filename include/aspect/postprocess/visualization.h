@@ -25,6 +25,7 @@
 #include <aspect/postprocess/interface.h>
 #include <aspect/simulator_access.h>
 #include <aspect/plugins.h>
+#include <aspect/material_model/interface.h>
 
 #include <deal.II/base/thread_management.h>
 #include <deal.II/numerics/data_postprocessor.h>
@@ -222,10 +223,164 @@ namespace aspect
            */
           virtual
           void load (const std::map<std::string, std::string> &status_strings);
+
+          /**
+           * Visualization postprocessors that obtain the material model
+           * inputs and outputs through the function evaluate_material_model()
+           * and that need additional material model outputs need to create
+           * these additional outputs in this function. The shared material
+           * model evaluation calls this function for all visualization
+           * postprocessors, so that the material model is evaluated once
+           * with the union of all requested additional outputs.
+           *
+           * The default implementation does nothing.
+           *
+           * @param[in,out] outputs The material model outputs object to which
+           * additional outputs should be attached. Implementations should
+           * only attach an additional output if one of the same type is not
+           * yet present.
+           */
+          virtual
+          void
+          create_additional_material_model_outputs (MaterialModel::MaterialModelOutputs<dim> &outputs) const;
+      };
+
+
+
+      /**
+       * A structure that holds the material model inputs and outputs at the
+       * evaluation points of one cell of the graphical output.
+       */
+      template <int dim>
+      struct MaterialModelEvaluation
+      {
+        /**
+         * Constructor. Initializes the material model inputs from the
+         * solution values and gradients in @p input_data, and creates
+         * material model outputs of matching size.
+         */
+        MaterialModelEvaluation (const DataPostprocessorInputs::Vector<dim> &input_data,
+                                 const Introspection<dim> &introspection);
+
+        /**
+         * The material model inputs at the evaluation points. The strain
+         * rate is always computed.
+         */
+        MaterialModel::MaterialModelInputs<dim> in;
+
+        /**
+         * The material model outputs at the evaluation points, including
+         * all additional outputs that any of the visualization
+         * postprocessors requested.
+         */
+        MaterialModel::MaterialModelOutputs<dim> out;
+      };
+
+
+
+      /**
+       * A class that evaluates the material model at the evaluation points of
+       * the graphical output at most once per cell and output step, and
+       * shares the result between all visualization postprocessors that
+       * need material properties. Without this, every visualization
+       * postprocessor would evaluate the material model on the same points,
+       * which can make graphical output expensive for complex material
+       * models.
+       *
+       * DataOut calls all visualization postprocessors for one cell before
+       * moving on to the next cell, possibly on several threads in
+       * parallel. This class therefore stores the result of the most recent
+       * evaluation separately for each thread.
+       */
+      template <int dim>
+      class MaterialModelEvaluationCache : public SimulatorAccess<dim>
+      {
+        public:
+          /**
+           * Constructor.
+           */
+          MaterialModelEvaluationCache ();
+
+          /**
+           * Set the list of visualization postprocessors whose additional
+           * material model outputs need to be created.
+           */
+          void
+          initialize (const std::list<std::unique_ptr<Interface<dim> > > &postprocessors);
+
+          /**
+           * Invalidate all stored evaluations. This needs to be called every
+           * time before graphical output is generated, since the solution
+           * has changed since the last output.
+           */
+          void
+          clear ();
+
+          /**
+           * Return the material model inputs and outputs at the evaluation
+           * points of @p input_data. If the material model has already been
+           * evaluated on the same cell and the same points since the last
+           * call to clear(), the stored result is returned. Otherwise the
+           * material model is evaluated and the result stored.
+           */
+          const MaterialModelEvaluation<dim> &
+          evaluate (const DataPostprocessorInputs::Vector<dim> &input_data) const;
+
+        private:
+          /**
+           * The data stored for every thread.
+           */
+          struct Entry
+          {
+            Entry ();
+
+            /**
+             * The value of the @p generation counter at the time this entry
+             * was computed.
+             */
+            unsigned int generation;
+
+            /**
+             * The evaluation points and the result of the evaluation.
+             */
+            std::vector<Point<dim> > evaluation_points;
+            std::shared_ptr<MaterialModelEvaluation<dim> > evaluation;
+          };
+
+          /**
+           * A pointer to the list of visualization postprocessors.
+           */
+          const std::list<std::unique_ptr<Interface<dim> > > *postprocessors;
+
+          /**
+           * A counter that is incremented every time clear() is called.
+           * Entries computed with a different value are outdated.
+           */
+          unsigned int generation;
+
+          /**
+           * The most recent evaluation on each thread.
+           */
+          mutable Threads::ThreadLocalStorage<Entry> entries;
       };
 
 
 
+      /**
+       * Return the material model inputs and outputs at the evaluation
+       * points of @p input_data, using the material model evaluation
+       * shared by all visualization postprocessors. This function is meant
+       * to be called from the evaluate_vector_field() function of
+       * visualization postprocessors in place of evaluating the material
+       * model themselves.
+       */
+      template <int dim>
+      const MaterialModelEvaluation<dim> &
+      evaluate_material_model (const SimulatorAccess<dim> &simulator_access,
+                               const DataPostprocessorInputs::Vector<dim> &input_data);
+
+
+
       /**
        * As explained in the documentation of the Interface class, the second
        * kind of visualization plugin is one that wants to generate cell-wise
@@ -328,6 +483,13 @@ namespace aspect
         void
         update () override;
 
+        /**
+         * Return the material model evaluation that is shared by all
+         * visualization postprocessors.
+         */
+        const VisualizationPostprocessors::MaterialModelEvaluationCache<dim> &
+        get_material_model_evaluation_cache () const;
+
         /**
          * A function that is used to register visualization postprocessor
          * objects in such a way that the Manager can deal with all of them
@@ -530,7 +692,8 @@ namespace aspect
          * File operations can potentially take a long time, blocking the
          * progress of the rest of the model run. Setting this variable to
          * 'true' moves this process into a background thread, while the
-         * rest of the model continues.
+         * rest of the model continues. This is supported for VTU output,
+         * grouped or not, but not for HDF5 output.
          */
         bool write_in_background_thread;
 
@@ -562,12 +725,34 @@ namespace aspect
                      const std::string temporary_filename,
                      const std::string *file_contents);
 
+        /**
+         * A function that writes the text in the last argument into an
+         * already existing file with the name given in the first argument,
+         * starting at the byte position given in the second argument. This
+         * is used to write the pieces of grouped VTU files on a background
+         * thread: every process writes its own piece into the shared file,
+         * and the positions are computed beforehand on the main thread so
+         * that no MPI communication is necessary while writing. Like
+         * writer(), the function takes over ownership of the file contents
+         * and deletes them at the end of its work.
+         */
+        static
+        void offset_writer (const std::string filename,
+                            const std::size_t offset,
+                            const std::string *file_contents);
+
         /**
          * A list of postprocessor objects that have been requested in the
          * parameter file.
          */
         std::list<std::unique_ptr<VisualizationPostprocessors::Interface<dim> > > postprocessors;
 
+        /**
+         * The material model evaluation shared by all postprocessors in
+         * the list above.
+         */
+        VisualizationPostprocessors::MaterialModelEvaluationCache<dim> material_model_evaluation_cache;
+
         /**
          * A structure that keeps some history about past output operations.
          * These variables are grouped into a structure because we need them
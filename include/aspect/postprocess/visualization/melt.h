@@ -60,6 +60,12 @@ namespace aspect
           evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                                 std::vector<Vector<double> > &computed_quantities) const  override;
 
+          /**
+           * Attach the melt outputs to the material model outputs.
+           */
+          void
+          create_additional_material_model_outputs (MaterialModel::MaterialModelOutputs<dim> &outputs) const override;
+
           /**
            * Declare the parameters this class takes through input files.
            */
@@ -69,6 +69,13 @@ namespace aspect
           evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                                 std::vector<Vector<double> > &computed_quantities) const override;
 
+          /**
+           * Let the material model attach its named additional outputs to
+           * the material model outputs.
+           */
+          void
+          create_additional_material_model_outputs (MaterialModel::MaterialModelOutputs<dim> &outputs) const override;
+
         private:
           std::vector<std::string> property_names;
       };
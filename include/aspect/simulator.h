@@ -26,6 +26,7 @@
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/thread_local_storage.h>
 
 DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 
@@ -46,6 +47,8 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #include <aspect/simulator_access.h>
 #include <aspect/lateral_averaging.h>
 #include <aspect/simulator_signals.h>
+#include <aspect/simulator/scratch_object_pool.h>
+#include <aspect/simulator/anderson_acceleration.h>
 #include <aspect/material_model/interface.h>
 #include <aspect/heating_model/interface.h>
 #include <aspect/geometry_model/initial_topography_model/interface.h>
@@ -69,6 +72,8 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #include <boost/iostreams/tee.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 namespace aspect
 {
@@ -121,6 +126,45 @@ namespace aspect
     template <int dim>      class Manager;
   }
 
+  namespace internal
+  {
+    /**
+     * A table for the statistics of a model run. In addition to the
+     * functionality of the TableHandler base class, this class can write
+     * individual rows of the table as text. This allows appending the rows
+     * that were added since the last output to the statistics file without
+     * formatting the whole table again.
+     */
+    class StatisticsTable : public TableHandler
+    {
+      public:
+        /**
+         * Make the number of rows of the table available.
+         */
+        using TableHandler::n_rows;
+
+        /**
+         * Return the number of columns of the table.
+         */
+        unsigned int n_columns () const;
+
+        /**
+         * Write the rows of the table starting at row @p first_row in the
+         * same format as TableHandler::write_text() with the format
+         * TableHandler::simple_table_with_separate_column_description,
+         * i.e., with the entries of a row separated by a single space.
+         * Before these rows, write a description of all columns starting
+         * at column @p first_column, in the form of a comment line
+         * "# n: name" per column. Columns that were added after the
+         * description was written for the first time therefore appear as
+         * additional comment lines between two rows.
+         */
+        void write_text_rows (std::ostream &out,
+                              const unsigned int first_column,
+                              const unsigned int first_row) const;
+    };
+  }
+
   struct DefectCorrectionResiduals
   {
     double initial_residual;
@@ -739,10 +783,24 @@ namespace aspect
       /**
        * Initiate the assembly of the Stokes matrix and right hand side.
        *
+       * If @p residual_only is true, only the right hand side is assembled,
+       * regardless of the values of the flags that otherwise determine
+       * whether the matrix is rebuilt, and no data that is only needed to
+       * apply or precondition the matrix (like the viscosity used by the
+       * matrix-free Stokes solver) is computed. This is useful to evaluate
+       * the residual of the defect correction or Newton systems, whose
+       * right hand side is the nonlinear residual, for example during
+       * a line search. This requires that the velocity constraints are
+       * homogeneous, i.e., that this function is called from a defect
+       * correction or Newton solver after the first nonlinear iteration,
+       * or that no velocity boundary conditions are prescribed. The flags
+       * that determine whether the matrix is rebuilt keep the values they
+       * had before the call.
+       *
        * This function is implemented in
        * <code>source/simulator/assembly.cc</code>.
        */
-      void assemble_stokes_system ();
+      void assemble_stokes_system (const bool residual_only = false);
 
       /**
        * Assemble and solve the temperature equation.
@@ -791,6 +849,33 @@ namespace aspect
       double assemble_and_solve_stokes (const bool compute_initial_residual = false,
                                         double *initial_nonlinear_residual = nullptr);
 
+      /**
+       * Return a vector that contains the velocity and pressure blocks of
+       * @p vector, with the pressure divided by the pressure scaling, so
+       * that velocity and pressure are of comparable magnitude. This is the
+       * form in which Stokes iterates are handed to the nonlinear solver
+       * acceleration.
+       *
+       * This function is implemented in
+       * <code>source/simulator/solver_schemes.cc</code>.
+       */
+      LinearAlgebra::BlockVector get_scaled_stokes_iterate (const LinearAlgebra::BlockVector &vector) const;
+
+      /**
+       * Given the velocity and pressure at the current linearization point
+       * in the form returned by get_scaled_stokes_iterate() and the
+       * solution of the Stokes system that was solved for this
+       * linearization point, apply the nonlinear solver acceleration. If
+       * @p acceleration modifies the iterate, write the result into the
+       * velocity and pressure blocks of both the solution vector and the
+       * current linearization point.
+       *
+       * This function is implemented in
+       * <code>source/simulator/solver_schemes.cc</code>.
+       */
+      void apply_nonlinear_solver_acceleration (internal::AndersonAcceleration &acceleration,
+                                                const LinearAlgebra::BlockVector &scaled_linearization_point);
+
       /**
        * Assemble and solve the defect correction form of the Stokes equation.
        * This function takes a structure of DefectCorrectionResiduals which
@@ -1212,6 +1297,21 @@ namespace aspect
                                      const AdvectionField &advection_field,
                                      const bool skip_interior_cells = false) const;
 
+      /**
+       * Return the artificial viscosity for the temperature or composition
+       * on each local cell, as computed by get_artificial_viscosity(). If
+       * the artificial viscosity only depends on the solution of the
+       * previous time steps (which is the case for the entropy viscosity
+       * method), the result is cached and reused every time the advection
+       * system of this field is assembled within the same time step,
+       * rather than being recomputed for every nonlinear iteration.
+       *
+       * This function is implemented in
+       * <code>source/simulator/entropy_viscosity.cc</code>.
+       */
+      const Vector<double> &
+      get_cached_artificial_viscosity (const AdvectionField &advection_field);
+
       /**
        * Compute the seismic shear wave speed, Vs anomaly per element. we
        * compute the anomaly by computing a smoothed (over 200 km or so)
@@ -1539,6 +1639,16 @@ namespace aspect
        */
       double get_maximal_velocity (const LinearAlgebra::BlockVector &solution) const;
 
+      /**
+       * Compute the maximum over all cells of the largest velocity on a cell
+       * divided by the size of the cell, i.e., the inverse of the time it
+       * takes the flow to cross the cell where this happens fastest.
+       *
+       * This function is implemented in
+       * <code>source/simulator/helper_functions.cc</code>.
+       */
+      double get_maximal_speed_over_meshsize (const LinearAlgebra::BlockVector &solution) const;
+
       /**
        * Compute the variation (i.e., the difference between maximal and
        * minimal value) of the entropy $(T-\bar T)^2$ where $\bar T$ is the
@@ -1575,6 +1685,39 @@ namespace aspect
        */
       void maybe_write_timing_output () const;
 
+      /**
+       * If detailed timing output was requested, append the wall time spent
+       * in each section of the computing timer since the last call of this
+       * function to the file <code>timing.jsonl</code> in the output
+       * directory. Each call writes one line that contains a JSON object
+       * with the minimum, average, and maximum of these times over all
+       * processes. Sections whose names contain a colon, such as
+       * "Particles: Sort", are written as subsections of the section
+       * named by the part before the colon.
+       *
+       * This function is implemented in
+       * <code>source/simulator/helper_functions.cc</code>.
+       */
+      void write_detailed_timing_output () const;
+
+      /**
+       * If detailed timing output was requested, add the wall time that has
+       * passed since @p start_time to the part of a threaded cell loop
+       * named @p section_name, for example the material model evaluation
+       * during the assembly. The computing timer can not be used inside the
+       * workers of a WorkStream loop, because its sections can not be
+       * entered by several threads at the same time. This function can be
+       * called from several threads without synchronization, and the
+       * times of all threads are summed. They are written by write_detailed_timing_output() like
+       * the sections of the computing timer, with the number of calls
+       * being the number of cells.
+       *
+       * This function is implemented in
+       * <code>source/simulator/helper_functions.cc</code>.
+       */
+      void add_detailed_worker_timing (const char *section_name,
+                                       const std::chrono::steady_clock::time_point &start_time) const;
+
       /**
        * Check if a checkpoint should be written in this timestep. If so create
        * one. Returns whether a checkpoint was written.
@@ -1854,7 +1997,7 @@ namespace aspect
        * This variable is written to disk after every time step, by the
        * Simulator::output_statistics() function.
        */
-      TableHandler                        statistics;
+      internal::StatisticsTable           statistics;
 
       /**
        * The following two variables keep track which parts of the statistics
@@ -1873,8 +2016,35 @@ namespace aspect
       std::size_t                         statistics_last_write_size;
       std::size_t                         statistics_last_hash;
 
+      /**
+       * If the statistics file is written in the 'append only' format, these
+       * variables store how many columns have been described and how many
+       * rows have been written to the statistics file so far. Like the
+       * variables above, they are not serialized, so that the complete
+       * statistics file is rewritten the first time after a restart.
+       */
+      unsigned int                        statistics_columns_written;
+      unsigned int                        statistics_rows_written;
+
       mutable TimerOutput                 computing_timer;
 
+      /**
+       * The accumulated wall time and number of calls of each section of the
+       * computing timer at the time write_detailed_timing_output() was last
+       * called. Used to determine the time spent in each section during one
+       * time step.
+       */
+      mutable std::map<std::string, std::pair<double,double> > last_detailed_timing_data;
+
+      /**
+       * The accumulated wall time and number of calls of the parts of
+       * threaded cell loops recorded by add_detailed_worker_timing(). Every
+       * thread accumulates its own times, so that the workers do not have
+       * to synchronize, and write_detailed_timing_output() adds up the
+       * times of all threads.
+       */
+      mutable Threads::ThreadLocalStorage<std::map<std::string, std::pair<double,double> > > detailed_worker_timing_data;
+
       /**
        * In output_statistics(), where we output the statistics object above,
        * we do the actual writing on a separate thread. This variable is the
@@ -1883,6 +2053,25 @@ namespace aspect
        * or if we want to terminate altogether.
        */
       Threads::Thread<>                   output_statistics_thread;
+
+      /**
+       * In create_snapshot(), the serialized state of the simulator can be
+       * compressed and written to disk on a separate thread. The mesh and
+       * the solution vectors are always written on the main thread. This
+       * variable is the handle for this thread, so that we can wait for it to finish
+       * before writing the next snapshot or terminating.
+       */
+      Threads::Thread<>                   checkpoint_writer_thread;
+
+      /**
+       * A pool of FEValues objects and material model inputs and outputs
+       * that postprocessors and other plugins can borrow through
+       * SimulatorAccess::borrow_cell_evaluation_scratch(), rather than
+       * creating their own every time they are executed. It is declared
+       * before all plugin managers, so that it outlives all objects that
+       * might still hold a borrowed object when the simulator is destroyed.
+       */
+      mutable internal::ScratchObjectPool<dim>  scratch_object_pool;
       /**
        * @}
        */
@@ -1927,6 +2116,15 @@ namespace aspect
       unsigned int                                              timestep_number;
       unsigned int                                              pre_refinement_step;
       unsigned int                                              nonlinear_iteration;
+
+      /**
+       * The number of the time step in which the mesh was last refined,
+       * and an estimate of how many cells the fastest features of the flow
+       * have moved since then. These are used to decide when to refine the
+       * mesh if the refinement interval is adapted to the flow.
+       */
+      unsigned int                                              last_refinement_timestep_number;
+      double                                                    cells_advected_since_last_refinement;
       /**
        * @}
        */
@@ -2058,6 +2256,38 @@ namespace aspect
       // only used if operator split is enabled
       LinearAlgebra::BlockVector                                operator_split_reaction_vector;
 
+      /**
+       * The artificial viscosity per cell for those advection fields (indexed
+       * by AdvectionField::field_index()) for which it has already been
+       * computed in the current time step. See
+       * get_cached_artificial_viscosity(). The cache is cleared at the
+       * beginning of every time step in solve_timestep(), and in
+       * setup_dofs() whenever the mesh changes.
+       */
+      std::map<unsigned int, Vector<double> >                   artificial_viscosity_cache;
+
+      /**
+       * If the parameter 'Reuse material model evaluation for compositional
+       * fields' is set, these vectors store the material and heating model
+       * outputs of every locally owned cell (indexed by the active cell
+       * index) that were computed while assembling the first compositional
+       * field in assemble_and_solve_composition(), so that the assembly of
+       * all other compositional fields can reuse them. The outputs are
+       * swapped with the ones in the scratch object of the assembly, so the
+       * objects stored here are allocated only once per cell and are kept
+       * (with outdated values) between calls of
+       * assemble_and_solve_composition(). Whether the values of a cell are
+       * valid is recorded in advection_material_model_outputs_cache_valid,
+       * which is empty outside of assemble_and_solve_composition(). The
+       * counters record how many cell assemblies evaluated the material
+       * model and how many reused a stored evaluation.
+       */
+      std::vector<std::unique_ptr<MaterialModel::MaterialModelOutputs<dim> > > advection_material_model_outputs_cache;
+      std::vector<std::unique_ptr<HeatingModel::HeatingModelOutputs> >        advection_heating_model_outputs_cache;
+      std::vector<unsigned char>                                advection_material_model_outputs_cache_valid;
+      std::atomic<unsigned int>                                 n_advection_material_model_evaluations;
+      std::atomic<unsigned int>                                 n_reused_advection_material_model_evaluations;
+
 
 
       std::unique_ptr<LinearAlgebra::PreconditionAMG>           Amg_preconditioner;
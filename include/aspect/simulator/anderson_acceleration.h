@@ -0,0 +1,116 @@
+/*
+  Copyright (C) 2020 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_simulator_anderson_acceleration_h
+#define _aspect_simulator_anderson_acceleration_h
+
+#include <aspect/global.h>
+
+#include <deque>
+
+namespace aspect
+{
+  namespace internal
+  {
+    /**
+     * A class that implements Anderson acceleration for a fixed point
+     * iteration $x_{k+1} = G(x_k)$. Instead of using $G(x_k)$ as the next
+     * iterate, the accelerated iteration uses
+     * @f[
+     *   x_{k+1} = G(x_k) - \sum_{i} \gamma_i \Delta G_i,
+     * @f]
+     * where $\Delta G_i$ are the differences between the last few values of
+     * $G$, and the coefficients $\gamma_i$ minimize the norm of the
+     * corresponding linear combination of the fixed point residuals
+     * $f_k = G(x_k) - x_k$.
+     *
+     * As a safeguard, the history is discarded and a plain fixed point step
+     * is taken whenever the norm of the residual grows from one iteration to
+     * the next, or when the least squares problem is too badly conditioned.
+     */
+    class AndersonAcceleration
+    {
+      public:
+        /**
+         * Constructor. @p max_history_size is the maximal number of
+         * differences of previous iterates that are used. If it is zero,
+         * apply() never modifies its argument, and the iteration is the
+         * plain fixed point iteration.
+         */
+        explicit AndersonAcceleration (const unsigned int max_history_size);
+
+        /**
+         * Given the iterate @p x that was the input of the fixed point map,
+         * and the result @p g of the fixed point map, replace @p g by the
+         * accelerated next iterate. Both vectors need to have the same
+         * layout in every call. Return whether @p g was modified, i.e.,
+         * whether an accelerated step was taken.
+         */
+        bool
+        apply (const LinearAlgebra::BlockVector &x,
+               LinearAlgebra::BlockVector &g);
+
+        /**
+         * Return the number of steps in which the iterate was modified by
+         * the acceleration.
+         */
+        unsigned int
+        n_accelerated_steps () const;
+
+        /**
+         * Return the number of times the history was discarded because
+         * the safeguard was triggered.
+         */
+        unsigned int
+        n_restarts () const;
+
+      private:
+        /**
+         * Discard the stored history.
+         */
+        void
+        restart ();
+
+        const unsigned int max_history_size;
+
+        /**
+         * The differences between consecutive values of the fixed point map
+         * and of the residuals, oldest first.
+         */
+        std::deque<LinearAlgebra::BlockVector> delta_g;
+        std::deque<LinearAlgebra::BlockVector> delta_f;
+
+        /**
+         * The value of the fixed point map and the residual in the previous
+         * call to apply(), and the norm of the latter.
+         */
+        LinearAlgebra::BlockVector last_g;
+        LinearAlgebra::BlockVector last_f;
+        double last_residual_norm;
+        bool has_last_iterate;
+
+        unsigned int accelerated_steps;
+        unsigned int restarts;
+    };
+  }
+}
+
+#endif
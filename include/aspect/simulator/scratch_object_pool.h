@@ -0,0 +1,135 @@
+/*
+  Copyright (C) 2020 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _aspect_simulator_scratch_object_pool_h
+#define _aspect_simulator_scratch_object_pool_h
+
+#include <aspect/global.h>
+#include <aspect/material_model/interface.h>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * A collection of the objects that are needed to evaluate the material
+   * model on one cell: an FEValues object for a given quadrature formula
+   * and set of update flags, and material model inputs and outputs sized
+   * for the quadrature points of this formula.
+   *
+   * Objects of this type are handed out by
+   * SimulatorAccess::borrow_cell_evaluation_scratch(), and are returned to
+   * a pool owned by the simulator for later reuse once they are no longer
+   * needed.
+   */
+  template <int dim>
+  struct CellEvaluationScratch
+  {
+    /**
+     * Constructor.
+     */
+    CellEvaluationScratch (const Mapping<dim> &mapping,
+                           const FiniteElement<dim> &fe,
+                           const Quadrature<dim> &quadrature,
+                           const UpdateFlags update_flags,
+                           const unsigned int n_compositional_fields);
+
+    FEValues<dim> fe_values;
+    MaterialModel::MaterialModelInputs<dim> material_model_inputs;
+    MaterialModel::MaterialModelOutputs<dim> material_model_outputs;
+  };
+
+
+
+  namespace internal
+  {
+    /**
+     * A pool of CellEvaluationScratch objects. Postprocessors and other
+     * plugins typically create an FEValues object and material model inputs
+     * and outputs every time they are executed, which leads to many memory
+     * allocations on every output step. Instead, they can borrow objects
+     * from this pool. Objects are identified by the quadrature formula, the
+     * update flags, and the number of compositional fields they were
+     * created for, and are only created if no matching object is available.
+     *
+     * Borrowed objects are returned to the pool when the last copy of the
+     * pointer returned by borrow() is destroyed. Additional material model
+     * inputs and outputs that were attached by the previous user are removed
+     * before an object is handed out again. The pool is safe to use from
+     * several threads at the same time.
+     */
+    template <int dim>
+    class ScratchObjectPool
+    {
+      public:
+        /**
+         * Return an object for the given quadrature formula, update flags,
+         * and number of compositional fields. If the pool does not contain
+         * a matching object that is currently not in use, create a new one.
+         */
+        std::shared_ptr<CellEvaluationScratch<dim> >
+        borrow (const Mapping<dim> &mapping,
+                const FiniteElement<dim> &fe,
+                const Quadrature<dim> &quadrature,
+                const UpdateFlags update_flags,
+                const unsigned int n_compositional_fields);
+
+        /**
+         * Delete all objects that are currently not in use.
+         */
+        void
+        clear ();
+
+      private:
+        /**
+         * An object that is currently not in use, together with the
+         * arguments it was created for.
+         */
+        struct Entry
+        {
+          Quadrature<dim> quadrature;
+          UpdateFlags update_flags;
+          unsigned int n_compositional_fields;
+          std::unique_ptr<CellEvaluationScratch<dim> > scratch;
+        };
+
+        /**
+         * The objects that are available for borrowing.
+         */
+        std::vector<Entry> available_objects;
+
+        /**
+         * A mutex that guards access to the list of available objects.
+         */
+        std::mutex mutex;
+    };
+  }
+}
+
+#endif
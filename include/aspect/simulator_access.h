@@ -28,10 +28,12 @@
 
 #include <deal.II/base/table_handler.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/base/quadrature.h>
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/distributed/tria.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
 #include <deal.II/fe/mapping_q.h>
 
 #if !DEAL_II_VERSION_GTE(9,1,0)
@@ -53,6 +55,7 @@ namespace aspect
   template <int dim> class Simulator;
   template <int dim> struct SimulatorSignals;
   template <int dim> class LateralAveraging;
+  template <int dim> struct CellEvaluationScratch;
   template <int dim> struct RotationProperties;
 
   namespace GravityModel
@@ -861,6 +864,26 @@ namespace aspect
        */
       TableHandler &get_statistics_object() const;
 
+      /**
+       * Borrow an FEValues object for the given quadrature formula and
+       * update flags, together with material model inputs and outputs sized
+       * for its quadrature points, from a pool owned by the simulator. The
+       * object is returned to the pool when the returned pointer (and all
+       * of its copies) are destroyed, and can then be handed out again
+       * without allocating any memory. This is useful for postprocessors
+       * that would otherwise create these objects every time they are
+       * executed.
+       *
+       * The FEValues object uses the mapping and finite element of the
+       * simulator. The material model inputs and outputs do not have any
+       * additional inputs or outputs attached, and request all properties.
+       * Borrowed objects should not be kept beyond the function that
+       * borrowed them, in particular not as member variables of a plugin.
+       */
+      std::shared_ptr<CellEvaluationScratch<dim> >
+      borrow_cell_evaluation_scratch (const Quadrature<dim> &quadrature,
+                                      const UpdateFlags update_flags) const;
+
 
       /**
        * This function can be used to find out whether the list of
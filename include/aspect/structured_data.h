@@ -495,12 +495,30 @@ namespace aspect
         get_data_component (const Point<dim>                    &position,
                             const unsigned int                   component) const;
 
+        /**
+         * Returns the data components with indices 0 to values.size()-1 at
+         * the given position in @p values. This is cheaper than calling
+         * get_data_component() for each component separately, since the
+         * position is only converted into the coordinate system of the data
+         * file once.
+         */
+        void
+        get_data_components (const Point<dim>                    &position,
+                             std::vector<double>                 &values) const;
+
       protected:
         /**
          * Pointer to an object that reads and processes data we get from text
          * files.
          */
         std::unique_ptr<aspect::Utilities::StructuredDataLookup<dim> > lookup;
+
+      private:
+        /**
+         * Convert @p position into the coordinate system of the data file.
+         */
+        Point<dim>
+        data_position (const Point<dim> &position) const;
     };
 
 
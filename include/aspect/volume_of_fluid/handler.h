@@ -145,7 +145,10 @@ namespace aspect
 
       /**
        * Solve the diagonal matrix assembled in assemble_volume_of_fluid_system for the
-       * specified field.
+       * specified field. If the explicit update was selected, only the
+       * diagonal of the matrix was assembled, and the new volume fractions
+       * are computed by dividing the right hand side by it instead of using
+       * an iterative solver.
        */
       void solve_volume_of_fluid_system (const VolumeOfFluidField<dim> &field);
 
@@ -194,6 +197,25 @@ namespace aspect
        */
       double volume_of_fluid_solver_tolerance;
 
+      /**
+       * Whether to update the volume fractions explicitly, i.e., to only
+       * assemble the diagonal of the matrix of each directional update and
+       * divide by it, rather than assembling the matrix and solving the
+       * linear system with an iterative solver. Because the volume fractions
+       * are piecewise constant, the matrix is diagonal and both approaches
+       * compute the same update.
+       */
+      bool explicit_volume_fraction_update;
+
+      /**
+       * The diagonal of the matrix of the current directional update if the
+       * volume fractions are updated explicitly. This vector only stores the
+       * block of the field that is currently updated and is reused for all
+       * fields and directional updates. After the update has been computed,
+       * it holds the new volume fractions.
+       */
+      LinearAlgebra::Vector explicit_update_diagonal;
+
       /**
        * Number of samples in each dimension to use during the Volume of Fluid
        * initialization, for a total of $n_init_samples^dim$ points sampled
@@ -26,6 +26,11 @@
 
 #include <deal.II/base/signaling_nan.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
 
 namespace aspect
 {
@@ -66,13 +71,6 @@ namespace aspect
 
       delta_z = this->get_geometry_model().maximal_depth() / (n_points-1);
 
-      MaterialModel::MaterialModelInputs<dim> in(1, this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<dim> out(1, this->n_compositional_fields());
-
-      // Constant properties on the reference profile
-      in.strain_rate.resize(0); // we do not need the viscosity
-      in.velocity[0] = Tensor <1,dim> ();
-
       // Check whether gravity is pointing up / out or down / in. In the normal case it should
       // point down / in and therefore gravity should be positive, leading to increasing
       // adiabatic pressures and temperatures with depth. In some cases it will point up / out
@@ -85,79 +83,86 @@ namespace aspect
                                      1 :
                                      -1;
 
-      // now integrate downward using the explicit Euler method for simplicity
-      //
-      // note: p'(z) = rho(p,T) * |g|
-      //       T'(z) = alpha |g| T / C_p
-      for (unsigned int i=0; i<n_points; ++i)
+      double surface_pressure, surface_temperature;
+      if (!use_surface_condition_function)
+        {
+          surface_pressure = this->get_surface_pressure();
+          surface_temperature = this->get_adiabatic_surface_temperature();
+        }
+      else
         {
-          if (i==0)
+          surface_pressure = surface_condition_function.value(Point<1>(0.0),0);
+          surface_temperature = surface_condition_function.value(Point<1>(0.0),1);
+        }
+
+      if (integration_scheme == adaptive_runge_kutta)
+        integrate_adaptive_runge_kutta (surface_pressure,
+                                        surface_temperature,
+                                        gravity_direction);
+      else
+        {
+          MaterialModel::MaterialModelInputs<dim> in(1, this->n_compositional_fields());
+          MaterialModel::MaterialModelOutputs<dim> out(1, this->n_compositional_fields());
+
+          // Constant properties on the reference profile
+          in.strain_rate.resize(0); // we do not need the viscosity
+          in.velocity[0] = Tensor <1,dim> ();
+
+          // now integrate downward using the explicit Euler method for simplicity
+          //
+          // note: p'(z) = rho(p,T) * |g|
+          //       T'(z) = alpha |g| T / C_p
+          for (unsigned int i=0; i<n_points; ++i)
             {
-              if (!use_surface_condition_function)
+              if (i==0)
                 {
-                  pressures[0] = this->get_surface_pressure();
-                  temperatures[0] = this->get_adiabatic_surface_temperature();
+                  pressures[0] = surface_pressure;
+                  temperatures[0] = surface_temperature;
                 }
               else
                 {
-                  pressures[0] = surface_condition_function.value(Point<1>(0.0),0);
-                  temperatures[0] = surface_condition_function.value(Point<1>(0.0),1);
+                  // use material properties calculated at i-1
+                  const double density = out.densities[0];
+                  const double alpha = out.thermal_expansion_coefficients[0];
+                  // Handle the case that cp is zero (happens in simple Stokes test problems like sol_cx). By setting
+                  // 1/cp = 0.0 we will have a constant temperature profile with depth.
+                  const double one_over_cp = (out.specific_heat[0]>0.0) ? 1.0/out.specific_heat[0] : 0.0;
+                  // get the magnitude of gravity. we assume
+                  // that gravity always points along the depth direction. this
+                  // may not strictly be true always but is likely a good enough
+                  // approximation here.
+                  const double gravity = gravity_direction * this->get_gravity_model().gravity_vector(in.position[0]).norm();
+
+                  pressures[i] = pressures[i-1] + density * gravity * delta_z;
+                  temperatures[i] = (this->include_adiabatic_heating())
+                                    ?
+                                    temperatures[i-1] * (1 + alpha * gravity * delta_z * one_over_cp)
+                                    :
+                                    temperatures[0];
                 }
-            }
-          else
-            {
-              // use material properties calculated at i-1
-              const double density = out.densities[0];
-              const double alpha = out.thermal_expansion_coefficients[0];
-              // Handle the case that cp is zero (happens in simple Stokes test problems like sol_cx). By setting
-              // 1/cp = 0.0 we will have a constant temperature profile with depth.
-              const double one_over_cp = (out.specific_heat[0]>0.0) ? 1.0/out.specific_heat[0] : 0.0;
-              // get the magnitude of gravity. we assume
-              // that gravity always points along the depth direction. this
-              // may not strictly be true always but is likely a good enough
-              // approximation here.
-              const double gravity = gravity_direction * this->get_gravity_model().gravity_vector(in.position[0]).norm();
-
-              pressures[i] = pressures[i-1] + density * gravity * delta_z;
-              temperatures[i] = (this->include_adiabatic_heating())
-                                ?
-                                temperatures[i-1] * (1 + alpha * gravity * delta_z * one_over_cp)
-                                :
-                                temperatures[0];
-            }
 
-          const double z = double(i)/double(n_points-1)*this->get_geometry_model().maximal_depth();
-          const Point<dim> representative_point = this->get_geometry_model().representative_point (z);
-          const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(representative_point);
+              const double z = double(i)/double(n_points-1)*this->get_geometry_model().maximal_depth();
+              const Point<dim> representative_point = this->get_geometry_model().representative_point (z);
+              const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(representative_point);
 
-          in.position[0] = representative_point;
-          in.temperature[0] = temperatures[i];
-          in.pressure[0] = pressures[i];
+              in.position[0] = representative_point;
+              in.temperature[0] = temperatures[i];
+              in.pressure[0] = pressures[i];
 
-          // we approximate the pressure gradient by extrapolating the values
-          // from the two points above
-          if (i>0)
-            in.pressure_gradient[0] = g/(g.norm() != 0.0 ? g.norm() : 1.0)
-                                      * (pressures[i] - pressures[i-1]) / delta_z;
-          else
-            in.pressure_gradient[0] = Tensor <1,dim> ();
+              // we approximate the pressure gradient by extrapolating the values
+              // from the two points above
+              if (i>0)
+                in.pressure_gradient[0] = g/(g.norm() != 0.0 ? g.norm() : 1.0)
+                                          * (pressures[i] - pressures[i-1]) / delta_z;
+              else
+                in.pressure_gradient[0] = Tensor <1,dim> ();
 
-          if (reference_composition == initial_composition)
-            for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
-              in.composition[0][c] = this->get_initial_composition_manager().initial_composition(representative_point, c);
-          else if (reference_composition == reference_function)
-            {
-              const double depth = this->get_geometry_model().depth(representative_point);
-              const Point<1> p(depth);
-              for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
-                in.composition[0][c] = composition_function->value(p, c);
-            }
-          else
-            AssertThrow(false,ExcNotImplemented());
+              compute_reference_composition (representative_point, in.composition[0]);
 
-          this->get_material_model().evaluate(in, out);
+              this->get_material_model().evaluate(in, out);
 
-          densities[i] = out.densities[0];
+              densities[i] = out.densities[0];
+            }
         }
 
       if (gravity_direction == 1 && this->get_surface_pressure() >= 0)
@@ -185,6 +190,258 @@ namespace aspect
 
 
 
+    template <int dim>
+    void
+    ComputeProfile<dim>::integrate_adaptive_runge_kutta (const double surface_pressure,
+                                                         const double surface_temperature,
+                                                         const int gravity_direction)
+    {
+      const double maximal_depth = this->get_geometry_model().maximal_depth();
+
+      // Limits for the step size. The upper limit makes sure we can not step
+      // over thin features of the material model (like phase transitions)
+      // without ever evaluating the material model within them. The lower
+      // limit prevents an endless refinement of the step size in case the
+      // material properties are discontinuous.
+      const double maximal_step_size = maximal_depth / 50.;
+      const double minimal_step_size = 1e-8 * maximal_depth;
+
+      // Coefficients of the Dormand-Prince 5(4) method. The last stage is
+      // evaluated at the new solution, so its derivatives can be reused as
+      // the first stage of the next step.
+      const double c[7] = {0., 1./5., 3./10., 4./5., 8./9., 1., 1.};
+      const double a[7][6] =
+      {
+        {0., 0., 0., 0., 0., 0.},
+        {1./5., 0., 0., 0., 0., 0.},
+        {3./40., 9./40., 0., 0., 0., 0.},
+        {44./45., -56./15., 32./9., 0., 0., 0.},
+        {19372./6561., -25360./2187., 64448./6561., -212./729., 0., 0.},
+        {9017./3168., -355./33., 46732./5247., 49./176., -5103./18656., 0.},
+        {35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.}
+      };
+      // Difference between the fifth and the fourth order solution
+      const double e[7] = {71./57600., 0., -71./16695., 71./1920., -17253./339200., 22./525., -1./40.};
+
+      MaterialModel::MaterialModelInputs<dim> in(1, this->n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> out(1, this->n_compositional_fields());
+
+      // Constant properties on the reference profile
+      in.strain_rate.resize(0); // we do not need the viscosity
+      in.velocity[0] = Tensor <1,dim> ();
+
+      // The solution vector consists of pressure and temperature
+      std::array<double,2> y = {{surface_pressure, surface_temperature}};
+      std::array<std::array<double,2>,7> k;
+      k[0] = compute_profile_derivatives (0.0, y, 0.0, gravity_direction, in, out);
+
+      // Scale the error of each component by the magnitude this component
+      // can reach in the profile, so that the tolerance is a relative one
+      // also for pressures that start from zero at the surface.
+      const std::array<double,2> scale = {{std::max(std::max(std::abs(y[0]), std::abs(k[0][0]) * maximal_depth), 1.0),
+                                           std::max(std::max(std::abs(y[1]), std::abs(k[0][1]) * maximal_depth), 1.0)
+                                          }
+                                         };
+
+      std::vector<double> pressure_derivatives (n_points, numbers::signaling_nan<double>());
+      pressures[0] = y[0];
+      temperatures[0] = y[1];
+      pressure_derivatives[0] = k[0][0];
+      unsigned int next_point = 1;
+
+      std::vector<std::pair<double,double> > step_sizes;
+
+      double z = 0;
+      double h = std::min(delta_z, maximal_step_size);
+      while (z < maximal_depth)
+        {
+          // If we have computed the profile before, do not take larger steps
+          // than the error estimate allowed then at the current depth. This
+          // avoids rejected steps in the vicinity of phase transitions, whose
+          // location usually does not change much between two computations of
+          // the profile. Because we store the step sizes the error estimate
+          // proposed rather than the ones we took, the steps can grow again
+          // where the solution is smooth.
+          if (previous_step_sizes.size() > 0)
+            {
+              auto previous_step = std::upper_bound (previous_step_sizes.begin(),
+                                                     previous_step_sizes.end(),
+                                                     z,
+                                                     [](const double depth, const std::pair<double,double> &step)
+              {
+                return depth < step.first;
+              });
+              if (previous_step != previous_step_sizes.begin())
+                h = std::min(h, std::prev(previous_step)->second);
+            }
+
+          const bool last_step = (z + h >= maximal_depth);
+          if (last_step)
+            h = maximal_depth - z;
+
+          // Compute the remaining stages. The pressure gradient used as input
+          // for the material model is taken from the previous stage.
+          std::array<double,2> y_new = y;
+          for (unsigned int s=1; s<7; ++s)
+            {
+              y_new = y;
+              for (unsigned int j=0; j<s; ++j)
+                for (unsigned int d=0; d<2; ++d)
+                  y_new[d] += h * a[s][j] * k[j][d];
+
+              k[s] = compute_profile_derivatives (z + c[s]*h, y_new, k[s-1][0], gravity_direction, in, out);
+            }
+
+          double error = 0;
+          for (unsigned int d=0; d<2; ++d)
+            {
+              double component_error = 0;
+              for (unsigned int s=0; s<7; ++s)
+                component_error += h * e[s] * k[s][d];
+
+              error = std::max(error,
+                               std::abs(component_error)
+                               / (integration_tolerance * std::max(scale[d], std::max(std::abs(y[d]), std::abs(y_new[d])))));
+            }
+
+          // Choose the next step size (or the step size for repeating the
+          // current step) based on the error estimate
+          const double factor = (error > 0 ?
+                                 std::min(5.0, std::max(0.2, 0.9 * std::pow(error, -0.2))) :
+                                 5.0);
+          const double next_h = std::min(std::max(h * factor, minimal_step_size), maximal_step_size);
+
+          if (error <= 1.0 || h <= minimal_step_size)
+            {
+              const double z_new = (last_step ? maximal_depth : z + h);
+
+              // Fill all points of the table that lie within the current step
+              // by cubic Hermite interpolation of the values and derivatives
+              // at the two ends of the step
+              while (next_point < n_points)
+                {
+                  const double z_point = double(next_point)/double(n_points-1)*maximal_depth;
+                  if (z_point > z_new && !(last_step))
+                    break;
+
+                  const double theta = std::min((z_point - z) / h, 1.0);
+                  const double h00 = (1. + 2.*theta) * (1.-theta) * (1.-theta);
+                  const double h10 = theta * (1.-theta) * (1.-theta);
+                  const double h01 = theta * theta * (3. - 2.*theta);
+                  const double h11 = theta * theta * (theta - 1.);
+
+                  pressures[next_point] = h00*y[0] + h10*h*k[0][0] + h01*y_new[0] + h11*h*k[6][0];
+                  temperatures[next_point] = h00*y[1] + h10*h*k[0][1] + h01*y_new[1] + h11*h*k[6][1];
+                  pressure_derivatives[next_point] = 6.*theta*(theta-1.)/h * (y[0] - y_new[0])
+                                                     + (theta-1.)*(3.*theta-1.) * k[0][0]
+                                                     + theta*(3.*theta-2.) * k[6][0];
+                  ++next_point;
+                }
+
+              step_sizes.emplace_back (z, next_h);
+
+              z = z_new;
+              y = y_new;
+              k[0] = k[6];
+            }
+
+          h = next_h;
+        }
+
+      Assert (next_point == n_points, ExcInternalError());
+      previous_step_sizes.swap(step_sizes);
+
+      // Finally compute the densities at all points of the table in a
+      // single evaluation of the material model
+      MaterialModel::MaterialModelInputs<dim> table_in(n_points, this->n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> table_out(n_points, this->n_compositional_fields());
+      table_in.strain_rate.resize(0);
+
+      for (unsigned int i=0; i<n_points; ++i)
+        {
+          const double z = double(i)/double(n_points-1)*maximal_depth;
+          const Point<dim> representative_point = this->get_geometry_model().representative_point (z);
+          const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(representative_point);
+
+          table_in.position[i] = representative_point;
+          table_in.temperature[i] = temperatures[i];
+          table_in.pressure[i] = pressures[i];
+          table_in.velocity[i] = Tensor <1,dim> ();
+          table_in.pressure_gradient[i] = g/(g.norm() != 0.0 ? g.norm() : 1.0)
+                                          * pressure_derivatives[i];
+          compute_reference_composition (representative_point, table_in.composition[i]);
+        }
+
+      this->get_material_model().evaluate(table_in, table_out);
+      densities = table_out.densities;
+    }
+
+
+
+    template <int dim>
+    std::array<double,2>
+    ComputeProfile<dim>::compute_profile_derivatives (const double depth,
+                                                      const std::array<double,2> &pressure_and_temperature,
+                                                      const double pressure_derivative,
+                                                      const int gravity_direction,
+                                                      MaterialModel::MaterialModelInputs<dim> &in,
+                                                      MaterialModel::MaterialModelOutputs<dim> &out) const
+    {
+      const Point<dim> representative_point = this->get_geometry_model().representative_point (depth);
+      const Tensor <1,dim> g = this->get_gravity_model().gravity_vector(representative_point);
+
+      in.position[0] = representative_point;
+      in.pressure[0] = pressure_and_temperature[0];
+      in.temperature[0] = pressure_and_temperature[1];
+      in.pressure_gradient[0] = g/(g.norm() != 0.0 ? g.norm() : 1.0) * pressure_derivative;
+      compute_reference_composition (representative_point, in.composition[0]);
+
+      this->get_material_model().evaluate(in, out);
+
+      // Handle the case that cp is zero (happens in simple Stokes test problems like sol_cx). By setting
+      // 1/cp = 0.0 we will have a constant temperature profile with depth.
+      const double one_over_cp = (out.specific_heat[0]>0.0) ? 1.0/out.specific_heat[0] : 0.0;
+      // get the magnitude of gravity. we assume
+      // that gravity always points along the depth direction. this
+      // may not strictly be true always but is likely a good enough
+      // approximation here.
+      const double gravity = gravity_direction * g.norm();
+
+      // note: p'(z) = rho(p,T) * |g|
+      //       T'(z) = alpha |g| T / C_p
+      std::array<double,2> derivatives;
+      derivatives[0] = out.densities[0] * gravity;
+      derivatives[1] = (this->include_adiabatic_heating())
+                       ?
+                       out.thermal_expansion_coefficients[0] * gravity * pressure_and_temperature[1] * one_over_cp
+                       :
+                       0.0;
+      return derivatives;
+    }
+
+
+
+    template <int dim>
+    void
+    ComputeProfile<dim>::compute_reference_composition (const Point<dim> &position,
+                                                        std::vector<double> &composition) const
+    {
+      if (reference_composition == initial_composition)
+        for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
+          composition[c] = this->get_initial_composition_manager().initial_composition(position, c);
+      else if (reference_composition == reference_function)
+        {
+          const double depth = this->get_geometry_model().depth(position);
+          const Point<1> p(depth);
+          for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
+            composition[c] = composition_function->value(p, c);
+        }
+      else
+        AssertThrow(false,ExcNotImplemented());
+    }
+
+
+
     template <int dim>
     bool
     ComputeProfile<dim>::is_initialized() const
@@ -306,6 +563,29 @@ namespace aspect
                              "profile. The higher the number of points, the more accurate "
                              "the downward integration from the adiabatic surface "
                              "temperature will be.");
+          prm.declare_entry ("Integration scheme", "explicit Euler",
+                             Patterns::Selection("explicit Euler|adaptive Runge-Kutta"),
+                             "The method used to integrate the pressure and temperature "
+                             "profile downward from the surface. `explicit Euler' takes one "
+                             "step from each point of the profile to the next one and "
+                             "evaluates the material model once per step. `adaptive "
+                             "Runge-Kutta' uses the embedded Dormand-Prince 5(4) method "
+                             "with a step size that is chosen independently of the `Number "
+                             "of points' based on the `Integration tolerance'. It takes "
+                             "large steps where the material properties change slowly "
+                             "and refines the steps close to phase transitions. The step "
+                             "sizes of the previous computation of the profile are reused "
+                             "when the profile is recomputed, e.g. because of a time "
+                             "dependent `Surface condition function'. The values at the "
+                             "points of the profile are interpolated from the steps, and "
+                             "the densities at all points are computed in a single "
+                             "evaluation of the material model.");
+          prm.declare_entry ("Integration tolerance", "1e-6",
+                             Patterns::Double (std::numeric_limits<double>::min()),
+                             "The relative tolerance for the error of the pressure and "
+                             "temperature in each step of the `adaptive Runge-Kutta' "
+                             "integration scheme. Needs to be positive. Unused for other "
+                             "integration schemes.");
           prm.declare_entry ("Use surface condition function", "false",
                              Patterns::Bool(),
                              "Whether to use the 'Surface condition function' to determine surface "
@@ -366,6 +646,15 @@ namespace aspect
             }
 
           n_points = prm.get_integer ("Number of points");
+
+          if (prm.get ("Integration scheme") == "explicit Euler")
+            integration_scheme = explicit_euler;
+          else if (prm.get ("Integration scheme") == "adaptive Runge-Kutta")
+            integration_scheme = adaptive_runge_kutta;
+          else
+            AssertThrow(false, ExcNotImplemented());
+
+          integration_tolerance = prm.get_double ("Integration tolerance");
           use_surface_condition_function = prm.get_bool("Use surface condition function");
           if (use_surface_condition_function)
             {
@@ -25,8 +25,11 @@
 
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/table.h>
+#include <exception>
 #include <fstream>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
 
 #include <boost/property_tree/xml_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -143,14 +146,192 @@ namespace aspect
 
 
 
+      namespace
+      {
+        /**
+         * An identifier at the beginning of each cache file, which needs to be
+         * changed whenever the format of the cache files changes.
+         */
+        const std::string cache_file_identifier = "ASPECT GPlates velocity cache 2";
+
+        /**
+         * Compute the 64 bit FNV-1a checksum of @p content. Unlike
+         * std::hash, the result is specified exactly and therefore the same
+         * for every compiler, standard library, and run of the program,
+         * which is necessary to recognize a gpml file in a later run.
+         */
+        std::uint64_t
+        compute_checksum(const std::string &content)
+        {
+          std::uint64_t checksum = 14695981039346656037ULL;
+          for (const char c : content)
+            {
+              checksum ^= static_cast<unsigned char>(c);
+              checksum *= 1099511628211ULL;
+            }
+          return checksum;
+        }
+
+        /**
+         * Read the velocity grid from the cache file @p cache_filename. Return
+         * false if the file does not exist, if it was created for a gpml file
+         * with a different size or checksum, or if its grid shape or length
+         * are not consistent.
+         */
+        bool
+        read_cache_file(const std::string &cache_filename,
+                        const std::uint64_t content_checksum,
+                        const std::uint64_t content_size,
+                        std::array<unsigned int,2> &grid_size,
+                        std::vector<double> &velocity_data)
+        {
+          std::ifstream in(cache_filename, std::ios::binary);
+          if (!in)
+            return false;
+
+          std::string identifier(cache_file_identifier.size(), ' ');
+          std::uint64_t stored_checksum = 0;
+          std::uint64_t stored_size = 0;
+          in.read(&identifier[0], identifier.size());
+          in.read(reinterpret_cast<char *>(&stored_checksum), sizeof(stored_checksum));
+          in.read(reinterpret_cast<char *>(&stored_size), sizeof(stored_size));
+          in.read(reinterpret_cast<char *>(grid_size.data()), sizeof(grid_size));
+
+          if (!in
+              || identifier != cache_file_identifier
+              || stored_checksum != content_checksum
+              || stored_size != content_size)
+            return false;
+
+          // A valid grid has n_phi == 2 * (n_theta - 1) points in longitude
+          // direction, see read_velocity_data().
+          if (grid_size[0] < 2 || grid_size[1] != 2 * (grid_size[0] - 1))
+            return false;
+
+          velocity_data.resize(2 * grid_size[0] * (grid_size[1]+1));
+          in.read(reinterpret_cast<char *>(velocity_data.data()), velocity_data.size() * sizeof(double));
+
+          // the file has to end exactly after the velocity data
+          return static_cast<bool>(in) && (in.peek() == std::ifstream::traits_type::eof());
+        }
+
+
+
+        /**
+         * Write the velocity grid into the cache file @p cache_filename. Failing
+         * to do so is not an error, the next run will simply have to parse the
+         * gpml file again.
+         */
+        void
+        write_cache_file(const std::string &cache_filename,
+                         const std::uint64_t content_checksum,
+                         const std::uint64_t content_size,
+                         const std::array<unsigned int,2> &grid_size,
+                         const std::vector<double> &velocity_data)
+        {
+          std::ofstream out(cache_filename, std::ios::binary);
+          if (!out)
+            return;
+
+          out.write(cache_file_identifier.data(), cache_file_identifier.size());
+          out.write(reinterpret_cast<const char *>(&content_checksum), sizeof(content_checksum));
+          out.write(reinterpret_cast<const char *>(&content_size), sizeof(content_size));
+          out.write(reinterpret_cast<const char *>(grid_size.data()), sizeof(grid_size));
+          out.write(reinterpret_cast<const char *>(velocity_data.data()), velocity_data.size() * sizeof(double));
+        }
+      }
+
+
+
       template <int dim>
       void
       GPlatesLookup<dim>::load_file(const std::string &filename,
-                                    const MPI_Comm &comm)
+                                    const MPI_Comm &comm,
+                                    const std::string &cache_filename)
+      {
+        // Only the root process reads the file. The velocity grid that
+        // results is much smaller than the content of the gpml file, so
+        // distributing the grid is cheaper than letting every process
+        // parse the XML structure itself.
+        std::array<unsigned int,2> grid_size = {{0, 0}};
+        std::vector<double> velocity_data;
+
+        if (Utilities::MPI::this_mpi_process(comm) == 0)
+          {
+            std::exception_ptr exception;
+            try
+              {
+                read_velocity_data(filename, cache_filename, grid_size, velocity_data);
+              }
+            catch (...)
+              {
+                exception = std::current_exception();
+                grid_size[0] = grid_size[1] = 0;
+              }
+
+            // Broadcast the grid size (or the failure state), then rethrow
+            // if necessary.
+            const int ierr = MPI_Bcast(grid_size.data(), 2, MPI_UNSIGNED, 0, comm);
+            AssertThrowMPI(ierr);
+
+            if (exception)
+              std::rethrow_exception(exception);
+          }
+        else
+          {
+            const int ierr = MPI_Bcast(grid_size.data(), 2, MPI_UNSIGNED, 0, comm);
+            AssertThrowMPI(ierr);
+
+            AssertThrow(grid_size[0] > 0,
+                        ExcMessage(std::string("Reading the GPlates data file <") + filename +
+                                   "> failed on the root process."));
+
+            velocity_data.resize(2 * grid_size[0] * (grid_size[1]+1));
+          }
+
+        const int ierr = MPI_Bcast(velocity_data.data(), static_cast<int>(velocity_data.size()), MPI_DOUBLE, 0, comm);
+        AssertThrowMPI(ierr);
+
+        const unsigned int n_theta = grid_size[0];
+        const unsigned int n_phi = grid_size[1];
+
+        delta_theta =   numbers::PI / (n_theta-1);
+        delta_phi   = 2*numbers::PI / n_phi;
+
+        for (unsigned int i = 0; i < 2; i++)
+          {
+            velocity_values[i].reinit(n_theta, n_phi+1);
+            velocity_values[i].fill(velocity_data.begin() + i * n_theta * (n_phi+1));
+          }
+      }
+
+
+
+      template <int dim>
+      void
+      GPlatesLookup<dim>::read_velocity_data(const std::string &filename,
+                                             const std::string &cache_filename,
+                                             std::array<unsigned int,2> &grid_size,
+                                             std::vector<double> &velocity_data) const
       {
-        // Read data from disk and distribute among processes
-        std::istringstream filecontent(
-          Utilities::read_and_distribute_file_content(filename, comm));
+        std::ifstream filestream(filename);
+        AssertThrow (filestream,
+                     ExcMessage (std::string("Could not open file <") + filename + ">."));
+
+        std::stringstream datastream;
+        filestream >> datastream.rdbuf();
+        const std::string content = datastream.str();
+
+        // Parsing the XML structure is by far the most expensive part of
+        // reading a file. Skip it if we have already done so in a previous
+        // run for a file with the same content.
+        const std::uint64_t content_checksum = compute_checksum(content);
+        const std::uint64_t content_size = content.size();
+        if (cache_filename != ""
+            && read_cache_file(cache_filename, content_checksum, content_size, grid_size, velocity_data))
+          return;
+
+        std::istringstream filecontent(content);
 
         boost::property_tree::ptree pt;
 
@@ -170,16 +351,19 @@ namespace aspect
         AssertThrow(dn_theta - n_theta <= 1e-5,
                     ExcMessage("The velocity file has a grid structure that is not readable. Please refer to the manual for a proper grid structure."));
 
-        delta_theta =   numbers::PI / (n_theta-1);
-        delta_phi   = 2*numbers::PI / n_phi;
+        grid_size[0] = n_theta;
+        grid_size[1] = n_phi;
 
-        /**
-         * Two tables (one for the theta and one for the phi component)
-         * which contain the velocities at every point.
-         * velocity_values[0] is the table for the theta component, whereas
-         * velocity_values[1] is the table for the phi component.
-         */
-        Table<2,double> velocity_values[2] = {Table<2,double>(n_theta,n_phi+1), Table<2,double>(n_theta,n_phi+1)};
+        // The velocities at every point, first all theta components
+        // and then all phi components, each stored as a table of
+        // size n_theta x (n_phi+1).
+        velocity_data.assign(2 * n_theta * (n_phi+1), 0.0);
+        const auto velocity_index = [&](const unsigned int component,
+                                        const unsigned int idx_theta,
+                                        const unsigned int idx_phi)
+        {
+          return (component * n_theta + idx_theta) * (n_phi+1) + idx_phi;
+        };
 
         std::string velos = pt.get<std::string>("gpml:FeatureCollection.gml:featureMember.gpml:VelocityField.gml:rangeSet.gml:DataBlock.gml:tupleList");
         std::stringstream in(velos, std::ios::in);
@@ -203,53 +387,76 @@ namespace aspect
             const unsigned int idx_theta = i / n_phi;
             const unsigned int idx_phi = (i + longitude_correction) % n_phi;
 
-            velocity_values[0][idx_theta][idx_phi]= spherical_velocities[0] * cmyr_si;
-            velocity_values[1][idx_theta][idx_phi]= spherical_velocities[1] * cmyr_si;
+            AssertThrow(idx_theta < n_theta,
+                        ExcMessage (std::string("Number of read in points does not match number of points in file. File corrupted?")));
+
+            velocity_data[velocity_index(0,idx_theta,idx_phi)] = spherical_velocities[0] * cmyr_si;
+            velocity_data[velocity_index(1,idx_theta,idx_phi)] = spherical_velocities[1] * cmyr_si;
 
             i++;
           }
 
+        AssertThrow(i == n_points,
+                    ExcMessage (std::string("Number of read in points does not match number of points in file. File corrupted?")));
+
         // Pad the longitude data with values for phi == 2*pi (== 0),
         // this simplifies interpolation later.
-        for (unsigned int i=0; i<n_theta; ++i)
-          {
-            velocity_values[0][i][n_phi] = velocity_values[0][i][0];
-            velocity_values[1][i][n_phi] = velocity_values[1][i][0];
-          }
+        for (unsigned int c=0; c<2; ++c)
+          for (unsigned int j=0; j<n_theta; ++j)
+            velocity_data[velocity_index(c,j,n_phi)] = velocity_data[velocity_index(c,j,0)];
 
-        // number of intervals in the direction of theta and phi
-        std::array<unsigned int,2> table_intervals;
-        table_intervals[0] = n_theta - 1;
-        table_intervals[1] = n_phi;
+        if (cache_filename != "")
+          write_cache_file(cache_filename, content_checksum, content_size, grid_size, velocity_data);
+      }
 
-        // Min and Max coordinates in data file
-        std::array<std::pair<double,double>,2> grid_extent;
 
-        // min and max extent of the grid in the direction of theta and phi (whole spheres in GPlates)
-        // polar angle theta: from 0° to 180°(PI)
-        grid_extent[0].first = 0;
-        grid_extent[0].second = numbers::PI;
-        // azimuthal angle phi: from 0° to 360°(2*PI)
-        grid_extent[1].first = 0;
-        grid_extent[1].second = 2 * numbers::PI;
 
-        for (unsigned int i = 0; i < 2; i++)
+      template <int dim>
+      Tensor<1,dim>
+      GPlatesLookup<dim>::surface_velocity(const Point<dim> &position) const
+      {
+        return surface_velocity(interpolation_weights(position));
+      }
+
+
+
+      template <int dim>
+      Tensor<1,dim>
+      GPlatesLookup<dim>::surface_velocity(const InterpolationWeights &weights) const
+      {
+        Tensor<1,dim> output_boundary_velocity;
+        for (unsigned int i=0; i<weights.n_entries; ++i)
           {
-            velocities[i]
-              = std_cxx14::make_unique<Functions::InterpolatedUniformGridData<2>> (grid_extent,
-                                                                                   table_intervals,
-                                                                                   velocity_values[i]);
+            const typename InterpolationWeights::Entry &entry = weights.entries[i];
+            output_boundary_velocity += velocity_values[0](entry.grid_point) * entry.theta_weight
+                                        + velocity_values[1](entry.grid_point) * entry.phi_weight;
           }
 
-        AssertThrow(i == n_points,
-                    ExcMessage (std::string("Number of read in points does not match number of points in file. File corrupted?")));
+        return output_boundary_velocity;
       }
 
 
 
       template <int dim>
-      Tensor<1,dim>
-      GPlatesLookup<dim>::surface_velocity(const Point<dim> &position) const
+      bool
+      GPlatesLookup<dim>::has_same_grid(const GPlatesLookup<dim> &other) const
+      {
+        // The interpolation weights depend on the number of grid points in
+        // both directions, on the grid spacing, and (in 2d) on the rotation
+        // of the model plane. The extents of the grid are always the whole
+        // sphere.
+        return (velocity_values[0].size(0) == other.velocity_values[0].size(0)
+                && velocity_values[0].size(1) == other.velocity_values[0].size(1)
+                && delta_theta == other.delta_theta
+                && delta_phi == other.delta_phi
+                && rotation_matrix == other.rotation_matrix);
+      }
+
+
+
+      template <int dim>
+      typename GPlatesLookup<dim>::InterpolationWeights
+      GPlatesLookup<dim>::interpolation_weights(const Point<dim> &position) const
       {
         const Point<3> internal_position ((dim == 2)
                                           ?
@@ -261,11 +468,13 @@ namespace aspect
         std::array<double,3> spherical_point =
           Utilities::Coordinates::cartesian_to_spherical_coordinates(internal_position);
 
-        Tensor<1,dim> output_boundary_velocity;
+        InterpolationWeights weights;
+        weights.n_entries = 0;
+
         // Handle all points that are not close to the poles
         if ((spherical_point[2] >= delta_theta) && (spherical_point[2] <= numbers::PI - delta_theta))
           {
-            output_boundary_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_cartesian_velocity_weights(spherical_point, 1.0, weights);
           }
 
         // The longitude of data points at the poles is set to zero (according to the internal
@@ -277,61 +486,93 @@ namespace aspect
           {
             const double theta = spherical_point[2];
             spherical_point[2] = delta_theta;
-            const Tensor<1,dim> first_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_cartesian_velocity_weights(spherical_point, theta / delta_theta, weights);
 
             spherical_point[1] = 0.0;
             spherical_point[2] = 0.0;
-            const Tensor<1,dim> polar_velocity = cartesian_velocity_at_surface_point(spherical_point);
-
-            output_boundary_velocity = (theta / delta_theta) * first_velocity
-                                       + (1.0 - theta / delta_theta) * polar_velocity;
+            add_cartesian_velocity_weights(spherical_point, 1.0 - theta / delta_theta, weights);
           }
         else if (spherical_point[2] > numbers::PI - delta_theta)
           {
             const double theta = spherical_point[2];
             spherical_point[2] = numbers::PI - delta_theta;
-            const Tensor<1,dim> first_velocity = cartesian_velocity_at_surface_point(spherical_point);
+            add_cartesian_velocity_weights(spherical_point, (numbers::PI - theta) / delta_theta, weights);
 
             spherical_point[1] = 0.0;
             spherical_point[2] = numbers::PI;
-            const Tensor<1,dim> polar_velocity = cartesian_velocity_at_surface_point(spherical_point);
-
-            output_boundary_velocity = ((numbers::PI - theta) / delta_theta) * first_velocity
-                                       + (1.0 - (numbers::PI - theta) / delta_theta) * polar_velocity;
+            add_cartesian_velocity_weights(spherical_point, 1.0 - (numbers::PI - theta) / delta_theta, weights);
           }
         else
           Assert(false,ExcInternalError());
 
-        return output_boundary_velocity;
+        return weights;
       }
 
 
 
       template <int dim>
-      Tensor<1,dim>
-      GPlatesLookup<dim>::cartesian_velocity_at_surface_point(const std::array<double,3> &spherical_point) const
+      void
+      GPlatesLookup<dim>::add_cartesian_velocity_weights(const std::array<double,3> &spherical_point,
+                                                         const double factor,
+                                                         InterpolationWeights &weights) const
       {
         // Re-sort the components of the spherical position from [r,phi,theta] to [theta, phi]
-        const Point<2> lookup_coordinates(spherical_point[2],spherical_point[1]);
+        const double lookup_coordinates[2] = {spherical_point[2], spherical_point[1]};
+        const double grid_spacing[2] = {delta_theta, delta_phi};
+
+        // Find the grid cell that contains the point and the relative position
+        // within the cell, in the same way as Functions::InterpolatedUniformGridData
+        // does it. The grid covers theta in [0,pi] and phi in [0,2pi].
+        TableIndices<2> ix;
+        double p_unit[2];
+        for (unsigned int d=0; d<2; ++d)
+          {
+            const unsigned int n_intervals = velocity_values[0].size(d) - 1;
+            const double grid_end = n_intervals * grid_spacing[d];
 
-        // Main work, interpolate velocity at this point
-        Tensor<1,2> interpolated_velocity;
+            if (lookup_coordinates[d] <= 0.)
+              ix[d] = 0;
+            else if (lookup_coordinates[d] >= grid_end - grid_spacing[d])
+              ix[d] = n_intervals - 1;
+            else
+              ix[d] = static_cast<unsigned int>(lookup_coordinates[d] / grid_spacing[d]);
 
-        for (unsigned int i = 0; i < 2; i++)
-          interpolated_velocity[i] = velocities[i]->value(lookup_coordinates);
+            p_unit[d] = std::max(std::min((lookup_coordinates[d] - ix[d] * grid_spacing[d]) / grid_spacing[d], 1.), 0.);
+          }
 
-        // Transform interpolated_velocity in cartesian coordinates
-        const Tensor<1,3> interpolated_velocity_in_cart = sphere_to_cart_velocity(interpolated_velocity,spherical_point);
+        // The weights that transform velocities in spherical coordinates into
+        // cartesian coordinates. Convert_tensor conveniently also handles the
+        // projection to the 2D plane by omitting the z-component of velocity
+        // (since the 2D model lies in the x-y plane).
+        Tensor<1,2> unit_theta, unit_phi;
+        unit_theta[0] = 1.0;
+        unit_phi[1] = 1.0;
 
-        // Convert_tensor conveniently also handles the projection to the 2D plane by
-        // omitting the z-component of velocity (since the 2D model lies in the x-y plane).
-        const Tensor<1,dim> output_boundary_velocity = (dim == 2)
-                                                       ?
-                                                       convert_tensor<3,dim>(transpose(rotation_matrix) * interpolated_velocity_in_cart)
-                                                       :
-                                                       convert_tensor<3,dim>(interpolated_velocity_in_cart);
+        Tensor<1,3> theta_direction = sphere_to_cart_velocity(unit_theta,spherical_point);
+        Tensor<1,3> phi_direction = sphere_to_cart_velocity(unit_phi,spherical_point);
+        if (dim == 2)
+          {
+            theta_direction = transpose(rotation_matrix) * theta_direction;
+            phi_direction = transpose(rotation_matrix) * phi_direction;
+          }
 
-        return output_boundary_velocity;
+        const Tensor<1,dim> theta_weight = factor * convert_tensor<3,dim>(theta_direction);
+        const Tensor<1,dim> phi_weight = factor * convert_tensor<3,dim>(phi_direction);
+
+        // Bilinear interpolation between the four corners of the cell
+        for (unsigned int corner=0; corner<4; ++corner)
+          {
+            const unsigned int shift[2] = {corner % 2, corner / 2};
+            const double bilinear_weight = (shift[0] == 1 ? p_unit[0] : 1. - p_unit[0])
+                                           * (shift[1] == 1 ? p_unit[1] : 1. - p_unit[1]);
+
+            Assert(weights.n_entries < weights.entries.size(), ExcInternalError());
+            typename InterpolationWeights::Entry &entry = weights.entries[weights.n_entries];
+            entry.grid_point = TableIndices<2>(ix[0] + shift[0], ix[1] + shift[1]);
+            entry.theta_weight = bilinear_weight * theta_weight;
+            entry.phi_weight = bilinear_weight * phi_weight;
+            ++weights.n_entries;
+          }
       }
 
 
@@ -594,6 +835,11 @@ namespace aspect
                                "preferred coordinate system of the geometry model is spherical "
                                "(e.g. spherical shell, chunk, sphere)."));
 
+      if (cache_directory != "")
+        Utilities::create_directory (cache_directory,
+                                     this->get_mpi_communicator(),
+                                     true);
+
       lookup = std_cxx14::make_unique<internal::GPlatesLookup<dim>>(pointone, pointtwo);
       old_lookup = std_cxx14::make_unique<internal::GPlatesLookup<dim>>(pointone, pointtwo);
 
@@ -615,7 +861,7 @@ namespace aspect
 
       const std::string filename (create_filename (current_file_number));
       if (Utilities::fexists(filename))
-        lookup->load_file(filename,this->get_mpi_communicator());
+        lookup->load_file(filename,this->get_mpi_communicator(),create_cache_filename(filename));
       else
         AssertThrow(false,
                     ExcMessage (std::string("GPlates data file <")
@@ -640,7 +886,7 @@ namespace aspect
           if (Utilities::fexists(filename))
             {
               lookup.swap(old_lookup);
-              lookup->load_file(filename,this->get_mpi_communicator());
+              lookup->load_file(filename,this->get_mpi_communicator(),create_cache_filename(filename));
             }
           else
             end_time_dependence ();
@@ -663,6 +909,25 @@ namespace aspect
 
 
 
+    template <int dim>
+    std::string
+    GPlates<dim>::create_cache_filename (const std::string &filename) const
+    {
+      if (cache_directory == "")
+        return "";
+
+      const std::size_t last_separator = filename.find_last_of('/');
+      const std::string basename = (last_separator == std::string::npos
+                                    ?
+                                    filename
+                                    :
+                                    filename.substr(last_separator+1));
+
+      return cache_directory + basename + ".cache";
+    }
+
+
+
     template <int dim>
     void
     GPlates<dim>::update ()
@@ -730,7 +995,7 @@ namespace aspect
           if (Utilities::fexists(filename))
             {
               lookup.swap(old_lookup);
-              lookup->load_file(filename,this->get_mpi_communicator());
+              lookup->load_file(filename,this->get_mpi_communicator(),create_cache_filename(filename));
             }
 
           // If loading current_time_step failed, end time dependent part with old_file_number.
@@ -751,7 +1016,7 @@ namespace aspect
       if (Utilities::fexists(filename))
         {
           lookup.swap(old_lookup);
-          lookup->load_file(filename,this->get_mpi_communicator());
+          lookup->load_file(filename,this->get_mpi_communicator(),create_cache_filename(filename));
         }
 
       // If next file does not exist, end time dependent part with current_time_step.
@@ -796,12 +1061,20 @@ namespace aspect
 
       if ((this->get_time() - first_data_file_model_time >= 0.0) && (this->get_geometry_model().depth(position) <= lithosphere_thickness + magic_number))
         {
-          const Tensor<1,dim> data = lookup->surface_velocity(position);
+          // Both data files usually use the same grid, so we only need to
+          // find the grid points and interpolation weights once.
+          const typename internal::GPlatesLookup<dim>::InterpolationWeights weights
+            = lookup->interpolation_weights(position);
+          const Tensor<1,dim> data = lookup->surface_velocity(weights);
 
           if (!time_dependent)
             return data;
 
-          const Tensor<1,dim> old_data = old_lookup->surface_velocity(position);
+          const Tensor<1,dim> old_data = (old_lookup->has_same_grid(*lookup)
+                                          ?
+                                          old_lookup->surface_velocity(weights)
+                                          :
+                                          old_lookup->surface_velocity(position));
 
           return time_weight * data + (1 - time_weight) * old_data;
         }
@@ -876,6 +1149,18 @@ namespace aspect
                              Patterns::Double (0.),
                              "Determines the depth of the lithosphere, so that the GPlates velocities can be applied at the sides of the model "
                              "as well as at the surface.");
+          prm.declare_entry ("Cache directory", "",
+                             Patterns::Anything (),
+                             "The name of a directory in which binary copies of the velocity "
+                             "data read from the GPlates files are stored. Parsing the XML "
+                             "structure of a gpml file takes much longer than reading such a "
+                             "copy, so subsequent model runs that use the same files, or a "
+                             "model that is resumed from a checkpoint, start faster. The copies "
+                             "are only used if the content of the corresponding gpml file did "
+                             "not change since they were written. The path may either be absolute "
+                             "or relative to the current directory, and may include the special "
+                             "text '$ASPECT_SOURCE_DIR'. If this parameter is left empty, "
+                             "no copies are stored.");
         }
         prm.leave_subsection();
       }
@@ -903,6 +1188,10 @@ namespace aspect
           point1                     = prm.get        ("Point one");
           point2                     = prm.get        ("Point two");
           lithosphere_thickness      = prm.get_double ("Lithosphere thickness");
+          cache_directory            = Utilities::expand_ASPECT_SOURCE_DIR(prm.get ("Cache directory"));
+
+          if (cache_directory != "" && cache_directory.back() != '/')
+            cache_directory += "/";
 
           if (this->convert_output_to_years())
             {
@@ -50,6 +50,25 @@ namespace aspect
     }
 
 
+    template <int dim>
+    void
+    AsciiData<dim>::
+    initial_compositions (const std::vector<Point<dim> > &positions,
+                          std::vector<std::vector<double> > &compositions) const
+    {
+      std::vector<double> values (compositions.size());
+      for (auto &field_compositions : compositions)
+        field_compositions.resize(positions.size());
+
+      for (unsigned int q=0; q<positions.size(); ++q)
+        {
+          Utilities::AsciiDataInitial<dim>::get_data_components(positions[q],values);
+          for (unsigned int c=0; c<compositions.size(); ++c)
+            compositions[c][q] = values[c];
+        }
+    }
+
+
     template <int dim>
     void
     AsciiData<dim>::declare_parameters (ParameterHandler &prm)
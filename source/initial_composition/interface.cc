@@ -44,6 +44,20 @@ namespace aspect
     {}
 
 
+    template <int dim>
+    void
+    Interface<dim>::initial_compositions (const std::vector<Point<dim> > &positions,
+                                          std::vector<std::vector<double> > &compositions) const
+    {
+      for (unsigned int c=0; c<compositions.size(); ++c)
+        {
+          compositions[c].resize(positions.size());
+          for (unsigned int q=0; q<positions.size(); ++q)
+            compositions[c][q] = initial_composition(positions[q], c);
+        }
+    }
+
+
     template <int dim>
     void
     Interface<dim>::
@@ -175,6 +189,31 @@ namespace aspect
     }
 
 
+
+    template <int dim>
+    void
+    Manager<dim>::initial_compositions (const std::vector<Point<dim> > &positions,
+                                        std::vector<std::vector<double> > &compositions) const
+    {
+      compositions.resize(this->n_compositional_fields());
+      for (auto &field_compositions : compositions)
+        field_compositions.assign(positions.size(), 0.0);
+
+      std::vector<std::vector<double> > object_compositions(this->n_compositional_fields());
+      int i = 0;
+
+      for (const auto &initial_composition_object : initial_composition_objects)
+        {
+          initial_composition_object->initial_compositions(positions, object_compositions);
+          for (unsigned int c=0; c<compositions.size(); ++c)
+            for (unsigned int q=0; q<positions.size(); ++q)
+              compositions[c][q] = model_operators[i](compositions[c][q],
+                                                      object_compositions[c][q]);
+          i++;
+        }
+    }
+
+
     template <int dim>
     const std::vector<std::string> &
     Manager<dim>::get_active_initial_composition_names () const
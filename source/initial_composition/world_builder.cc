@@ -49,6 +49,26 @@ namespace aspect
                                                    n_comp);
     }
 
+
+    template <int dim>
+    void
+    WorldBuilder<dim>::
+    initial_compositions (const std::vector<Point<dim> > &positions,
+                          std::vector<std::vector<double> > &compositions) const
+    {
+      for (auto &field_compositions : compositions)
+        field_compositions.resize(positions.size());
+
+      for (unsigned int q=0; q<positions.size(); ++q)
+        {
+          const std::array<double,dim> position = Utilities::convert_point_to_array(positions[q]);
+          const double depth = -this->get_geometry_model().height_above_reference_surface(positions[q]);
+
+          for (unsigned int c=0; c<compositions.size(); ++c)
+            compositions[c][q] = this->get_world_builder().composition(position, depth, c);
+        }
+    }
+
   }
 }
 
@@ -43,6 +43,17 @@ namespace aspect
     {}
 
 
+    template <int dim>
+    void
+    Interface<dim>::initial_temperatures (const std::vector<Point<dim> > &positions,
+                                          std::vector<double> &temperatures) const
+    {
+      temperatures.resize(positions.size());
+      for (unsigned int q=0; q<positions.size(); ++q)
+        temperatures[q] = initial_temperature(positions[q]);
+    }
+
+
     template <int dim>
     void
     Interface<dim>::
@@ -163,6 +174,27 @@ namespace aspect
     }
 
 
+
+    template <int dim>
+    void
+    Manager<dim>::initial_temperatures (const std::vector<Point<dim> > &positions,
+                                        std::vector<double> &temperatures) const
+    {
+      temperatures.assign(positions.size(), 0.0);
+      std::vector<double> object_temperatures;
+      int i = 0;
+
+      for (const auto &initial_temperature_object : initial_temperature_objects)
+        {
+          initial_temperature_object->initial_temperatures(positions, object_temperatures);
+          for (unsigned int q=0; q<positions.size(); ++q)
+            temperatures[q] = model_operators[i](temperatures[q],
+                                                 object_temperatures[q]);
+          i++;
+        }
+    }
+
+
     template <int dim>
     const std::vector<std::string> &
     Manager<dim>::get_active_initial_temperature_names () const
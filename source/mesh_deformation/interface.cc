@@ -96,7 +96,10 @@ namespace aspect
       : sim(simulator),  // reference to the simulator that owns the MeshDeformationHandler
         mesh_deformation_fe (FE_Q<dim>(1),dim), // Q1 elements which describe the mesh geometry
         mesh_deformation_dof_handler (sim.triangulation),
-        include_initial_topography(false)
+        include_initial_topography(false),
+        reuse_mesh_deformation_preconditioner(false),
+        mesh_matrix_sparsity_is_current(false),
+        mesh_preconditioner_reference_iterations(0)
     {
       // Now reset the mapping of the simulator to be something that captures mesh deformation in time.
       sim.mapping.reset (new MappingQ1Eulerian<dim, LinearAlgebra::Vector> (mesh_deformation_dof_handler,
@@ -209,6 +212,18 @@ namespace aspect
                            "\n\n"
                            "The format is id1: object1 \\& object2, id2: object3 \\& object2, where "
                            "objects are one of " + std::get<dim>(registered_plugins).get_description_string());
+        prm.declare_entry ("Reuse mesh deformation preconditioner", "false",
+                           Patterns::Bool (),
+                           "Whether to keep the AMG preconditioner for the elliptic problem "
+                           "that determines the mesh velocity in the interior of the domain "
+                           "between time steps instead of rebuilding it in every time step. "
+                           "The matrix of this problem changes only slightly from one time step "
+                           "to the next as the mesh deforms, so the old preconditioner usually "
+                           "remains effective, and setting up the AMG hierarchy can be a "
+                           "significant part of the cost of the mesh deformation. The "
+                           "preconditioner is still rebuilt whenever the mesh or the structure "
+                           "of the boundary constraints changes, or if the number of "
+                           "iterations of the solver grows substantially.");
       }
       prm.leave_subsection ();
 
@@ -322,6 +337,8 @@ namespace aspect
 
         for (const auto &boundary_id : tangential_mesh_deformation_boundary_indicators)
           zero_mesh_deformation_boundary_indicators.erase(boundary_id);
+
+        reuse_mesh_deformation_preconditioner = prm.get_bool("Reuse mesh deformation preconditioner");
       }
       prm.leave_subsection ();
 
@@ -590,31 +607,60 @@ namespace aspect
       for (unsigned int c=0; c<dim; ++c)
         coupling[c][c] = DoFTools::always;
 
-      LinearAlgebra::SparseMatrix mesh_matrix;
+      // The sparsity pattern only depends on the mesh and on which degrees
+      // of freedom are constrained to which others, but not on the
+      // coefficients of the constraints. Both typically stay the same over
+      // many time steps, so only rebuild the pattern if one of them changed.
+      std::vector<types::global_dof_index> constraint_structure;
+      for (const auto &line : mesh_velocity_constraints.get_lines())
+        {
+          constraint_structure.push_back(line.index);
+          constraint_structure.push_back(line.entries.size());
+          for (const auto &entry : line.entries)
+            constraint_structure.push_back(entry.first);
+        }
+
+      const bool rebuild_sparsity_pattern
+        = (Utilities::MPI::max((mesh_matrix_sparsity_is_current == false
+                                ||
+                                constraint_structure != mesh_velocity_constraint_structure) ? 1 : 0,
+                               sim.mpi_communicator) == 1);
+
+      if (rebuild_sparsity_pattern)
+        {
+          // The preconditioner refers to the matrix, so it has to go first.
+          mesh_preconditioner.reset();
+
 #ifdef ASPECT_USE_PETSC
-      LinearAlgebra::DynamicSparsityPattern sp(mesh_locally_relevant);
+          LinearAlgebra::DynamicSparsityPattern sp(mesh_locally_relevant);
 #else
-      TrilinosWrappers::SparsityPattern sp (mesh_locally_owned,
-                                            mesh_locally_owned,
-                                            mesh_locally_relevant,
-                                            sim.mpi_communicator);
+          TrilinosWrappers::SparsityPattern sp (mesh_locally_owned,
+                                                mesh_locally_owned,
+                                                mesh_locally_relevant,
+                                                sim.mpi_communicator);
 #endif
-      DoFTools::make_sparsity_pattern (mesh_deformation_dof_handler,
-                                       coupling, sp,
-                                       mesh_velocity_constraints, false,
-                                       Utilities::MPI::
-                                       this_mpi_process(sim.mpi_communicator));
+          DoFTools::make_sparsity_pattern (mesh_deformation_dof_handler,
+                                           coupling, sp,
+                                           mesh_velocity_constraints, false,
+                                           Utilities::MPI::
+                                           this_mpi_process(sim.mpi_communicator));
 #ifdef ASPECT_USE_PETSC
-      SparsityTools::distribute_sparsity_pattern(sp,
-                                                 mesh_deformation_dof_handler.n_locally_owned_dofs_per_processor(),
-                                                 sim.mpi_communicator, mesh_locally_relevant);
-      sp.compress();
-      mesh_matrix.reinit (mesh_locally_owned, mesh_locally_owned, sp, sim.mpi_communicator);
+          SparsityTools::distribute_sparsity_pattern(sp,
+                                                     mesh_deformation_dof_handler.n_locally_owned_dofs_per_processor(),
+                                                     sim.mpi_communicator, mesh_locally_relevant);
+          sp.compress();
+          mesh_matrix.reinit (mesh_locally_owned, mesh_locally_owned, sp, sim.mpi_communicator);
 #else
-      sp.compress();
-      mesh_matrix.reinit (sp);
+          sp.compress();
+          mesh_matrix.reinit (sp);
 #endif
 
+          mesh_velocity_constraint_structure.swap(constraint_structure);
+          mesh_matrix_sparsity_is_current = true;
+        }
+      else
+        mesh_matrix = 0;
+
       // carry out the solution
       FEValuesExtractors::Vector extract_vel(0);
 
@@ -648,31 +694,66 @@ namespace aspect
       rhs.compress (VectorOperation::add);
       mesh_matrix.compress (VectorOperation::add);
 
-      // Make the AMG preconditioner
-      std::vector<std::vector<bool> > constant_modes;
-      DoFTools::extract_constant_modes (mesh_deformation_dof_handler,
-                                        ComponentMask(dim, true),
-                                        constant_modes);
-      // TODO: think about keeping object between time steps
-      LinearAlgebra::PreconditionAMG preconditioner_stiffness;
-      LinearAlgebra::PreconditionAMG::AdditionalData Amg_data;
+      // Make the AMG preconditioner, unless we can reuse the one from
+      // the previous time step. The matrix entries change as the mesh
+      // deforms, but an AMG hierarchy built for a slightly different mesh
+      // is still a good preconditioner.
+      const auto build_preconditioner = [&]()
+      {
+        mesh_preconditioner.reset();
+
+        std::vector<std::vector<bool> > constant_modes;
+        DoFTools::extract_constant_modes (mesh_deformation_dof_handler,
+                                          ComponentMask(dim, true),
+                                          constant_modes);
+        LinearAlgebra::PreconditionAMG::AdditionalData Amg_data;
 #ifdef ASPECT_USE_PETSC
-      Amg_data.symmetric_operator = false;
+        Amg_data.symmetric_operator = false;
 #else
-      Amg_data.constant_modes = constant_modes;
-      Amg_data.elliptic = true;
-      Amg_data.higher_order_elements = false;
-      Amg_data.smoother_sweeps = 2;
-      Amg_data.aggregation_threshold = 0.02;
+        Amg_data.constant_modes = constant_modes;
+        Amg_data.elliptic = true;
+        Amg_data.higher_order_elements = false;
+        Amg_data.smoother_sweeps = 2;
+        Amg_data.aggregation_threshold = 0.02;
 #endif
-      preconditioner_stiffness.initialize(mesh_matrix);
+        mesh_preconditioner = std_cxx14::make_unique<LinearAlgebra::PreconditionAMG>();
+        mesh_preconditioner->initialize(mesh_matrix);
+      };
+
+      bool preconditioner_is_new = false;
+      if (mesh_preconditioner == nullptr || reuse_mesh_deformation_preconditioner == false)
+        {
+          build_preconditioner();
+          preconditioner_is_new = true;
+        }
 
       SolverControl solver_control(5*rhs.size(), sim.parameters.linear_stokes_solver_tolerance*rhs.l2_norm());
       SolverCG<LinearAlgebra::Vector> cg(solver_control);
 
-      cg.solve (mesh_matrix, velocity_solution, rhs, preconditioner_stiffness);
+      try
+        {
+          cg.solve (mesh_matrix, velocity_solution, rhs, *mesh_preconditioner);
+        }
+      catch (const SolverControl::NoConvergence &)
+        {
+          // If an old preconditioner was not good enough any more, try
+          // again with a new one. Otherwise there is nothing we can do.
+          if (preconditioner_is_new)
+            throw;
+
+          build_preconditioner();
+          preconditioner_is_new = true;
+          cg.solve (mesh_matrix, velocity_solution, rhs, *mesh_preconditioner);
+        }
       this->get_pcout() << "   Solving mesh velocity system... " << solver_control.last_step() <<" iterations."<< std::endl;
 
+      // Remember how well a new preconditioner works, and discard an old
+      // one once it needs substantially more iterations than that.
+      if (preconditioner_is_new)
+        mesh_preconditioner_reference_iterations = solver_control.last_step();
+      else if (solver_control.last_step() > 2*mesh_preconditioner_reference_iterations + 5)
+        mesh_preconditioner.reset();
+
       mesh_velocity_constraints.distribute (velocity_solution);
 
       // Update the mesh velocity vector
@@ -924,6 +1005,11 @@ namespace aspect
                            sim.mpi_communicator);
 
 
+      // The matrix and the preconditioner of the mesh velocity system
+      // refer to the old degrees of freedom, so they need to be rebuilt.
+      mesh_preconditioner.reset();
+      mesh_matrix_sparsity_is_current = false;
+
       mesh_deformation_dof_handler.distribute_dofs(mesh_deformation_fe);
 
       this->get_pcout() << "Number of mesh deformation degrees of freedom: "
@@ -22,6 +22,9 @@
 #include <aspect/mesh_refinement/interface.h>
 #include <aspect/utilities.h>
 
+#include <deal.II/base/work_stream.h>
+#include <deal.II/grid/filtered_iterator.h>
+
 #include <typeinfo>
 
 
@@ -29,6 +32,88 @@ namespace aspect
 {
   namespace MeshRefinement
   {
+    namespace
+    {
+      /**
+       * The scratch object used to evaluate the material model at the
+       * support points of the temperature element.
+       */
+      template <int dim>
+      struct MaterialModelEvaluationScratch
+      {
+        MaterialModelEvaluationScratch (const Mapping<dim> &mapping,
+                                        const FiniteElement<dim> &fe,
+                                        const Quadrature<dim> &quadrature,
+                                        const unsigned int n_compositional_fields)
+          :
+          fe_values (mapping, fe, quadrature,
+                     update_quadrature_points | update_values | update_gradients),
+          material_model_inputs (quadrature.size(), n_compositional_fields),
+          material_model_outputs (quadrature.size(), n_compositional_fields)
+        {}
+
+        MaterialModelEvaluationScratch (const MaterialModelEvaluationScratch &scratch)
+          :
+          fe_values (scratch.fe_values.get_mapping(),
+                     scratch.fe_values.get_fe(),
+                     scratch.fe_values.get_quadrature(),
+                     scratch.fe_values.get_update_flags()),
+          material_model_inputs (scratch.material_model_inputs),
+          material_model_outputs (scratch.material_model_outputs)
+        {}
+
+        FEValues<dim> fe_values;
+        MaterialModel::MaterialModelInputs<dim> material_model_inputs;
+        MaterialModel::MaterialModelOutputs<dim> material_model_outputs;
+      };
+
+
+
+      /**
+       * The material properties that can be shared between plugins.
+       */
+      const MaterialModel::MaterialProperties::Property shared_material_properties[]
+        = {MaterialModel::MaterialProperties::viscosity,
+           MaterialModel::MaterialProperties::density,
+           MaterialModel::MaterialProperties::thermal_expansion_coefficient,
+           MaterialModel::MaterialProperties::specific_heat,
+           MaterialModel::MaterialProperties::thermal_conductivity,
+           MaterialModel::MaterialProperties::compressibility
+          };
+
+
+
+      /**
+       * Return the output vector of @p out that corresponds to @p property.
+       */
+      template <int dim>
+      const std::vector<double> &
+      get_material_model_output (const MaterialModel::MaterialModelOutputs<dim> &out,
+                                 const MaterialModel::MaterialProperties::Property property)
+      {
+        switch (property)
+          {
+            case MaterialModel::MaterialProperties::viscosity:
+              return out.viscosities;
+            case MaterialModel::MaterialProperties::density:
+              return out.densities;
+            case MaterialModel::MaterialProperties::thermal_expansion_coefficient:
+              return out.thermal_expansion_coefficients;
+            case MaterialModel::MaterialProperties::specific_heat:
+              return out.specific_heat;
+            case MaterialModel::MaterialProperties::thermal_conductivity:
+              return out.thermal_conductivities;
+            case MaterialModel::MaterialProperties::compressibility:
+              return out.compressibilities;
+            default:
+              AssertThrow (false, ExcNotImplemented());
+              return out.viscosities;
+          }
+      }
+    }
+
+
+
 // ------------------------------ Interface -----------------------------
 
     template <int dim>
@@ -62,6 +147,14 @@ namespace aspect
     {}
 
 
+    template <int dim>
+    MaterialModel::MaterialProperties::Property
+    Interface<dim>::get_needed_material_properties () const
+    {
+      return MaterialModel::MaterialProperties::none;
+    }
+
+
     template <int dim>
     void
     Interface<dim>::declare_parameters (ParameterHandler &)
@@ -156,6 +249,16 @@ namespace aspect
       // verify that its values are non-negative numbers
       std::vector<Vector<float> > all_error_indicators (mesh_refinement_objects.size(),
                                                         Vector<float>(error_indicators.size()));
+
+      // evaluate the material model once for all plugins that need
+      // material properties, rather than once in every plugin
+      MaterialModel::MaterialProperties::Property needed_properties = MaterialModel::MaterialProperties::none;
+      for (const auto &p : mesh_refinement_objects)
+        needed_properties = needed_properties | p->get_needed_material_properties();
+
+      if (needed_properties != MaterialModel::MaterialProperties::none)
+        evaluate_material_model_at_temperature_support_points (needed_properties);
+
       unsigned int index = 0;
       for (typename std::list<std::unique_ptr<Interface<dim> > >::const_iterator
            p = mesh_refinement_objects.begin();
@@ -252,6 +355,101 @@ namespace aspect
           default:
             Assert (false, ExcNotImplemented());
         }
+
+      // release the memory of the shared material model evaluation
+      material_properties_at_support_points.clear();
+      temperatures_at_support_points.reinit (0, 0);
+    }
+
+
+
+    template <int dim>
+    void
+    Manager<dim>::evaluate_material_model_at_temperature_support_points (const MaterialModel::MaterialProperties::Property properties) const
+    {
+      const Quadrature<dim> quadrature(this->get_fe().base_element(this->introspection().base_elements.temperature).get_unit_support_points());
+      const unsigned int n_active_cells = this->get_triangulation().n_active_cells();
+
+      temperatures_at_support_points.reinit (n_active_cells, quadrature.size());
+      material_properties_at_support_points.clear();
+      for (const auto property : shared_material_properties)
+        if ((properties & property) != 0)
+          material_properties_at_support_points[property].reinit (n_active_cells, quadrature.size());
+
+      // the viscosity is the only property that depends on the strain rate
+      const bool use_strain_rates = (properties & MaterialModel::MaterialProperties::viscosity) != 0;
+
+      // every cell only writes into its own row of the tables, which
+      // have been allocated above, so the results can be stored directly
+      // in the worker and no copier is needed
+      auto worker = [&] (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                         MaterialModelEvaluationScratch<dim> &scratch,
+                         unsigned int &)
+      {
+        MaterialModel::MaterialModelInputs<dim> &in = scratch.material_model_inputs;
+        MaterialModel::MaterialModelOutputs<dim> &out = scratch.material_model_outputs;
+
+        scratch.fe_values.reinit (cell);
+        in.reinit (scratch.fe_values, cell, this->introspection(), this->get_solution(), use_strain_rates);
+        in.requested_properties = properties;
+
+        this->get_material_model().evaluate (in, out);
+
+        const unsigned int cell_index = cell->active_cell_index();
+        for (unsigned int q=0; q<quadrature.size(); ++q)
+          temperatures_at_support_points[cell_index][q] = in.temperature[q];
+
+        for (auto &property_values : material_properties_at_support_points)
+          {
+            const std::vector<double> &values = get_material_model_output (out, property_values.first);
+            for (unsigned int q=0; q<quadrature.size(); ++q)
+              property_values.second[cell_index][q] = values[q];
+          }
+      };
+
+      using CellFilter = FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
+
+      WorkStream::
+      run (CellFilter (IteratorFilters::LocallyOwnedCell(),
+                       this->get_dof_handler().begin_active()),
+           CellFilter (IteratorFilters::LocallyOwnedCell(),
+                       this->get_dof_handler().end()),
+           worker,
+           [] (const unsigned int &) {},
+           MaterialModelEvaluationScratch<dim> (this->get_mapping(),
+                                                this->get_fe(),
+                                                quadrature,
+                                                this->n_compositional_fields()),
+           0U);
+    }
+
+
+
+    template <int dim>
+    const Table<2,double> &
+    Manager<dim>::get_material_property_at_temperature_support_points (const MaterialModel::MaterialProperties::Property property) const
+    {
+      const auto property_values = material_properties_at_support_points.find (property);
+      AssertThrow (property_values != material_properties_at_support_points.end(),
+                   ExcMessage ("The requested material property has not been evaluated. "
+                               "Mesh refinement plugins need to request the material "
+                               "properties they need through get_needed_material_properties(), "
+                               "and can only access them from within their execute() function."));
+      return property_values->second;
+    }
+
+
+
+    template <int dim>
+    const Table<2,double> &
+    Manager<dim>::get_temperatures_at_temperature_support_points () const
+    {
+      AssertThrow (temperatures_at_support_points.n_rows() == this->get_triangulation().n_active_cells(),
+                   ExcMessage ("The temperatures at the support points have not been evaluated. "
+                               "Mesh refinement plugins can only access them from within "
+                               "their execute() function, and only if they request some "
+                               "material property through get_needed_material_properties()."));
+      return temperatures_at_support_points;
     }
 
 
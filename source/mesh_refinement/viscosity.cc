@@ -30,6 +30,15 @@ namespace aspect
 {
   namespace MeshRefinement
   {
+    template <int dim>
+    MaterialModel::MaterialProperties::Property
+    Viscosity<dim>::get_needed_material_properties () const
+    {
+      return MaterialModel::MaterialProperties::viscosity;
+    }
+
+
+
     template <int dim>
     void
     Viscosity<dim>::execute(Vector<float> &indicators) const
@@ -52,34 +61,20 @@ namespace aspect
       LinearAlgebra::BlockVector vec_distributed (this->introspection().index_sets.system_partitioning,
                                                   this->get_mpi_communicator());
 
-      const Quadrature<dim> quadrature(this->get_fe().base_element(this->introspection().base_elements.temperature).get_unit_support_points());
-      std::vector<types::global_dof_index> local_dof_indices (this->get_fe().dofs_per_cell);
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature,
-                               update_quadrature_points | update_values | update_gradients);
-
-      // the values of the compositional fields are stored as block vectors for each field
-      // we have to extract them in this structure
-      std::vector<std::vector<double> > prelim_composition_values (this->n_compositional_fields(),
-                                                                   std::vector<double> (quadrature.size()));
+      // the material model has already been evaluated at these points
+      // by the manager for all plugins that need material properties
+      const Table<2,double> &viscosities
+        = this->get_mesh_refinement_manager().get_material_property_at_temperature_support_points(MaterialModel::MaterialProperties::viscosity);
 
-      MaterialModel::MaterialModelInputs<dim> in(quadrature.size(),
-                                                 this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<dim> out(quadrature.size(),
-                                                   this->n_compositional_fields());
+      std::vector<types::global_dof_index> local_dof_indices (this->get_fe().dofs_per_cell);
 
       for (const auto &cell : this->get_dof_handler().active_cell_iterators())
         if (cell->is_locally_owned())
           {
-            fe_values.reinit(cell);
-            in.reinit(fe_values, cell, this->introspection(), this->get_solution());
-            this->get_material_model().evaluate(in, out);
-
             cell->get_dof_indices (local_dof_indices);
 
             // for each temperature dof, write into the output
-            // vector the viscosity. note that quadrature points and
+            // vector the viscosity. note that support points and
             // dofs are enumerated in the same order
             for (unsigned int i=0; i<this->get_fe().base_element(this->introspection().base_elements.temperature).dofs_per_cell; ++i)
               {
@@ -88,7 +83,7 @@ namespace aspect
                                                              /*dof index within component=*/i);
 
                 vec_distributed(local_dof_indices[system_local_dof])
-                  = std::log(out.viscosities[i]);
+                  = std::log(viscosities[cell->active_cell_index()][i]);
               }
           }
 
@@ -33,11 +33,12 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    CompositionStatistics<dim>::execute (TableHandler &statistics)
+    void
+    CompositionStatistics<dim>::compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                             ReductionBuffer &reductions)
     {
       if (this->n_compositional_fields() == 0)
-        return std::pair<std::string,std::string>();
+        return;
 
       // create a quadrature formula based on the compositional element alone.
       // be defensive about determining that a compositional field actually exists
@@ -45,46 +46,34 @@ namespace aspect
                    != numbers::invalid_unsigned_int,
                    ExcMessage("This postprocessor cannot be used without compositional fields."));
       const QGauss<dim> quadrature_formula (this->get_fe().base_element(this->introspection().base_elements.compositional_fields).degree+1);
-      const unsigned int n_q_points = quadrature_formula.size();
-
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_quadrature_points |
-                               update_JxW_values);
-
-      std::vector<double> compositional_values(n_q_points);
 
-      std::vector<double> local_compositional_integrals (this->n_compositional_fields());
+      compositional_integrals.assign (this->n_compositional_fields(), 0.);
 
       // compute the integral quantities by quadrature
-      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-        if (cell->is_locally_owned())
+      std::vector<double> compositional_values(quadrature_formula.size());
+      cell_sweep.add_kernel (quadrature_formula,
+                             update_values   |
+                             update_quadrature_points |
+                             update_JxW_values,
+                             [this, compositional_values] (const typename DoFHandler<dim>::active_cell_iterator &,
+                                                           const FEValues<dim> &fe_values) mutable
+      {
+        for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
           {
-            fe_values.reinit (cell);
-
-            for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
-              {
-                fe_values[this->introspection().extractors.compositional_fields[c]].get_function_values (this->get_solution(),
-                    compositional_values);
-                for (unsigned int q=0; q<n_q_points; ++q)
-                  local_compositional_integrals[c] += compositional_values[q]*fe_values.JxW(q);
-              }
+            fe_values[this->introspection().extractors.compositional_fields[c]].get_function_values (this->get_solution(),
+                compositional_values);
+            for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
+              compositional_integrals[c] += compositional_values[q]*fe_values.JxW(q);
           }
-      // compute the sum over all processors
-      std::vector<double> global_compositional_integrals (local_compositional_integrals.size());
-      Utilities::MPI::sum (local_compositional_integrals,
-                           this->get_mpi_communicator(),
-                           global_compositional_integrals);
+      });
 
       // compute min/max by simply
       // looping over the elements of the
       // solution vector.
-      std::vector<double> local_min_compositions (this->n_compositional_fields(),
-                                                  std::numeric_limits<double>::max());
-      std::vector<double> local_max_compositions (this->n_compositional_fields(),
-                                                  -std::numeric_limits<double>::max());
+      min_compositions.assign (this->n_compositional_fields(),
+                               std::numeric_limits<double>::max());
+      max_compositions.assign (this->n_compositional_fields(),
+                               -std::numeric_limits<double>::max());
 
       for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
         {
@@ -94,25 +83,30 @@ namespace aspect
               const unsigned int idx = range.nth_index_in_set(i);
               const double val =  this->get_solution().block(this->introspection().block_indices.compositional_fields[c])(idx);
 
-              local_min_compositions[c] = std::min<double> (local_min_compositions[c], val);
-              local_max_compositions[c] = std::max<double> (local_max_compositions[c], val);
+              min_compositions[c] = std::min<double> (min_compositions[c], val);
+              max_compositions[c] = std::max<double> (max_compositions[c], val);
             }
 
         }
 
-      // now do the reductions over all processors
-      std::vector<double> global_min_compositions (this->n_compositional_fields(),
-                                                   std::numeric_limits<double>::max());
-      std::vector<double> global_max_compositions (this->n_compositional_fields(),
-                                                   -std::numeric_limits<double>::max());
-      {
-        Utilities::MPI::min (local_min_compositions,
-                             this->get_mpi_communicator(),
-                             global_min_compositions);
-        Utilities::MPI::max (local_max_compositions,
-                             this->get_mpi_communicator(),
-                             global_max_compositions);
-      }
+      reductions.add_sum (compositional_integrals);
+      reductions.add_min (min_compositions);
+      reductions.add_max (max_compositions);
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    CompositionStatistics<dim>::execute (TableHandler &statistics)
+    {
+      if (this->n_compositional_fields() == 0)
+        return std::pair<std::string,std::string>();
+
+      // the global values were computed in compute_local_contributions()
+      const std::vector<double> &global_compositional_integrals = compositional_integrals;
+      const std::vector<double> &global_min_compositions = min_compositions;
+      const std::vector<double> &global_max_compositions = max_compositions;
 
       // finally produce something for the statistics file
       for (unsigned int c=0; c<this->n_compositional_fields(); ++c)
@@ -22,6 +22,7 @@
 #include <aspect/postprocess/dynamic_topography.h>
 
 #include <aspect/postprocess/boundary_pressures.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -62,13 +63,13 @@ namespace aspect
 
       // The CBF method involves both boundary and volume integrals on the
       // cells at the boundary. Construct FEValues objects for each of these integrations.
-      FEValues<dim> fe_volume_values (this->get_mapping(),
-                                      this->get_fe(),
-                                      quadrature_formula,
-                                      update_values |
-                                      update_gradients |
-                                      update_quadrature_points |
-                                      update_JxW_values);
+      const std::shared_ptr<CellEvaluationScratch<dim> > volume_scratch
+        = this->borrow_cell_evaluation_scratch (quadrature_formula,
+                                                update_values |
+                                                update_gradients |
+                                                update_quadrature_points |
+                                                update_JxW_values);
+      FEValues<dim> &fe_volume_values = volume_scratch->fe_values;
 
       FEFaceValues<dim> fe_face_values (this->get_mapping(),
                                         this->get_fe(),
@@ -85,6 +86,12 @@ namespace aspect
       std::vector<double> div_phi_u (dofs_per_cell);
       std::vector<double> div_solution(n_q_points);
 
+      // Material model inputs and outputs, reused on every cell.
+      MaterialModel::MaterialModelInputs<dim> &in_volume = volume_scratch->material_model_inputs;
+      MaterialModel::MaterialModelOutputs<dim> &out_volume = volume_scratch->material_model_outputs;
+      MaterialModel::MaterialModelInputs<dim> in_face(n_face_q_points, this->n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> out_face(n_face_q_points, this->n_compositional_fields());
+
       // Vectors for solving CBF system.
       Vector<double> local_vector(dofs_per_cell);
       Vector<double> local_mass_matrix(dofs_per_cell);
@@ -146,13 +153,11 @@ namespace aspect
             local_mass_matrix = 0.;
 
             // Evaluate the material model in the cell volume.
-            MaterialModel::MaterialModelInputs<dim> in_volume(fe_volume_values, cell, this->introspection(), this->get_solution());
-            MaterialModel::MaterialModelOutputs<dim> out_volume(fe_volume_values.n_quadrature_points, this->n_compositional_fields());
+            in_volume.reinit(fe_volume_values, cell, this->introspection(), this->get_solution());
             this->get_material_model().evaluate(in_volume, out_volume);
 
             // Evaluate the material model on the cell face.
-            MaterialModel::MaterialModelInputs<dim> in_face(fe_face_values, cell, this->introspection(), this->get_solution());
-            MaterialModel::MaterialModelOutputs<dim> out_face(fe_face_values.n_quadrature_points, this->n_compositional_fields());
+            in_face.reinit(fe_face_values, cell, this->introspection(), this->get_solution());
             this->get_material_model().evaluate(in_face, out_face);
 
             // Get solution values for the divergence of the velocity, which is not
@@ -236,6 +241,12 @@ namespace aspect
                                           update_quadrature_points | update_JxW_values);
       std::vector<Tensor<1,dim> > stress_output_values( output_quadrature.size() );
 
+      // Material model inputs and outputs, reused on every cell.
+      MaterialModel::MaterialModelInputs<dim> in_support(fe_support_values.n_quadrature_points, this->n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> out_support(fe_support_values.n_quadrature_points, this->n_compositional_fields());
+      MaterialModel::MaterialModelInputs<dim> in_output(fe_output_values.n_quadrature_points, this->n_compositional_fields());
+      MaterialModel::MaterialModelOutputs<dim> out_output(fe_output_values.n_quadrature_points, this->n_compositional_fields());
+
 
       for (const auto &cell : this->get_dof_handler().active_cell_iterators())
         if (cell->is_locally_owned() && cell->at_boundary())
@@ -281,8 +292,7 @@ namespace aspect
             fe_support_values.reinit (cell, face_idx);
 
             // Evaluate the material model on the cell face.
-            MaterialModel::MaterialModelInputs<dim> in_support(fe_support_values, cell, this->introspection(), this->get_solution());
-            MaterialModel::MaterialModelOutputs<dim> out_support(fe_support_values.n_quadrature_points, this->n_compositional_fields());
+            in_support.reinit(fe_support_values, cell, this->introspection(), this->get_solution());
             this->get_material_model().evaluate(in_support, out_support);
 
             fe_support_values[this->introspection().extractors.velocities].get_function_values(topo_vector, stress_support_values);
@@ -325,8 +335,7 @@ namespace aspect
             fe_output_values.reinit(cell, face_idx);
 
             // Evaluate the material model on the cell face.
-            MaterialModel::MaterialModelInputs<dim> in_output(fe_output_values, cell, this->introspection(), this->get_solution());
-            MaterialModel::MaterialModelOutputs<dim> out_output(fe_output_values.n_quadrature_points, this->n_compositional_fields());
+            in_output.reinit(fe_output_values, cell, this->introspection(), this->get_solution());
             this->get_material_model().evaluate(in_output, out_output);
 
             fe_output_values[this->introspection().extractors.velocities].get_function_values(topo_vector, stress_output_values);
@@ -25,6 +25,7 @@
 #include <aspect/postprocess/dynamic_topography.h>
 #include <aspect/postprocess/boundary_densities.h>
 #include <aspect/geometry_model/spherical_shell.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -96,16 +97,16 @@ namespace aspect
       // need to evaluate density contribution of each volume quadrature point
       const QGauss<3> quadrature_formula(quadrature_degree);
 
-      FEValues<3> fe_values (this->get_mapping(),
-                             this->get_fe(),
-                             quadrature_formula,
-                             update_values |
-                             update_quadrature_points |
-                             update_JxW_values |
-                             update_gradients);
+      const std::shared_ptr<CellEvaluationScratch<3> > scratch
+        = this->borrow_cell_evaluation_scratch (quadrature_formula,
+                                                update_values |
+                                                update_quadrature_points |
+                                                update_JxW_values |
+                                                update_gradients);
 
-      MaterialModel::MaterialModelInputs<3> in(fe_values.n_quadrature_points, this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<3> out(fe_values.n_quadrature_points, this->n_compositional_fields());
+      FEValues<3> &fe_values = scratch->fe_values;
+      MaterialModel::MaterialModelInputs<3> &in = scratch->material_model_inputs;
+      MaterialModel::MaterialModelOutputs<3> &out = scratch->material_model_outputs;
 
       std::vector<std::vector<double> > composition_values (this->n_compositional_fields(),std::vector<double> (quadrature_formula.size()));
 
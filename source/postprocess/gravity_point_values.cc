@@ -26,6 +26,7 @@
 #include <aspect/adiabatic_conditions/interface.h>
 #include <aspect/global.h>
 #include <aspect/utilities.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -38,6 +39,421 @@ namespace aspect
 {
   namespace Postprocess
   {
+    namespace internal
+    {
+      /**
+       * A tree (an octree in 3d) over the quadrature points of the locally
+       * owned cells that allows to evaluate the gravity field of the mass
+       * associated with these points in O(log N) operations per evaluation
+       * point, instead of O(N) operations for the direct sum.
+       *
+       * Every node of the tree stores the monopole and dipole moments of the
+       * masses (and mass anomalies) it contains with respect to the center
+       * of its bounding box. When the field is evaluated at a point that is
+       * far away from a node compared to the size of the node, the
+       * contribution of all masses in the node is approximated by the
+       * expansion of the field around the center of the node. Because the
+       * expansion is computed about the geometric center and includes the
+       * dipole term, this also works for mass anomalies that can have
+       * either sign. Otherwise the children of the node are visited, and
+       * in the leaves the contributions of all points are summed directly.
+       */
+      template <int dim>
+      class GravityTree
+      {
+        public:
+          /**
+           * Build the tree from the positions of the quadrature points and
+           * the mass and mass anomaly (i.e., density times JxW) associated
+           * with each of them.
+           */
+          GravityTree (const std::vector<Point<dim> > &positions,
+                       const std::vector<double> &masses,
+                       const std::vector<double> &anomaly_masses);
+
+          /**
+           * Add the gravity acceleration, gravity anomaly, gravity gradient
+           * and gravity potential at the given point to the last four
+           * arguments. Nodes whose size divided by their distance to the
+           * point is smaller than @p opening_angle are approximated by their
+           * multipole expansion.
+           */
+          void
+          evaluate (const Point<dim> &position_satellite,
+                    const double opening_angle,
+                    Tensor<1,dim> &g,
+                    Tensor<1,dim> &g_anomaly,
+                    Tensor<2,dim> &g_gradient,
+                    double &g_potential) const;
+
+        private:
+          /**
+           * The maximum number of points in a leaf of the tree.
+           */
+          static const unsigned int max_points_per_leaf = 32;
+
+          /**
+           * The data stored for every node of the tree.
+           */
+          struct Node
+          {
+            Point<dim> center;
+            double size;
+            double mass;
+            Tensor<1,dim> dipole;
+            double anomaly_mass;
+            Tensor<1,dim> anomaly_dipole;
+            unsigned int begin;
+            unsigned int end;
+            unsigned int first_child;
+            unsigned int n_children;
+          };
+
+          /**
+           * Recursively fill the node with index @p node_index with the
+           * points in the range [begin, end) of @p permutation.
+           */
+          void build (const unsigned int node_index,
+                      const unsigned int begin,
+                      const unsigned int end,
+                      const unsigned int level,
+                      const std::vector<Point<dim> > &positions,
+                      std::vector<unsigned int> &permutation);
+
+          /**
+           * Add the contributions of all points in the range [begin, end)
+           * by direct summation.
+           */
+          void
+          evaluate_near_field (const Point<dim> &position_satellite,
+                               const unsigned int begin,
+                               const unsigned int end,
+                               Tensor<1,dim> &g,
+                               Tensor<1,dim> &g_anomaly,
+                               Tensor<2,dim> &g_gradient,
+                               double &g_potential) const;
+
+          /**
+           * Add the contribution of all points in a node using the multipole
+           * expansion of the node.
+           */
+          void
+          evaluate_far_field (const Point<dim> &position_satellite,
+                              const Node &node,
+                              Tensor<1,dim> &g,
+                              Tensor<1,dim> &g_anomaly,
+                              Tensor<2,dim> &g_gradient,
+                              double &g_potential) const;
+
+          std::vector<Node> nodes;
+
+          /**
+           * The coordinates, masses and mass anomalies of all points, sorted
+           * such that the points of every node are stored contiguously. The
+           * coordinates are stored component by component so that the near
+           * field loop can be vectorized by the compiler.
+           */
+          std::array<std::vector<double>,dim> coordinates;
+          std::vector<double> sorted_masses;
+          std::vector<double> sorted_anomaly_masses;
+      };
+
+
+
+      template <int dim>
+      GravityTree<dim>::GravityTree (const std::vector<Point<dim> > &positions,
+                                     const std::vector<double> &masses,
+                                     const std::vector<double> &anomaly_masses)
+      {
+        Assert (positions.size() == masses.size(), ExcInternalError());
+        Assert (positions.size() == anomaly_masses.size(), ExcInternalError());
+
+        if (positions.size() == 0)
+          return;
+
+        std::vector<unsigned int> permutation (positions.size());
+        for (unsigned int i=0; i<permutation.size(); ++i)
+          permutation[i] = i;
+
+        nodes.emplace_back();
+        build (0, 0, positions.size(), 0, positions, permutation);
+
+        // Store the point data in the order of the tree
+        for (unsigned int d=0; d<dim; ++d)
+          coordinates[d].resize(positions.size());
+        sorted_masses.resize(positions.size());
+        sorted_anomaly_masses.resize(positions.size());
+
+        for (unsigned int i=0; i<permutation.size(); ++i)
+          {
+            for (unsigned int d=0; d<dim; ++d)
+              coordinates[d][i] = positions[permutation[i]][d];
+            sorted_masses[i] = masses[permutation[i]];
+            sorted_anomaly_masses[i] = anomaly_masses[permutation[i]];
+          }
+
+        // Now compute the moments of all nodes. Children are always stored
+        // after their parents, so a reverse loop visits all children before
+        // their parent.
+        for (unsigned int n=nodes.size(); n>0; --n)
+          {
+            Node &node = nodes[n-1];
+            node.mass = 0;
+            node.anomaly_mass = 0;
+            node.dipole = Tensor<1,dim>();
+            node.anomaly_dipole = Tensor<1,dim>();
+
+            if (node.n_children == 0)
+              for (unsigned int i=node.begin; i<node.end; ++i)
+                {
+                  Tensor<1,dim> offset;
+                  for (unsigned int d=0; d<dim; ++d)
+                    offset[d] = coordinates[d][i] - node.center[d];
+
+                  node.mass += sorted_masses[i];
+                  node.dipole += sorted_masses[i] * offset;
+                  node.anomaly_mass += sorted_anomaly_masses[i];
+                  node.anomaly_dipole += sorted_anomaly_masses[i] * offset;
+                }
+            else
+              for (unsigned int c=node.first_child; c<node.first_child+node.n_children; ++c)
+                {
+                  // shift the moments of the child to the center of this node
+                  const Tensor<1,dim> offset = nodes[c].center - node.center;
+                  node.mass += nodes[c].mass;
+                  node.dipole += nodes[c].dipole + nodes[c].mass * offset;
+                  node.anomaly_mass += nodes[c].anomaly_mass;
+                  node.anomaly_dipole += nodes[c].anomaly_dipole + nodes[c].anomaly_mass * offset;
+                }
+          }
+      }
+
+
+
+      template <int dim>
+      void
+      GravityTree<dim>::build (const unsigned int node_index,
+                               const unsigned int begin,
+                               const unsigned int end,
+                               const unsigned int level,
+                               const std::vector<Point<dim> > &positions,
+                               std::vector<unsigned int> &permutation)
+      {
+        // Determine the bounding box of the points in this node
+        Point<dim> lower_left = positions[permutation[begin]];
+        Point<dim> upper_right = positions[permutation[begin]];
+        for (unsigned int i=begin; i<end; ++i)
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              lower_left[d] = std::min(lower_left[d], positions[permutation[i]][d]);
+              upper_right[d] = std::max(upper_right[d], positions[permutation[i]][d]);
+            }
+
+        const Point<dim> center = 0.5 * (lower_left + upper_right);
+
+        nodes[node_index].center = center;
+        nodes[node_index].size = lower_left.distance(upper_right);
+        nodes[node_index].begin = begin;
+        nodes[node_index].end = end;
+        nodes[node_index].first_child = numbers::invalid_unsigned_int;
+        nodes[node_index].n_children = 0;
+
+        // Stop if there are few enough points in this node. The limit on
+        // the number of levels guards against many points at the same
+        // location.
+        if (end - begin <= max_points_per_leaf || level >= 32
+            || nodes[node_index].size == 0.)
+          return;
+
+        // Sort the points of this node into the 2^dim children by the
+        // position relative to the center of the bounding box
+        const unsigned int n_octants = 1 << dim;
+        std::vector<unsigned int> octant (end - begin);
+        std::vector<unsigned int> n_points_in_octant (n_octants, 0);
+        for (unsigned int i=begin; i<end; ++i)
+          {
+            unsigned int o = 0;
+            for (unsigned int d=0; d<dim; ++d)
+              if (positions[permutation[i]][d] > center[d])
+                o |= (1 << d);
+            octant[i-begin] = o;
+            ++n_points_in_octant[o];
+          }
+
+        std::vector<unsigned int> octant_begin (n_octants+1, begin);
+        for (unsigned int o=0; o<n_octants; ++o)
+          octant_begin[o+1] = octant_begin[o] + n_points_in_octant[o];
+
+        const std::vector<unsigned int> old_permutation (permutation.begin()+begin,
+                                                         permutation.begin()+end);
+        std::vector<unsigned int> next_index (octant_begin.begin(), octant_begin.end()-1);
+        for (unsigned int i=0; i<old_permutation.size(); ++i)
+          permutation[next_index[octant[i]]++] = old_permutation[i];
+
+        // Create all non-empty children contiguously, then fill them. Note
+        // that 'nodes' may be reallocated during the recursion, so we must
+        // not hold references into it.
+        unsigned int n_children = 0;
+        for (unsigned int o=0; o<n_octants; ++o)
+          if (n_points_in_octant[o] > 0)
+            ++n_children;
+
+        const unsigned int first_child = nodes.size();
+        nodes[node_index].first_child = first_child;
+        nodes[node_index].n_children = n_children;
+        nodes.resize(nodes.size() + n_children);
+
+        unsigned int child = first_child;
+        for (unsigned int o=0; o<n_octants; ++o)
+          if (n_points_in_octant[o] > 0)
+            {
+              build (child, octant_begin[o], octant_begin[o+1], level+1, positions, permutation);
+              ++child;
+            }
+      }
+
+
+
+      template <int dim>
+      void
+      GravityTree<dim>::evaluate (const Point<dim> &position_satellite,
+                                  const double opening_angle,
+                                  Tensor<1,dim> &g,
+                                  Tensor<1,dim> &g_anomaly,
+                                  Tensor<2,dim> &g_gradient,
+                                  double &g_potential) const
+      {
+        if (nodes.size() == 0)
+          return;
+
+        std::vector<unsigned int> stack (1, 0);
+        while (stack.size() > 0)
+          {
+            const Node &node = nodes[stack.back()];
+            stack.pop_back();
+
+            const double distance = position_satellite.distance(node.center);
+            if (node.size < opening_angle * distance)
+              evaluate_far_field (position_satellite, node, g, g_anomaly, g_gradient, g_potential);
+            else if (node.n_children == 0)
+              evaluate_near_field (position_satellite, node.begin, node.end, g, g_anomaly, g_gradient, g_potential);
+            else
+              for (unsigned int c=node.first_child; c<node.first_child+node.n_children; ++c)
+                stack.push_back(c);
+          }
+      }
+
+
+
+      template <int dim>
+      void
+      GravityTree<dim>::evaluate_near_field (const Point<dim> &position_satellite,
+                                             const unsigned int begin,
+                                             const unsigned int end,
+                                             Tensor<1,dim> &g,
+                                             Tensor<1,dim> &g_anomaly,
+                                             Tensor<2,dim> &g_gradient,
+                                             double &g_potential) const
+      {
+        const double G = aspect::constants::big_g;
+
+        // Accumulate into plain arrays so that the loop over points can
+        // be vectorized
+        double local_g[dim] = {};
+        double local_g_anomaly[dim] = {};
+        double local_g_gradient[dim][dim] = {};
+        double local_g_potential = 0;
+
+        for (unsigned int i=begin; i<end; ++i)
+          {
+            double r[dim];
+            double r_square = 0;
+            for (unsigned int d=0; d<dim; ++d)
+              {
+                r[d] = position_satellite[d] - coordinates[d][i];
+                r_square += r[d] * r[d];
+              }
+
+            const double inverse_r = 1. / std::sqrt(r_square);
+            const double inverse_r3 = inverse_r * inverse_r * inverse_r;
+            const double inverse_r5 = inverse_r3 * inverse_r * inverse_r;
+
+            const double KK = - G * sorted_masses[i] * inverse_r3;
+            const double KK_anomalies = - G * sorted_anomaly_masses[i] * inverse_r3;
+            const double grad_KK = G * sorted_masses[i] * inverse_r5;
+
+            for (unsigned int d=0; d<dim; ++d)
+              {
+                local_g[d] += KK * r[d];
+                local_g_anomaly[d] += KK_anomalies * r[d];
+              }
+            local_g_potential -= G * sorted_masses[i] * inverse_r;
+
+            for (unsigned int d=0; d<dim; ++d)
+              for (unsigned int e=d; e<dim; ++e)
+                local_g_gradient[d][e] += grad_KK * (3.0 * r[d] * r[e] - (d == e ? r_square : 0.));
+          }
+
+        for (unsigned int d=0; d<dim; ++d)
+          {
+            g[d] += local_g[d];
+            g_anomaly[d] += local_g_anomaly[d];
+            for (unsigned int e=d; e<dim; ++e)
+              g_gradient[d][e] += local_g_gradient[d][e];
+          }
+        g_potential += local_g_potential;
+      }
+
+
+
+      template <int dim>
+      void
+      GravityTree<dim>::evaluate_far_field (const Point<dim> &position_satellite,
+                                            const Node &node,
+                                            Tensor<1,dim> &g,
+                                            Tensor<1,dim> &g_anomaly,
+                                            Tensor<2,dim> &g_gradient,
+                                            double &g_potential) const
+      {
+        const double G = aspect::constants::big_g;
+
+        // Expand the field of a point mass m at position c+delta around
+        // the center c of the node up to first order in delta, where
+        // R=satellite-c. Summing over all points in the node replaces m by
+        // the node mass M and m*delta by the dipole moment D.
+        const Tensor<1,dim> R = position_satellite - node.center;
+        const double R_square = R.norm_square();
+        const double inverse_R = 1. / std::sqrt(R_square);
+        const double inverse_R3 = inverse_R * inverse_R * inverse_R;
+        const double inverse_R5 = inverse_R3 * inverse_R * inverse_R;
+        const double inverse_R7 = inverse_R5 * inverse_R * inverse_R;
+
+        const double R_dot_D = R * node.dipole;
+        const double R_dot_D_anomaly = R * node.anomaly_dipole;
+
+        g_potential -= G * (node.mass * inverse_R + R_dot_D * inverse_R3);
+
+        g -= G * (node.mass * inverse_R3 * R
+                  - inverse_R3 * node.dipole
+                  + 3. * R_dot_D * inverse_R5 * R);
+        g_anomaly -= G * (node.anomaly_mass * inverse_R3 * R
+                          - inverse_R3 * node.anomaly_dipole
+                          + 3. * R_dot_D_anomaly * inverse_R5 * R);
+
+        for (unsigned int d=0; d<dim; ++d)
+          for (unsigned int e=d; e<dim; ++e)
+            {
+              const double delta_de = (d == e ? 1. : 0.);
+              const double monopole = (3. * R[d] * R[e] - R_square * delta_de) * inverse_R5;
+              const double dipole = (3. * (node.dipole[d] * R[e] + R[d] * node.dipole[e])
+                                     - 2. * R_dot_D * delta_de) * inverse_R5
+                                    - 5. * R_dot_D * (3. * R[d] * R[e] - R_square * delta_de) * inverse_R7;
+              g_gradient[d][e] += G * (node.mass * monopole - dipole);
+            }
+      }
+    }
+
+
 
     template <int dim>
     GravityPointValues<dim>::GravityPointValues ()
@@ -100,13 +516,13 @@ namespace aspect
       const unsigned int degree = this->get_fe().base_element(this->introspection().base_elements.velocities).degree
                                   + quadrature_degree_increase;
       const QGauss<dim> quadrature_formula (degree);
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_gradients |
-                               update_quadrature_points |
-                               update_JxW_values);
+      const std::shared_ptr<CellEvaluationScratch<dim> > scratch
+        = this->borrow_cell_evaluation_scratch (quadrature_formula,
+                                                update_values   |
+                                                update_gradients |
+                                                update_quadrature_points |
+                                                update_JxW_values);
+      FEValues<dim> &fe_values = scratch->fe_values;
 
       // Get the value of the outer radius and inner radius:
       double model_outer_radius;
@@ -157,8 +573,8 @@ namespace aspect
 
       // The following loop perform the storage of the position and density * JxW values
       // at local quadrature points:
-      MaterialModel::MaterialModelInputs<dim> in(quadrature_formula.size(),this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<dim> out(quadrature_formula.size(),this->n_compositional_fields());
+      MaterialModel::MaterialModelInputs<dim> &in = scratch->material_model_inputs;
+      MaterialModel::MaterialModelOutputs<dim> &out = scratch->material_model_outputs;
       unsigned int local_cell_number = 0;
       for (const auto &cell : this->get_dof_handler().active_cell_iterators())
         if (cell->is_locally_owned())
@@ -289,77 +705,132 @@ namespace aspect
                  << '\n';
         }
 
-      // This is the main loop which computes gravity acceleration, potential and
-      // gradients at a point located at the spherical coordinate [r, phi, theta].
-      // This loop corresponds to the 3 integrals of Newton law:
-      double sum_g = 0;
-      double min_g = std::numeric_limits<double>::max();
-      double max_g = -std::numeric_limits<double>::max();
-      double sum_g_potential = 0;
-      double min_g_potential = std::numeric_limits<double>::max();
-      double max_g_potential = -std::numeric_limits<double>::max();
+      // Convert the spherical coordinates of all satellites into cartesian
+      // coordinates to allow simplification in the mathematical equation.
+      std::vector<Point<dim> > positions_satellite (n_satellites);
       for (unsigned int p=0; p < n_satellites; ++p)
         {
-
-          // The spherical coordinates are shifted into cartesian to allow simplification
-          // in the mathematical equation.
           std::array<double,dim> satellite_point_coordinate;
           satellite_point_coordinate[0] = satellites_coordinate[p][0];
           satellite_point_coordinate[1] = satellites_coordinate[p][1];
           satellite_point_coordinate[2] = satellites_coordinate[p][2];
-          const Point<dim> position_satellite = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(satellite_point_coordinate);
+          positions_satellite[p] = Utilities::Coordinates::spherical_to_cartesian_coordinates<dim>(satellite_point_coordinate);
+        }
+
+      // This is the main loop which computes the local contributions to the gravity
+      // acceleration, potential and gradients at all satellites. The results for all
+      // satellites are stored in one vector, so that they can be summed over all
+      // processes in a single collective operation. For every satellite we store the
+      // gravity vector, the gravity anomaly vector, the gravity gradient tensor and
+      // the gravity potential.
+      const unsigned int n_values_per_satellite = dim + dim + dim*dim + 1;
+      std::vector<double> local_values (n_satellites * n_values_per_satellite, 0.);
+
+      std::unique_ptr<internal::GravityTree<dim> > tree;
+      if (evaluation_method == tree_code)
+        tree = std_cxx14::make_unique<internal::GravityTree<dim> > (position_point,
+                                                                    density_JxW,
+                                                                    density_anomalies_JxW);
+
+      for (unsigned int p=0; p < n_satellites; ++p)
+        {
+          const Point<dim> &position_satellite = positions_satellite[p];
 
-          // For each point (i.e. satellite), the fourth integral goes over cells and
-          // quadrature points to get the unique distance between those, to calculate
-          // gravity vector components x,y,z (in tensor), potential and gradients.
           Tensor<1,dim> local_g;
           Tensor<1,dim> local_g_anomaly;
           Tensor<2,dim> local_g_gradient;
           double local_g_potential = 0;
-          local_cell_number = 0;
-          for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-            if (cell->is_locally_owned())
-              {
-                for (unsigned int q = 0; q < n_quadrature_points_per_cell; ++q)
+
+          if (evaluation_method == tree_code)
+            {
+              // Approximate the contribution of distant groups of quadrature points
+              // by their multipole expansion:
+              tree->evaluate (position_satellite, opening_angle,
+                              local_g, local_g_anomaly, local_g_gradient, local_g_potential);
+            }
+          else
+            {
+              // For each point (i.e. satellite), the fourth integral goes over cells and
+              // quadrature points to get the unique distance between those, to calculate
+              // gravity vector components x,y,z (in tensor), potential and gradients.
+              local_cell_number = 0;
+              for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+                if (cell->is_locally_owned())
                   {
-                    const double dist = (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]).norm();
-                    // For gravity acceleration:
-                    const double KK = - G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,3);
-                    local_g += KK * (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]);
-                    // For gravity anomalies:
-                    const double KK_anomalies = - G * density_anomalies_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,3);
-                    local_g_anomaly += KK_anomalies * (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]);
-                    // For gravity potential:
-                    local_g_potential -= G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / dist;
-                    // For gravity gradient:
-                    const double grad_KK = G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,5);
-                    local_g_gradient[0][0] += grad_KK * (3.0
-                                                         * std::pow((position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0]),2)
-                                                         - std::pow(dist,2));
-                    local_g_gradient[1][1] += grad_KK * (3.0
-                                                         * std::pow((position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1]),2)
-                                                         - std::pow(dist,2));
-                    local_g_gradient[2][2] += grad_KK * (3.0
-                                                         * std::pow((position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]),2)
-                                                         - std::pow(dist,2));
-                    local_g_gradient[0][1] += grad_KK * (3.0
-                                                         * (position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0])
-                                                         * (position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1]));
-                    local_g_gradient[0][2] += grad_KK * (3.0
-                                                         * (position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0])
-                                                         * (position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]));
-                    local_g_gradient[1][2] += grad_KK * (3.0
-                                                         * (position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1])
-                                                         * (position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]));
+                    for (unsigned int q = 0; q < n_quadrature_points_per_cell; ++q)
+                      {
+                        const double dist = (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]).norm();
+                        // For gravity acceleration:
+                        const double KK = - G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,3);
+                        local_g += KK * (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]);
+                        // For gravity anomalies:
+                        const double KK_anomalies = - G * density_anomalies_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,3);
+                        local_g_anomaly += KK_anomalies * (position_satellite - position_point[local_cell_number * n_quadrature_points_per_cell + q]);
+                        // For gravity potential:
+                        local_g_potential -= G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / dist;
+                        // For gravity gradient:
+                        const double grad_KK = G * density_JxW[local_cell_number * n_quadrature_points_per_cell + q] / std::pow(dist,5);
+                        local_g_gradient[0][0] += grad_KK * (3.0
+                                                             * std::pow((position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0]),2)
+                                                             - std::pow(dist,2));
+                        local_g_gradient[1][1] += grad_KK * (3.0
+                                                             * std::pow((position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1]),2)
+                                                             - std::pow(dist,2));
+                        local_g_gradient[2][2] += grad_KK * (3.0
+                                                             * std::pow((position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]),2)
+                                                             - std::pow(dist,2));
+                        local_g_gradient[0][1] += grad_KK * (3.0
+                                                             * (position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0])
+                                                             * (position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1]));
+                        local_g_gradient[0][2] += grad_KK * (3.0
+                                                             * (position_satellite[0] - position_point[local_cell_number * n_quadrature_points_per_cell + q][0])
+                                                             * (position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]));
+                        local_g_gradient[1][2] += grad_KK * (3.0
+                                                             * (position_satellite[1] - position_point[local_cell_number * n_quadrature_points_per_cell + q][1])
+                                                             * (position_satellite[2] - position_point[local_cell_number * n_quadrature_points_per_cell + q][2]));
+                      }
+                    ++local_cell_number;
                   }
-                ++local_cell_number;
-              }
+            }
+
+          double *values = &local_values[p * n_values_per_satellite];
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              values[d] = local_g[d];
+              values[dim+d] = local_g_anomaly[d];
+              for (unsigned int e=0; e<dim; ++e)
+                values[2*dim+d*dim+e] = local_g_gradient[d][e];
+            }
+          values[2*dim+dim*dim] = local_g_potential;
+        }
 
-          // Sum local gravity components over global domain:
-          const Tensor<1,dim> g          = Utilities::MPI::sum (local_g, this->get_mpi_communicator());
-          const Tensor<1,dim> g_anomaly  = Utilities::MPI::sum (local_g_anomaly, this->get_mpi_communicator());
-          const Tensor<2,dim> g_gradient = Utilities::MPI::sum (local_g_gradient, this->get_mpi_communicator());
-          const double g_potential       = Utilities::MPI::sum (local_g_potential, this->get_mpi_communicator());
+      // Sum local gravity components over global domain:
+      std::vector<double> global_values (local_values.size());
+      Utilities::MPI::sum (local_values, this->get_mpi_communicator(), global_values);
+
+      // Now compute the statistics and write the output for every satellite.
+      double sum_g = 0;
+      double min_g = std::numeric_limits<double>::max();
+      double max_g = -std::numeric_limits<double>::max();
+      double sum_g_potential = 0;
+      double min_g_potential = std::numeric_limits<double>::max();
+      double max_g_potential = -std::numeric_limits<double>::max();
+      for (unsigned int p=0; p < n_satellites; ++p)
+        {
+          const Point<dim> &position_satellite = positions_satellite[p];
+
+          const double *values = &global_values[p * n_values_per_satellite];
+          Tensor<1,dim> g;
+          Tensor<1,dim> g_anomaly;
+          Tensor<2,dim> g_gradient;
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              g[d] = values[d];
+              g_anomaly[d] = values[dim+d];
+              for (unsigned int e=0; e<dim; ++e)
+                g_gradient[d][e] = values[2*dim+d*dim+e];
+            }
+          const double g_potential = values[2*dim+dim*dim];
 
           // sum gravity components for all n_satellites:
           sum_g += g.norm();
@@ -513,6 +984,31 @@ namespace aspect
                              "spiral sampling scheme produces a uniformly distributed map "
                              "on the surface of sphere defined by a minimum and/or "
                              "maximum radius.");
+          prm.declare_entry ("Evaluation method", "direct sum",
+                             Patterns::Selection ("direct sum|tree code"),
+                             "Choose how the gravity field at the satellite points is "
+                             "computed from the density at the quadrature points of the "
+                             "mesh. The `direct sum' method adds the contribution of every "
+                             "quadrature point to every satellite, and its cost is "
+                             "therefore proportional to the product of the number of "
+                             "satellites and the number of quadrature points. The `tree "
+                             "code' method sorts the quadrature points into a tree of "
+                             "nested boxes, and approximates the contribution of boxes that "
+                             "are far away from a satellite by a multipole expansion "
+                             "(monopole and dipole) about the center of the box. Its cost "
+                             "grows only logarithmically with the number of quadrature "
+                             "points per satellite. The accuracy of the tree code is "
+                             "controlled by the `Tree code opening angle' parameter.");
+          prm.declare_entry ("Tree code opening angle", "0.3",
+                             Patterns::Double (0.0, 1.0),
+                             "Parameter for the tree code evaluation method: "
+                             "A box of quadrature points is approximated by its multipole "
+                             "expansion if the ratio of the size of the box and its "
+                             "distance to the satellite is smaller than this value. The "
+                             "relative error of the approximation scales approximately "
+                             "with the square of this value. Smaller values are therefore "
+                             "more accurate, but more expensive. A value of zero "
+                             "reproduces the direct sum.");
           prm.declare_entry ("Number points fibonacci spiral", "200",
                              Patterns::Integer (0),
                              "Parameter for the fibonacci spiral sampling scheme: "
@@ -643,6 +1139,13 @@ namespace aspect
             sampling_scheme = fibonacci_spiral;
           else
             AssertThrow (false, ExcMessage ("Not a valid sampling scheme."));
+          if (prm.get ("Evaluation method") == "direct sum")
+            evaluation_method = direct_sum;
+          else if (prm.get ("Evaluation method") == "tree code")
+            evaluation_method = tree_code;
+          else
+            AssertThrow (false, ExcMessage ("Not a valid evaluation method."));
+          opening_angle = prm.get_double ("Tree code opening angle");
           quadrature_degree_increase = prm.get_integer ("Quadrature degree increase");
           n_points_spiral     = prm.get_integer("Number points fibonacci spiral");
           n_points_radius     = prm.get_integer("Number points radius");
@@ -770,6 +1273,11 @@ namespace aspect
                                   "gravity on the map. Another way is to directly use density anomalies for this "
                                   "postprocessor."
                                   "The average- minimum- and maximum gravity acceleration and potential are "
-                                  "written into the statistics file.")
+                                  "written into the statistics file. "
+                                  "\n\n"
+                                  "For large numbers of satellites and quadrature points, the "
+                                  "`tree code' evaluation method is considerably faster than "
+                                  "the default direct summation at the cost of a small, "
+                                  "user-controlled approximation error.")
   }
 }
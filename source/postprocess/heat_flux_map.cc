@@ -26,6 +26,7 @@
 #include <aspect/boundary_temperature/interface.h>
 #include <aspect/boundary_heat_flux/interface.h>
 #include <aspect/boundary_velocity/interface.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -52,14 +53,17 @@ namespace aspect
         const QGaussLobatto<dim-1> quadrature_formula_face(quadrature_degree);
 
         // The CBF method involves both boundary and volume integrals on the
-        // cells at the boundary. Construct FEValues objects for each of these integrations.
-        FEValues<dim> fe_volume_values (simulator_access.get_mapping(),
-                                        simulator_access.get_fe(),
-                                        quadrature_formula,
-                                        update_values |
-                                        update_gradients |
-                                        update_quadrature_points |
-                                        update_JxW_values);
+        // cells at the boundary. Borrow the FEValues object and the material
+        // model inputs and outputs for the volume integrals from the pool of
+        // the simulator, and construct an FEFaceValues object for the face
+        // integrals (these are not pooled).
+        const std::shared_ptr<CellEvaluationScratch<dim> > scratch
+          = simulator_access.borrow_cell_evaluation_scratch (quadrature_formula,
+                                                             update_values |
+                                                             update_gradients |
+                                                             update_quadrature_points |
+                                                             update_JxW_values);
+        FEValues<dim> &fe_volume_values = scratch->fe_values;
 
         FEFaceValues<dim> fe_face_values (simulator_access.get_mapping(),
                                           simulator_access.get_fe(),
@@ -93,10 +97,8 @@ namespace aspect
         distributed_heat_flux_vector = 0.;
         heat_flux_vector = 0.;
 
-        typename MaterialModel::Interface<dim>::MaterialModelInputs
-        in(fe_volume_values.n_quadrature_points, simulator_access.n_compositional_fields());
-        typename MaterialModel::Interface<dim>::MaterialModelOutputs
-        out(fe_volume_values.n_quadrature_points, simulator_access.n_compositional_fields());
+        MaterialModel::MaterialModelInputs<dim> &in = scratch->material_model_inputs;
+        MaterialModel::MaterialModelOutputs<dim> &out = scratch->material_model_outputs;
 
         HeatingModel::HeatingModelOutputs
         heating_out(fe_volume_values.n_quadrature_points, simulator_access.n_compositional_fields());
@@ -34,10 +34,17 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    HeatFluxStatistics<dim>::execute (TableHandler &statistics)
+    void
+    HeatFluxStatistics<dim>::compute_local_contributions (CellSweep<dim> &,
+                                                          ReductionBuffer &reductions)
     {
-      std::vector<std::vector<std::pair<double, double> > > heat_flux_and_area =
+      // The heat flux through Dirichlet boundaries is computed with the
+      // consistent boundary flux method, which needs its own loops over the
+      // boundary cells and a global solve. It can therefore not be split into
+      // a kernel for the common cell sweep, but the reduction of the fluxes
+      // over all processors can be done together with those of the other
+      // postprocessors.
+      const std::vector<std::vector<std::pair<double, double> > > heat_flux_and_area =
         internal::compute_heat_flux_through_boundary_faces (*this);
 
       std::map<types::boundary_id, double> local_boundary_fluxes;
@@ -52,29 +59,41 @@ namespace aspect
                 local_boundary_fluxes[boundary_indicator] += heat_flux_and_area[cell->active_cell_index()][f].first;
               }
 
-      // now communicate to get the global values
+      // collect local values in the same order in which they are listed
+      // in the set of boundary indicators, which is the same on all
+      // processors
+      const std::set<types::boundary_id>
+      boundary_indicators
+        = this->get_geometry_model().get_used_boundary_indicators ();
+      boundary_fluxes.clear();
+      boundary_fluxes.reserve(boundary_indicators.size());
+      for (const auto p : boundary_indicators)
+        boundary_fluxes.emplace_back (local_boundary_fluxes[p]);
+
+      reductions.add_sum (boundary_fluxes);
+    }
+
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    HeatFluxStatistics<dim>::execute (TableHandler &statistics)
+    {
+      // the global values were computed in compute_local_contributions().
+      // take them apart into a map from boundary indicator to flux
       std::map<types::boundary_id, double> global_boundary_fluxes;
       {
-        // first collect local values in the same order in which they are listed
-        // in the set of boundary indicators
         const std::set<types::boundary_id>
         boundary_indicators
           = this->get_geometry_model().get_used_boundary_indicators ();
-        std::vector<double> local_values;
-        local_values.reserve(boundary_indicators.size());
-        for (const auto p : boundary_indicators)
-          local_values.emplace_back (local_boundary_fluxes[p]);
-
-        // then collect contributions from all processors
-        std::vector<double> global_values (local_values.size());
-        Utilities::MPI::sum (local_values, this->get_mpi_communicator(), global_values);
+        Assert (boundary_indicators.size() == boundary_fluxes.size(),
+                ExcInternalError());
 
-        // and now take them apart into the global map again
         unsigned int index = 0;
         for (std::set<types::boundary_id>::const_iterator
              p = boundary_indicators.begin();
              p != boundary_indicators.end(); ++p, ++index)
-          global_boundary_fluxes[*p] = global_values[index];
+          global_boundary_fluxes[*p] = boundary_fluxes[index];
       }
 
       // now add all of the computed heat fluxes to the statistics object
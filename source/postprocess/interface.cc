@@ -22,6 +22,8 @@
 #include <aspect/postprocess/interface.h>
 #include <aspect/utilities.h>
 
+#include <deal.II/base/timer.h>
+
 #include <typeinfo>
 
 
@@ -58,6 +60,14 @@ namespace aspect
 
 
 
+    template <int dim>
+    void
+    Interface<dim>::compute_local_contributions (CellSweep<dim> &,
+                                                 ReductionBuffer &)
+    {}
+
+
+
     template <int dim>
     void
     Interface<dim>::parse_parameters (ParameterHandler &)
@@ -88,9 +98,204 @@ namespace aspect
 
 
 
+// ------------------------------ ReductionBuffer -----------------------------
+
+
+    void
+    ReductionBuffer::add_sum (double &value)
+    {
+      sum_values.push_back (&value);
+    }
+
+
+
+    void
+    ReductionBuffer::add_max (double &value)
+    {
+      max_values.push_back (&value);
+    }
+
+
+
+    void
+    ReductionBuffer::add_min (double &value)
+    {
+      min_values.push_back (&value);
+    }
+
+
+
+    void
+    ReductionBuffer::add_sum (std::vector<double> &values)
+    {
+      for (double &value : values)
+        add_sum (value);
+    }
+
+
+
+    void
+    ReductionBuffer::add_max (std::vector<double> &values)
+    {
+      for (double &value : values)
+        add_max (value);
+    }
+
+
+
+    void
+    ReductionBuffer::add_min (std::vector<double> &values)
+    {
+      for (double &value : values)
+        add_min (value);
+    }
+
+
+
+    void
+    ReductionBuffer::reduce (const MPI_Comm &mpi_communicator)
+    {
+      if (sum_values.size() > 0)
+        {
+          std::vector<double> local_values (sum_values.size());
+          for (unsigned int i=0; i<sum_values.size(); ++i)
+            local_values[i] = *sum_values[i];
+
+          std::vector<double> global_values (sum_values.size());
+          Utilities::MPI::sum (local_values, mpi_communicator, global_values);
+
+          for (unsigned int i=0; i<sum_values.size(); ++i)
+            *sum_values[i] = global_values[i];
+        }
+
+      // do the min and max operations in one communication by
+      // multiplying the values whose minimum we want by -1
+      if (max_values.size() + min_values.size() > 0)
+        {
+          std::vector<double> local_values (max_values.size() + min_values.size());
+          for (unsigned int i=0; i<max_values.size(); ++i)
+            local_values[i] = *max_values[i];
+          for (unsigned int i=0; i<min_values.size(); ++i)
+            local_values[max_values.size()+i] = -*min_values[i];
+
+          std::vector<double> global_values (local_values.size());
+          Utilities::MPI::max (local_values, mpi_communicator, global_values);
+
+          for (unsigned int i=0; i<max_values.size(); ++i)
+            *max_values[i] = global_values[i];
+          for (unsigned int i=0; i<min_values.size(); ++i)
+            *min_values[i] = -global_values[max_values.size()+i];
+        }
+
+      sum_values.clear();
+      max_values.clear();
+      min_values.clear();
+    }
+
+
+
+// ------------------------------ CellSweep -----------------------------
+
+
+    template <int dim>
+    CellSweep<dim>::CellSweep (const Mapping<dim> &mapping,
+                               const DoFHandler<dim> &dof_handler)
+      :
+      mapping (mapping),
+      dof_handler (dof_handler)
+    {}
+
+
+
+    template <int dim>
+    void
+    CellSweep<dim>::add_kernel (const Quadrature<dim> &quadrature,
+                                const UpdateFlags update_flags,
+                                const Kernel &kernel)
+    {
+      for (auto &group : kernel_groups)
+        if (group.quadrature == quadrature)
+          {
+            group.update_flags = group.update_flags | update_flags;
+            group.kernels.push_back (kernel);
+            return;
+          }
+
+      kernel_groups.push_back (KernelGroup {quadrature,
+                                            update_flags,
+                                            std::vector<Kernel> (1, kernel)
+                                           });
+    }
+
+
+
+    template <int dim>
+    void
+    CellSweep<dim>::execute ()
+    {
+      if (kernel_groups.size() == 0)
+        return;
+
+      std::vector<std::unique_ptr<FEValues<dim> > > fe_values;
+      for (const auto &group : kernel_groups)
+        fe_values.emplace_back (std_cxx14::make_unique<FEValues<dim> > (mapping,
+                                                                        dof_handler.get_fe(),
+                                                                        group.quadrature,
+                                                                        group.update_flags));
+
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          for (unsigned int g=0; g<kernel_groups.size(); ++g)
+            {
+              fe_values[g]->reinit (cell);
+              for (const auto &kernel : kernel_groups[g].kernels)
+                kernel (cell, *fe_values[g]);
+            }
+
+      kernel_groups.clear();
+    }
+
+
+
 // ------------------------------ Manager -----------------------------
 
 
+    namespace
+    {
+      /**
+       * Postprocessors that throw exceptions usually do not result in
+       * anything good because they result in an unwinding of the stack
+       * and, if only one processor triggers an exception, the
+       * destruction of objects often causes a deadlock. Thus, if an
+       * exception is generated by the postprocessor @p postprocessor,
+       * print the error message @p message that describes it and abort the
+       * program.
+       */
+      template <int dim>
+      void
+      abort_after_exception (const Interface<dim> &postprocessor,
+                             const std::string &message)
+      {
+        std::cerr << std::endl << std::endl
+                  << "----------------------------------------------------"
+                  << std::endl;
+        std::cerr << "Exception on MPI process <"
+                  << Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)
+                  << "> while running postprocessor <"
+                  << typeid(postprocessor).name()
+                  << ">: " << std::endl
+                  << message << std::endl
+                  << "Aborting!" << std::endl
+                  << "----------------------------------------------------"
+                  << std::endl;
+
+        // terminate the program!
+        MPI_Abort (MPI_COMM_WORLD, 1);
+      }
+    }
+
+
+
     template <int dim>
     std::list<std::pair<std::string,std::string> >
     Manager<dim>::execute (TableHandler &statistics)
@@ -98,10 +303,55 @@ namespace aspect
       // call the execute() functions of all postprocessor objects we have
       // here in turns
       std::list<std::pair<std::string,std::string> > output_list;
-      for (auto &p : postprocessors)
+
+      // if requested, time each postprocessor separately
+      const auto time_section = [&] (const std::string &section_name) -> std::unique_ptr<TimerOutput::Scope>
+      {
+        if (this->get_parameters().detailed_timing_output)
+          return std_cxx14::make_unique<TimerOutput::Scope> (this->get_computing_timer(),
+                                                             "Postprocessing: " + section_name);
+        else
+          return nullptr;
+      };
+
+      // first let all postprocessors compute those parts of their statistics
+      // that need to be reduced over all processors. do all of the loops
+      // over cells this requires in one sweep, and all reductions together
+      CellSweep<dim> cell_sweep (this->get_mapping(), this->get_dof_handler());
+      ReductionBuffer reductions;
+      for (unsigned int i=0; i<postprocessors.size(); ++i)
+        {
+          const std::unique_ptr<Interface<dim> > &p = postprocessors[i];
+          try
+            {
+              const std::unique_ptr<TimerOutput::Scope> timer_section = time_section (sorted_postprocessor_names[i]);
+              p->compute_local_contributions (cell_sweep, reductions);
+            }
+          catch (std::exception &exc)
+            {
+              abort_after_exception (*p, exc.what());
+            }
+          catch (...)
+            {
+              abort_after_exception (*p, "Unknown exception!");
+            }
+        }
+
+      // the kernels of all postprocessors are executed together, so their
+      // time can not be attributed to the individual postprocessors
+      {
+        const std::unique_ptr<TimerOutput::Scope> timer_section = time_section ("Cell sweep and reductions");
+        cell_sweep.execute ();
+        reductions.reduce (this->get_mpi_communicator());
+      }
+
+      for (unsigned int i=0; i<postprocessors.size(); ++i)
         {
+          const std::unique_ptr<Interface<dim> > &p = postprocessors[i];
           try
             {
+              const std::unique_ptr<TimerOutput::Scope> timer_section = time_section (sorted_postprocessor_names[i]);
+
               // first call the update() function.
               p->update();
 
@@ -113,47 +363,13 @@ namespace aspect
               if (output.first.size() + output.second.size() > 0)
                 output_list.push_back (output);
             }
-          // postprocessors that throw exceptions usually do not result in
-          // anything good because they result in an unwinding of the stack
-          // and, if only one processor triggers an exception, the
-          // destruction of objects often causes a deadlock. thus, if
-          // an exception is generated, catch it, print an error message,
-          // and abort the program
           catch (std::exception &exc)
             {
-              std::cerr << std::endl << std::endl
-                        << "----------------------------------------------------"
-                        << std::endl;
-              std::cerr << "Exception on MPI process <"
-                        << Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)
-                        << "> while running postprocessor <"
-                        << typeid(*p).name()
-                        << ">: " << std::endl
-                        << exc.what() << std::endl
-                        << "Aborting!" << std::endl
-                        << "----------------------------------------------------"
-                        << std::endl;
-
-              // terminate the program!
-              MPI_Abort (MPI_COMM_WORLD, 1);
+              abort_after_exception (*p, exc.what());
             }
           catch (...)
             {
-              std::cerr << std::endl << std::endl
-                        << "----------------------------------------------------"
-                        << std::endl;
-              std::cerr << "Exception on MPI process <"
-                        << Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)
-                        << "> while running postprocessor <"
-                        << typeid(*p).name()
-                        << ">: " << std::endl;
-              std::cerr << "Unknown exception!" << std::endl
-                        << "Aborting!" << std::endl
-                        << "----------------------------------------------------"
-                        << std::endl;
-
-              // terminate the program!
-              MPI_Abort (MPI_COMM_WORLD, 1);
+              abort_after_exception (*p, "Unknown exception!");
             }
         }
 
@@ -389,6 +605,7 @@ namespace aspect
       // finally swap the unsorted list with the sorted list and only
       // keep the latter
       postprocessors.swap (sorted_postprocessors);
+      sorted_postprocessor_names.swap (sorted_names);
     }
 
 
@@ -438,6 +655,7 @@ namespace aspect
   namespace Postprocess
   {
 #define INSTANTIATE(dim) \
+  template class CellSweep<dim>; \
   template class Interface<dim>; \
   template class Manager<dim>;
 
@@ -21,6 +21,7 @@
 
 #include <aspect/postprocess/material_statistics.h>
 #include <aspect/material_model/interface.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_values.h>
@@ -31,50 +32,66 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    MaterialStatistics<dim>::execute (TableHandler &statistics)
+    void
+    MaterialStatistics<dim>::compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                          ReductionBuffer &reductions)
     {
       // create a quadrature formula based on the temperature element alone.
       const QGauss<dim> quadrature_formula (this->get_fe().base_element(this->introspection().base_elements.temperature).degree+1);
-      const unsigned int n_q_points = quadrature_formula.size();
+      const UpdateFlags update_flags = update_values   |
+                                       update_gradients |
+                                       update_quadrature_points |
+                                       update_JxW_values;
+
+      // the kernel uses the FEValues object of the cell sweep, but the
+      // material model inputs and outputs of a borrowed scratch object.
+      // the scratch object is returned to the pool when the cell sweep
+      // releases the kernel
+      const std::shared_ptr<CellEvaluationScratch<dim> > scratch
+        = this->borrow_cell_evaluation_scratch (quadrature_formula,
+                                                update_flags);
+
+      mass = 0.0;
+      viscosity_integral = 0.0;
+      volume = 0.0;
 
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_gradients |
-                               update_quadrature_points |
-                               update_JxW_values);
+      // compute the integral quantities by quadrature
+      cell_sweep.add_kernel (quadrature_formula,
+                             update_flags,
+                             [this, scratch] (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                                              const FEValues<dim> &fe_values)
+      {
+        MaterialModel::MaterialModelInputs<dim> &in = scratch->material_model_inputs;
+        MaterialModel::MaterialModelOutputs<dim> &out = scratch->material_model_outputs;
 
-      MaterialModel::MaterialModelInputs<dim> in(fe_values.n_quadrature_points, this->n_compositional_fields());
-      MaterialModel::MaterialModelOutputs<dim> out(fe_values.n_quadrature_points, this->n_compositional_fields());
+        in.reinit(fe_values, cell, this->introspection(), this->get_solution());
 
-      double local_volume = 0.0;
-      double local_mass = 0.0;
-      double local_viscosity = 0.0;
+        this->get_material_model().fill_additional_material_model_inputs(in, this->get_solution(), fe_values, this->introspection());
+        this->get_material_model().evaluate(in, out);
 
-      // compute the integral quantities by quadrature
-      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-        if (cell->is_locally_owned())
+        for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
           {
-            fe_values.reinit (cell);
-            in.reinit(fe_values, cell, this->introspection(), this->get_solution());
-
-            this->get_material_model().fill_additional_material_model_inputs(in, this->get_solution(), fe_values, this->introspection());
-            this->get_material_model().evaluate(in, out);
-
-            for (unsigned int q=0; q<n_q_points; ++q)
-              {
-                local_mass += out.densities[q] * fe_values.JxW(q);
-                local_viscosity += out.viscosities[q] * fe_values.JxW(q);
-                local_volume += fe_values.JxW(q);
-              }
+            mass += out.densities[q] * fe_values.JxW(q);
+            viscosity_integral += out.viscosities[q] * fe_values.JxW(q);
+            volume += fe_values.JxW(q);
           }
+      });
+
+      reductions.add_sum (mass);
+      reductions.add_sum (viscosity_integral);
+      reductions.add_sum (volume);
+    }
 
-      // compute the sum over all processors
-      const double global_mass = Utilities::MPI::sum (local_mass, this->get_mpi_communicator());
-      const double global_viscosity = Utilities::MPI::sum (local_viscosity, this->get_mpi_communicator());
-      const double global_volume = Utilities::MPI::sum (local_volume, this->get_mpi_communicator());
+
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    MaterialStatistics<dim>::execute (TableHandler &statistics)
+    {
+      // the global values were computed in compute_local_contributions()
+      const double global_mass = mass;
+      const double global_viscosity = viscosity_integral;
+      const double global_volume = volume;
       const double average_density = global_mass / global_volume;
       const double average_viscosity = global_viscosity / global_volume;
 
@@ -24,7 +24,10 @@
 #include <aspect/geometry_model/sphere.h>
 #include <aspect/geometry_model/spherical_shell.h>
 #include <aspect/global.h>
-#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/numerics/rtree.h>
+
+#include <map>
 
 #include <math.h>
 
@@ -42,9 +45,191 @@ namespace aspect
       last_output_time (std::numeric_limits<double>::quiet_NaN()),
       evaluation_points_cartesian (std::vector<Point<dim> >() ),
       point_values (std::vector<std::pair<double, std::vector<Vector<double> > > >() ),
-      use_natural_coordinates (false)
+      use_natural_coordinates (false),
+      point_locations_valid (false)
     {}
 
+
+
+    template <int dim>
+    void
+    PointValues<dim>::initialize ()
+    {
+      // The cached point locations are only valid as long as the mesh does
+      // not change. Invalidate them whenever the triangulation is modified
+      // (refinement, coarsening, repartitioning) or the mesh is deformed.
+      this->get_triangulation().signals.any_change.connect(
+        [&]()
+      {
+        this->point_locations_valid = false;
+      });
+
+      this->get_signals().post_mesh_deformation.connect(
+        [&](const SimulatorAccess<dim> &)
+      {
+        this->point_locations_valid = false;
+      });
+    }
+
+
+
+    template <int dim>
+    void
+    PointValues<dim>::update_point_locations ()
+    {
+      cell_points.clear();
+
+      // Build an R-tree of the bounding boxes of all locally owned cells.
+      // The bounding boxes are computed from the mapped vertices of the
+      // cell, and are slightly enlarged to account for curved cells.
+      std::vector<std::pair<BoundingBox<dim>, typename DoFHandler<dim>::active_cell_iterator> > boxes;
+      boxes.reserve(this->get_triangulation().n_locally_owned_active_cells());
+
+      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            const auto vertices = this->get_mapping().get_vertices(cell);
+
+            Point<dim> lower_left = vertices[0];
+            Point<dim> upper_right = vertices[0];
+            for (const auto &vertex : vertices)
+              for (unsigned int d=0; d<dim; ++d)
+                {
+                  lower_left[d] = std::min(lower_left[d], vertex[d]);
+                  upper_right[d] = std::max(upper_right[d], vertex[d]);
+                }
+
+            const double tolerance = 0.1 * lower_left.distance(upper_right);
+            for (unsigned int d=0; d<dim; ++d)
+              {
+                lower_left[d] -= tolerance;
+                upper_right[d] += tolerance;
+              }
+
+            boxes.emplace_back(BoundingBox<dim>(std::make_pair(lower_left, upper_right)), cell);
+          }
+
+      const auto tree = pack_rtree(boxes);
+
+      // Now locate all points. For every point, only test the cells whose
+      // bounding box contains the point. A point may lie on the interface
+      // between several locally owned cells; in that case only the first
+      // cell that contains it is used.
+      std::map<typename DoFHandler<dim>::active_cell_iterator, unsigned int> cell_to_index;
+      std::vector<unsigned int> point_found_here (evaluation_points_cartesian.size(), 0);
+
+      std::vector<std::pair<BoundingBox<dim>, typename DoFHandler<dim>::active_cell_iterator> > candidates;
+      for (unsigned int p=0; p<evaluation_points_cartesian.size(); ++p)
+        {
+          candidates.clear();
+          tree.query(boost::geometry::index::intersects(evaluation_points_cartesian[p]),
+                     std::back_inserter(candidates));
+
+          for (const auto &candidate : candidates)
+            {
+              Point<dim> reference_point;
+              try
+                {
+                  reference_point = this->get_mapping().transform_real_to_unit_cell(candidate.second,
+                                                                                    evaluation_points_cartesian[p]);
+                }
+              catch (const typename Mapping<dim>::ExcTransformationFailed &)
+                {
+                  continue;
+                }
+
+              if (GeometryInfo<dim>::is_inside_unit_cell(reference_point, 1e-10))
+                {
+                  const auto it = cell_to_index.find(candidate.second);
+                  unsigned int index;
+                  if (it == cell_to_index.end())
+                    {
+                      index = cell_points.size();
+                      cell_to_index[candidate.second] = index;
+                      cell_points.emplace_back();
+                      cell_points.back().cell = candidate.second;
+                    }
+                  else
+                    index = it->second;
+
+                  cell_points[index].reference_points.push_back(reference_point);
+                  cell_points[index].point_indices.push_back(p);
+                  point_found_here[p] = 1;
+                  break;
+                }
+            }
+        }
+
+      // Determine how many processes found each of the points, using a single
+      // collective operation for all points.
+      n_processes_per_point.resize(evaluation_points_cartesian.size());
+      Utilities::MPI::sum (point_found_here, this->get_mpi_communicator(),
+                           n_processes_per_point);
+
+      // ensure that at least one processor found every point
+      for (unsigned int p=0; p<evaluation_points_cartesian.size(); ++p)
+        AssertThrow (n_processes_per_point[p] > 0,
+                     ExcMessage ("While trying to evaluate the solution at point " +
+                                 Utilities::to_string(evaluation_points_cartesian[p][0]) + ", " +
+                                 Utilities::to_string(evaluation_points_cartesian[p][1]) +
+                                 (dim == 3
+                                  ?
+                                  ", " + Utilities::to_string(evaluation_points_cartesian[p][2])
+                                  :
+                                  "") + "), " +
+                                 "no processors reported that the point lies inside the " +
+                                 "set of cells they own. Are you trying to evaluate the " +
+                                 "solution at a point that lies outside of the domain?"
+                                ));
+
+      point_locations_valid = true;
+    }
+
+
+
+    template <int dim>
+    std::vector<Vector<double> >
+    PointValues<dim>::evaluate_solution_at_points () const
+    {
+      Assert (point_locations_valid, ExcInternalError());
+
+      const unsigned int n_components = this->introspection().n_components;
+      const unsigned int n_points = evaluation_points_cartesian.size();
+
+      // Evaluate the solution cell by cell, and store the result in one
+      // contiguous vector so that it can be communicated at once.
+      std::vector<double> local_values (n_points * n_components, 0.);
+
+      for (const auto &cp : cell_points)
+        {
+          const Quadrature<dim> quadrature (cp.reference_points);
+          FEValues<dim> fe_values (this->get_mapping(),
+                                   this->get_fe(),
+                                   quadrature,
+                                   update_values);
+          fe_values.reinit (cp.cell);
+
+          std::vector<Vector<double> > values (quadrature.size(),
+                                               Vector<double> (n_components));
+          fe_values.get_function_values (this->get_solution(), values);
+
+          for (unsigned int q=0; q<quadrature.size(); ++q)
+            for (unsigned int c=0; c<n_components; ++c)
+              local_values[cp.point_indices[q] * n_components + c] = values[q][c];
+        }
+
+      std::vector<double> global_values (n_points * n_components);
+      Utilities::MPI::sum (local_values, this->get_mpi_communicator(), global_values);
+
+      // Normalize in cases where points are claimed by multiple processors
+      std::vector<Vector<double> > point_values (n_points, Vector<double> (n_components));
+      for (unsigned int p=0; p<n_points; ++p)
+        for (unsigned int c=0; c<n_components; ++c)
+          point_values[p][c] = global_values[p * n_components + c] / n_processes_per_point[p];
+
+      return point_values;
+    }
+
     template <int dim>
     std::pair<std::string,std::string>
     PointValues<dim>::execute (TableHandler &)
@@ -59,57 +244,14 @@ namespace aspect
       if (this->get_time() < last_output_time + output_interval)
         return std::pair<std::string,std::string>();
 
-      // evaluate the solution at all of our evaluation points
-      std::vector<Vector<double> >
-      current_point_values (evaluation_points_cartesian.size(),
-                            Vector<double> (this->introspection().n_components));
+      // evaluate the solution at all of our evaluation points. the
+      // location of the points in the mesh is cached and only
+      // recomputed if the mesh has changed since the last evaluation
+      if (point_locations_valid == false)
+        update_point_locations ();
 
-      for (unsigned int p=0; p<evaluation_points_cartesian.size(); ++p)
-        {
-          // try to evaluate the solution at this point. in parallel, the point
-          // will be on only one processor's owned cells, so the others are
-          // going to throw an exception. make sure at least one processor
-          // finds the given point
-          bool point_found = false;
-
-          try
-            {
-              VectorTools::point_value(this->get_mapping(),
-                                       this->get_dof_handler(),
-                                       this->get_solution(),
-                                       evaluation_points_cartesian[p],
-                                       current_point_values[p]);
-              point_found = true;
-            }
-          catch (const VectorTools::ExcPointNotAvailableHere &)
-            {
-              // ignore
-            }
-
-          // ensure that at least one processor found things
-          const int n_procs = Utilities::MPI::sum (point_found ? 1 : 0, this->get_mpi_communicator());
-          AssertThrow (n_procs > 0,
-                       ExcMessage ("While trying to evaluate the solution at point " +
-                                   Utilities::to_string(evaluation_points_cartesian[p][0]) + ", " +
-                                   Utilities::to_string(evaluation_points_cartesian[p][1]) +
-                                   (dim == 3
-                                    ?
-                                    ", " + Utilities::to_string(evaluation_points_cartesian[p][2])
-                                    :
-                                    "") + "), " +
-                                   "no processors reported that the point lies inside the " +
-                                   "set of cells they own. Are you trying to evaluate the " +
-                                   "solution at a point that lies outside of the domain?"
-                                  ));
-
-          // Reduce all collected values into local Vector
-          Utilities::MPI::sum (current_point_values[p], this->get_mpi_communicator(),
-                               current_point_values[p]);
-
-          // Normalize in cases where points are claimed by multiple processors
-          if (n_procs > 1)
-            current_point_values[p] /= n_procs;
-        }
+      const std::vector<Vector<double> > current_point_values
+        = evaluate_solution_at_points ();
 
       // finally push these point values all onto the list we keep
       point_values.emplace_back (this->get_time(), current_point_values);
@@ -307,6 +449,9 @@ namespace aspect
           aspect::iarchive ia (is);
           ia >> (*this);
         }
+
+      // the evaluation points may have changed
+      point_locations_valid = false;
     }
 
 
@@ -357,11 +502,16 @@ namespace aspect
                                   "to meters/year, instead of meters/second."
                                   "\n\n"
                                   "\\note{Evaluating the solution of a finite element field at "
-                                  "arbitrarily chosen points is an expensive process. Using this "
-                                  "postprocessor will only be efficient if the number of evaluation "
-                                  "points or output times is relatively small. If you need a very large number of "
-                                  "evaluation points, you should consider extracting this "
+                                  "arbitrarily chosen points requires finding the cells that "
+                                  "contain these points. This postprocessor locates all points "
+                                  "at once using a search tree of the locally owned cells, and "
+                                  "caches the result until the mesh changes (through mesh "
+                                  "refinement or mesh deformation). All point values are then "
+                                  "communicated in a single collective operation. Nevertheless, "
+                                  "since the values at all points and all output times are "
+                                  "written into a single text file, you should consider extracting this "
                                   "information from the visualization program you use to display "
-                                  "the output of the `visualization' postprocessor.}")
+                                  "the output of the `visualization' postprocessor if you need "
+                                  "a very large number of evaluation points.}")
   }
 }
@@ -30,8 +30,9 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    PressureStatistics<dim>::execute (TableHandler &statistics)
+    void
+    PressureStatistics<dim>::compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                          ReductionBuffer &reductions)
     {
       // create a quadrature formula based on the pressure element alone.
       // we need to compute max and min of the pressure as well, which
@@ -42,59 +43,50 @@ namespace aspect
       // in fact the support points.
       const QIterated<dim> quadrature_formula (QTrapez<1>(),
                                                this->get_fe().base_element(this->introspection().base_elements.pressure).degree);
-      const unsigned int n_q_points = quadrature_formula.size();
-
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_quadrature_points |
-                               update_JxW_values);
-
-      std::vector<double> pressure_values(n_q_points);
 
-      double local_pressure_integral = 0;
-      double local_min_pressure      = std::numeric_limits<double>::max();
-      double local_max_pressure      = -std::numeric_limits<double>::max();
+      pressure_integral = 0;
+      min_pressure      = std::numeric_limits<double>::max();
+      max_pressure      = -std::numeric_limits<double>::max();
 
       // compute the integral quantities by quadrature. note that compared to
       // the temperature statistics postprocessor, we can not just loop over
       // the pressure DoFs because they may be intermingled with the
       // velocity DoFs if we use a direct solver
-      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-        if (cell->is_locally_owned())
+      std::vector<double> pressure_values(quadrature_formula.size());
+      cell_sweep.add_kernel (quadrature_formula,
+                             update_values   |
+                             update_quadrature_points |
+                             update_JxW_values,
+                             [this, pressure_values] (const typename DoFHandler<dim>::active_cell_iterator &,
+                                                      const FEValues<dim> &fe_values) mutable
+      {
+        fe_values[this->introspection().extractors.pressure].get_function_values (this->get_solution(),
+                                                                                  pressure_values);
+        for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
           {
-            fe_values.reinit (cell);
-            fe_values[this->introspection().extractors.pressure].get_function_values (this->get_solution(),
-                                                                                      pressure_values);
-            for (unsigned int q=0; q<n_q_points; ++q)
-              {
-                const double value = pressure_values[q];
-
-                local_pressure_integral += value*fe_values.JxW(q);
-                local_min_pressure = std::min (local_min_pressure, value);
-                local_max_pressure = std::max (local_max_pressure, value);
-              }
+            const double value = pressure_values[q];
+
+            pressure_integral += value*fe_values.JxW(q);
+            min_pressure = std::min (min_pressure, value);
+            max_pressure = std::max (max_pressure, value);
           }
+      });
 
-      const double global_pressure_integral
-        = Utilities::MPI::sum (local_pressure_integral, this->get_mpi_communicator());
+      reductions.add_sum (pressure_integral);
+      reductions.add_min (min_pressure);
+      reductions.add_max (max_pressure);
+    }
 
-      // now do the reductions that are
-      // min/max operations. do them in
-      // one communication by multiplying
-      // one value by -1
-      double global_min_pressure = 0;
-      double global_max_pressure = 0;
-      {
-        double local_values[2] = { -local_min_pressure, local_max_pressure };
-        double global_values[2];
 
-        Utilities::MPI::max (local_values, this->get_mpi_communicator(), global_values);
 
-        global_min_pressure = -global_values[0];
-        global_max_pressure = global_values[1];
-      }
+    template <int dim>
+    std::pair<std::string,std::string>
+    PressureStatistics<dim>::execute (TableHandler &statistics)
+    {
+      // the global values were computed in compute_local_contributions()
+      const double global_pressure_integral = pressure_integral;
+      const double global_min_pressure = min_pressure;
+      const double global_max_pressure = max_pressure;
 
       double global_mean_pressure = global_pressure_integral / this->get_volume();
       statistics.add_value ("Minimal pressure (Pa)",
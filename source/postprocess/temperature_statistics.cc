@@ -34,36 +34,31 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    TemperatureStatistics<dim>::execute (TableHandler &statistics)
+    void
+    TemperatureStatistics<dim>::compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                             ReductionBuffer &reductions)
     {
       // create a quadrature formula based on the temperature element alone.
       const QGauss<dim> quadrature_formula (this->get_fe().base_element(this->introspection().base_elements.temperature).degree+1);
-      const unsigned int n_q_points = quadrature_formula.size();
-
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_quadrature_points |
-                               update_JxW_values);
 
-      std::vector<double> temperature_values(n_q_points);
-
-      double local_temperature_integral = 0;
+      temperature_integral = 0;
 
       // compute the integral quantities by quadrature
-      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-        if (cell->is_locally_owned())
+      std::vector<double> temperature_values(quadrature_formula.size());
+      cell_sweep.add_kernel (quadrature_formula,
+                             update_values   |
+                             update_quadrature_points |
+                             update_JxW_values,
+                             [this, temperature_values] (const typename DoFHandler<dim>::active_cell_iterator &,
+                                                         const FEValues<dim> &fe_values) mutable
+      {
+        fe_values[this->introspection().extractors.temperature].get_function_values (this->get_solution(),
+                                                                                     temperature_values);
+        for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
           {
-            fe_values.reinit (cell);
-            fe_values[this->introspection().extractors.temperature].get_function_values (this->get_solution(),
-                                                                                         temperature_values);
-            for (unsigned int q=0; q<n_q_points; ++q)
-              {
-                local_temperature_integral += temperature_values[q]*fe_values.JxW(q);
-              }
+            temperature_integral += temperature_values[q]*fe_values.JxW(q);
           }
+      });
 
       // compute min/max by simply
       // looping over the elements of the
@@ -74,8 +69,8 @@ namespace aspect
       // values at Gauss quadrature
       // points gives an inaccurate
       // picture of their true values
-      double local_min_temperature = std::numeric_limits<double>::max();
-      double local_max_temperature = -std::numeric_limits<double>::max();
+      min_temperature = std::numeric_limits<double>::max();
+      max_temperature = -std::numeric_limits<double>::max();
       const unsigned int temperature_block = this->introspection().block_indices.temperature;
       IndexSet range = this->get_solution().block(temperature_block).locally_owned_elements();
       for (unsigned int i=0; i<range.n_elements(); ++i)
@@ -83,28 +78,25 @@ namespace aspect
           const unsigned int idx = range.nth_index_in_set(i);
           const double val =  this->get_solution().block(temperature_block)(idx);
 
-          local_min_temperature = std::min<double> (local_min_temperature, val);
-          local_max_temperature = std::max<double> (local_max_temperature, val);
+          min_temperature = std::min<double> (min_temperature, val);
+          max_temperature = std::max<double> (max_temperature, val);
         }
 
-      const double global_temperature_integral
-        = Utilities::MPI::sum (local_temperature_integral, this->get_mpi_communicator());
-      double global_min_temperature = 0;
-      double global_max_temperature = 0;
+      reductions.add_sum (temperature_integral);
+      reductions.add_min (min_temperature);
+      reductions.add_max (max_temperature);
+    }
 
-      // now do the reductions that are
-      // min/max operations. do them in
-      // one communication by multiplying
-      // one value by -1
-      {
-        double local_values[2] = { -local_min_temperature, local_max_temperature };
-        double global_values[2];
 
-        Utilities::MPI::max (local_values, this->get_mpi_communicator(), global_values);
 
-        global_min_temperature = -global_values[0];
-        global_max_temperature = global_values[1];
-      }
+    template <int dim>
+    std::pair<std::string,std::string>
+    TemperatureStatistics<dim>::execute (TableHandler &statistics)
+    {
+      // the global values were computed in compute_local_contributions()
+      const double global_temperature_integral = temperature_integral;
+      const double global_min_temperature = min_temperature;
+      const double global_max_temperature = max_temperature;
 
       double global_mean_temperature = global_temperature_integral / this->get_volume();
       statistics.add_value ("Minimal temperature (K)",
@@ -32,43 +32,48 @@ namespace aspect
   namespace Postprocess
   {
     template <int dim>
-    std::pair<std::string,std::string>
-    VelocityStatistics<dim>::execute (TableHandler &statistics)
+    void
+    VelocityStatistics<dim>::compute_local_contributions (CellSweep<dim> &cell_sweep,
+                                                          ReductionBuffer &reductions)
     {
       const QGauss<dim> quadrature_formula (this->get_fe()
                                             .base_element(this->introspection().base_elements.velocities).degree+1);
-      const unsigned int n_q_points = quadrature_formula.size();
-
-      FEValues<dim> fe_values (this->get_mapping(),
-                               this->get_fe(),
-                               quadrature_formula,
-                               update_values   |
-                               update_quadrature_points |
-                               update_JxW_values);
-      std::vector<Tensor<1,dim> > velocity_values(n_q_points);
-
-      double local_velocity_square_integral = 0;
-      double local_max_velocity = 0;
 
-      for (const auto &cell : this->get_dof_handler().active_cell_iterators())
-        if (cell->is_locally_owned())
+      velocity_square_integral = 0;
+      max_velocity = 0;
+
+      std::vector<Tensor<1,dim> > velocity_values(quadrature_formula.size());
+      cell_sweep.add_kernel (quadrature_formula,
+                             update_values   |
+                             update_quadrature_points |
+                             update_JxW_values,
+                             [this, velocity_values] (const typename DoFHandler<dim>::active_cell_iterator &,
+                                                      const FEValues<dim> &fe_values) mutable
+      {
+        fe_values[this->introspection().extractors.velocities].get_function_values (this->get_solution(),
+                                                                                    velocity_values);
+        for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
           {
-            fe_values.reinit (cell);
-            fe_values[this->introspection().extractors.velocities].get_function_values (this->get_solution(),
-                                                                                        velocity_values);
-            for (unsigned int q = 0; q < n_q_points; ++q)
-              {
-                local_velocity_square_integral += ((velocity_values[q] * velocity_values[q]) *
-                                                   fe_values.JxW(q));
-                local_max_velocity = std::max (std::sqrt(velocity_values[q]*velocity_values[q]),
-                                               local_max_velocity);
-              }
+            velocity_square_integral += ((velocity_values[q] * velocity_values[q]) *
+                                         fe_values.JxW(q));
+            max_velocity = std::max (std::sqrt(velocity_values[q]*velocity_values[q]),
+                                     max_velocity);
           }
+      });
+
+      reductions.add_sum (velocity_square_integral);
+      reductions.add_max (max_velocity);
+    }
+
 
-      const double global_velocity_square_integral
-        = Utilities::MPI::sum (local_velocity_square_integral, this->get_mpi_communicator());
-      const double global_max_velocity
-        = Utilities::MPI::max (local_max_velocity, this->get_mpi_communicator());
+
+    template <int dim>
+    std::pair<std::string,std::string>
+    VelocityStatistics<dim>::execute (TableHandler &statistics)
+    {
+      // the global values were computed in compute_local_contributions()
+      const double global_velocity_square_integral = velocity_square_integral;
+      const double global_max_velocity = max_velocity;
 
       const double vrms = std::sqrt(global_velocity_square_integral) /
                           std::sqrt(this->get_volume());
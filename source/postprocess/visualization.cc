@@ -26,6 +26,8 @@
 #include <aspect/geometry_model/interface.h>
 #include <aspect/mesh_deformation/interface.h>
 
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/dofs/dof_tools.h>
 #include <deal.II/numerics/data_out.h>
 #include <deal.II/numerics/data_out_faces.h>
@@ -38,6 +40,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
 #include <type_traits>
 
 #include <boost/lexical_cast.hpp>
@@ -211,6 +216,109 @@ namespace aspect
       void
       Interface<dim>::load (const std::map<std::string,std::string> &)
       {}
+
+
+
+      template <int dim>
+      void
+      Interface<dim>::create_additional_material_model_outputs (MaterialModel::MaterialModelOutputs<dim> &) const
+      {}
+
+
+
+      template <int dim>
+      MaterialModelEvaluation<dim>::MaterialModelEvaluation (const DataPostprocessorInputs::Vector<dim> &input_data,
+                                                             const Introspection<dim> &introspection)
+        :
+        in (input_data, introspection, true),
+        out (input_data.solution_values.size(), introspection.n_compositional_fields)
+      {}
+
+
+
+      template <int dim>
+      MaterialModelEvaluationCache<dim>::Entry::Entry ()
+        :
+        generation (numbers::invalid_unsigned_int)
+      {}
+
+
+
+      template <int dim>
+      MaterialModelEvaluationCache<dim>::MaterialModelEvaluationCache ()
+        :
+        postprocessors (nullptr),
+        generation (0)
+      {}
+
+
+
+      template <int dim>
+      void
+      MaterialModelEvaluationCache<dim>::initialize (const std::list<std::unique_ptr<Interface<dim> > > &postprocessor_list)
+      {
+        postprocessors = &postprocessor_list;
+      }
+
+
+
+      template <int dim>
+      void
+      MaterialModelEvaluationCache<dim>::clear ()
+      {
+        ++generation;
+        if (generation == numbers::invalid_unsigned_int)
+          generation = 0;
+      }
+
+
+
+      template <int dim>
+      const MaterialModelEvaluation<dim> &
+      MaterialModelEvaluationCache<dim>::evaluate (const DataPostprocessorInputs::Vector<dim> &input_data) const
+      {
+        Assert (postprocessors != nullptr, ExcInternalError());
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+        const typename DoFHandler<dim>::active_cell_iterator cell (input_data.template get_cell<dim>());
+#else
+        const typename DoFHandler<dim>::active_cell_iterator cell (input_data.template get_cell<DoFHandler<dim> >());
+#endif
+
+        // See if the last evaluation on this thread was on the same cell and the
+        // same points during the current output step. DataOut evaluates all
+        // postprocessors on one cell before moving on, so this is the common case.
+        Entry &entry = entries.get();
+        if (entry.generation == generation
+            && entry.evaluation != nullptr
+            && entry.evaluation->in.current_cell == cell
+            && entry.evaluation_points == input_data.evaluation_points)
+          return *entry.evaluation;
+
+        // Otherwise evaluate the material model with the union of all additional
+        // outputs requested by any of the visualization postprocessors.
+        entry.evaluation = std::make_shared<MaterialModelEvaluation<dim> > (input_data, this->introspection());
+        for (const auto &postprocessor : *postprocessors)
+          postprocessor->create_additional_material_model_outputs (entry.evaluation->out);
+
+        this->get_material_model().evaluate (entry.evaluation->in, entry.evaluation->out);
+
+        entry.evaluation_points = input_data.evaluation_points;
+        entry.generation = generation;
+
+        return *entry.evaluation;
+      }
+
+
+
+      template <int dim>
+      const MaterialModelEvaluation<dim> &
+      evaluate_material_model (const SimulatorAccess<dim> &simulator_access,
+                               const DataPostprocessorInputs::Vector<dim> &input_data)
+      {
+        return simulator_access.get_postprocess_manager().template get_matching_postprocessor<Postprocess::Visualization<dim> >()
+               .get_material_model_evaluation_cache().evaluate(input_data);
+      }
     }
 
 
@@ -383,6 +491,15 @@ namespace aspect
 
 
 
+    template <int dim>
+    const VisualizationPostprocessors::MaterialModelEvaluationCache<dim> &
+    Visualization<dim>::get_material_model_evaluation_cache () const
+    {
+      return material_model_evaluation_cache;
+    }
+
+
+
     template <int dim>
     template <typename DataOutType>
     std::string
@@ -497,6 +614,90 @@ namespace aspect
               else
                 writer(filename, temporary_output_location, file_contents);
             }
+          else if (write_in_background_thread)
+            {
+              // Write as many output files as 'group_files' groups, where the
+              // processes of each group share one file. We only do the
+              // communication that is necessary to find out where each
+              // process has to put its piece of the file here, and then write
+              // the pieces on the background thread without any further MPI
+              // calls.
+              const int color = my_id % group_files;
+              MPI_Comm comm;
+              int ierr = MPI_Comm_split(this->get_mpi_communicator(), color, my_id, &comm);
+              AssertThrowMPI(ierr);
+              const unsigned int group_rank = Utilities::MPI::this_mpi_process(comm);
+              const unsigned int group_size = Utilities::MPI::n_mpi_processes(comm);
+
+              // Every process creates a complete .vtu file in memory, from
+              // which we cut the piece that belongs to this process. Only the
+              // first process of each group keeps the header and only the last
+              // one keeps the footer.
+              std::string header, footer;
+              {
+                std::ostringstream tmp;
+                DataOutBase::write_vtu_header(tmp, vtk_flags);
+                header = tmp.str();
+              }
+              {
+                std::ostringstream tmp;
+                DataOutBase::write_vtu_footer(tmp);
+                footer = tmp.str();
+              }
+
+              const std::string *file_contents;
+              std::uint64_t piece_size;
+              {
+                std::ostringstream tmp;
+                data_out.write_vtu(tmp);
+                const std::string vtu_file = tmp.str();
+                Assert (vtu_file.size() >= header.size() + footer.size()
+                        &&
+                        vtu_file.compare(0, header.size(), header) == 0
+                        &&
+                        vtu_file.compare(vtu_file.size() - footer.size(), footer.size(), footer) == 0,
+                        ExcInternalError());
+
+                piece_size = vtu_file.size() - header.size() - footer.size();
+
+                const std::size_t begin = (group_rank == 0 ? 0 : header.size());
+                const std::size_t end = (group_rank == group_size-1 ?
+                                         vtu_file.size() :
+                                         vtu_file.size() - footer.size());
+                file_contents = new std::string(vtu_file, begin, end-begin);
+              }
+
+              // The piece of this process starts after the header and the
+              // pieces of all processes with a lower rank in this group
+              std::uint64_t offset = 0;
+              ierr = MPI_Exscan(&piece_size, &offset, 1, MPI_UINT64_T, MPI_SUM, comm);
+              AssertThrowMPI(ierr);
+              if (group_rank == 0)
+                offset = 0;
+              else
+                offset += header.size();
+
+              // Wait for all previous write operations to finish, should
+              // any be still active,
+              output_history.background_thread.join();
+
+              // then let the first process of the group create (or truncate) the
+              // file before anyone starts writing into it.
+              if (group_rank == 0)
+                {
+                  std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+                  AssertThrow (out, ExcMessage(std::string("Trying to write to file <") +
+                                               filename +
+                                               ">, but the file can't be opened!"));
+                }
+              ierr = MPI_Barrier(comm);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Comm_free(&comm);
+              AssertThrowMPI(ierr);
+
+              output_history.background_thread = Threads::new_thread(&offset_writer,
+                                                                     filename, offset, file_contents);
+            }
           else
             // Just write one data file in parallel
             if (group_files == 1)
@@ -574,6 +775,10 @@ namespace aspect
       else if (increase_file_number)
         ++output_file_number;
 
+      // The solution has changed since the last output, so any material model
+      // evaluations that may have been stored are now outdated
+      material_model_evaluation_cache.clear();
+
       internal::BaseVariablePostprocessor<dim> base_variables;
       base_variables.initialize_simulator (this->get_simulator());
 
@@ -773,8 +978,16 @@ namespace aspect
       // Return what should be printed to the screen. This is a bit
       // late (the output has already been written, and this probably took
       // a good long while), but it's still good to provide a status
-      // update.
-      return std::make_pair (std::string ("Writing graphical output:"),
+      // update. VTU output that is written in a background thread may
+      // not be complete yet, so say so.
+      const bool written_in_background = (write_in_background_thread
+                                          &&
+                                          output_format == "vtu");
+      return std::make_pair (std::string (written_in_background
+                                          ?
+                                          "Writing graphical output in the background:"
+                                          :
+                                          "Writing graphical output:"),
                              this->get_output_directory()
                              + "solution/"
                              + solution_file_prefix);
@@ -851,6 +1064,34 @@ namespace aspect
     }
 
 
+
+    template <int dim>
+    // We need to pass the arguments by value, as this function can be called on a separate thread:
+    void Visualization<dim>::offset_writer (const std::string filename, //NOLINT(performance-unnecessary-value-param)
+                                            const std::size_t offset,
+                                            const std::string *file_contents)
+    {
+      // Open the existing file without truncating it, since other processes
+      // write their pieces into the same file at the same time
+      std::fstream out(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+
+      AssertThrow (out, ExcMessage(std::string("Trying to write to file <") +
+                                   filename +
+                                   ">, but the file can't be opened!"));
+
+      out.seekp(offset);
+      out.write(file_contents->data(), file_contents->size());
+      out.close ();
+
+      AssertThrow (out, ExcMessage(std::string("Writing to file <") +
+                                   filename +
+                                   "> failed!"));
+
+      // destroy the pointer to the data we needed to write
+      delete file_contents;
+    }
+
+
     namespace
     {
       std::tuple
@@ -906,7 +1147,17 @@ namespace aspect
                              "File operations can potentially take a long time, blocking the "
                              "progress of the rest of the model run. Setting this variable to "
                              "`true' moves this process into a background thread, while the "
-                             "rest of the model continues.");
+                             "rest of the model continues. "
+                             "For VTU output with grouped files, every process computes "
+                             "the position of its piece in the shared file before the "
+                             "background thread writes the piece into it, without using "
+                             "MPI-IO. This requires a file system that supports several "
+                             "processes writing to different parts of the same file, as is "
+                             "the case for the parallel file systems of clusters. "
+                             "HDF5 output is always written without a background thread, "
+                             "because parallel HDF5 output requires collective MPI "
+                             "communication that can not run concurrently with the rest "
+                             "of the model.");
 
           prm.declare_entry ("Temporary output location", "",
                              Patterns::Anything(),
@@ -1217,6 +1468,11 @@ namespace aspect
           postprocessors.back()->initialize ();
         }
 
+      // Set up the material model evaluation that is shared between all
+      // postprocessors
+      material_model_evaluation_cache.initialize_simulator (this->get_simulator());
+      material_model_evaluation_cache.initialize (postprocessors);
+
       // Finally also set up a listener to check when the mesh changes
       cell_output_history.mesh_changed = true;
       face_output_history.mesh_changed = true;
@@ -1367,7 +1623,13 @@ namespace aspect
     namespace VisualizationPostprocessors
     {
 #define INSTANTIATE(dim) \
-  template class Interface<dim>;
+  template class Interface<dim>; \
+  template struct MaterialModelEvaluation<dim>; \
+  template class MaterialModelEvaluationCache<dim>; \
+  template \
+  const MaterialModelEvaluation<dim> & \
+  evaluate_material_model (const SimulatorAccess<dim> &, \
+                           const DataPostprocessorInputs::Vector<dim> &);
 
       ASPECT_INSTANTIATE(INSTANTIATE)
 
@@ -99,12 +99,11 @@ namespace aspect
         Assert (computed_quantities.size() == n_quadrature_points,    ExcInternalError());
         Assert (input_data.solution_values[0].size() == this->introspection().n_components,           ExcInternalError());
 
-        MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                   this->introspection());
-        MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points,
-                                                     this->n_compositional_fields());
-
-        this->get_material_model().evaluate(in, out);
+        // Get the material model inputs and outputs from the evaluation that is
+        // shared between all visualization postprocessors
+        const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+        const MaterialModel::MaterialModelInputs<dim> &in = evaluation.in;
+        const MaterialModel::MaterialModelOutputs<dim> &out = evaluation.out;
 
         std::vector<double> melt_fractions(n_quadrature_points);
         if (std::find(property_names.begin(), property_names.end(), "melt fraction") != property_names.end())
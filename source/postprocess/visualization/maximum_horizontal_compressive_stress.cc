@@ -43,13 +43,11 @@ namespace aspect
         Assert (input_data.solution_values[0].size() == this->introspection().n_components,   ExcInternalError());
         Assert (input_data.solution_gradients[0].size() == this->introspection().n_components,  ExcInternalError());
 
-        MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                   this->introspection());
-        MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points,
-                                                     this->n_compositional_fields());
-
-        // Compute the viscosity...
-        this->get_material_model().evaluate(in, out);
+        // Get the material model inputs and outputs from the evaluation that is
+        // shared between all visualization postprocessors
+        const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+        const MaterialModel::MaterialModelInputs<dim> &in = evaluation.in;
+        const MaterialModel::MaterialModelOutputs<dim> &out = evaluation.out;
 
         // ...and use it to compute the stresses and from that the
         // maximum compressive stress direction
@@ -108,14 +108,13 @@ namespace aspect
         Assert (computed_quantities.size() == n_quadrature_points,    ExcInternalError());
         Assert (input_data.solution_values[0].size() == this->introspection().n_components,   ExcInternalError());
 
-        // Set use_strain_rates to true since the compaction viscosity might also depend on the strain rate.
-        MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                   this->introspection(), true);
-        MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points, this->n_compositional_fields());
-        MeltHandler<dim>::create_material_model_outputs(out);
-
-        this->get_material_model().evaluate(in, out);
-        MaterialModel::MeltOutputs<dim> *melt_outputs = out.template get_additional_output<MaterialModel::MeltOutputs<dim> >();
+        // The shared evaluation uses strain rates, which is necessary since the
+        // compaction viscosity might also depend on the strain rate.
+        const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+        const MaterialModel::MaterialModelInputs<dim> &in = evaluation.in;
+        const MaterialModel::MaterialModelOutputs<dim> &out = evaluation.out;
+
+        const MaterialModel::MeltOutputs<dim> *melt_outputs = out.template get_additional_output<MaterialModel::MeltOutputs<dim> >();
         AssertThrow(melt_outputs != nullptr,
                     ExcMessage("Need MeltOutputs from the material model for computing the melt properties."));
 
@@ -178,6 +177,17 @@ namespace aspect
           }
       }
 
+
+
+      template <int dim>
+      void
+      MeltMaterialProperties<dim>::
+      create_additional_material_model_outputs(MaterialModel::MaterialModelOutputs<dim> &outputs) const
+      {
+        MeltHandler<dim>::create_material_model_outputs(outputs);
+      }
+
+
       template <int dim>
       void
       MeltMaterialProperties<dim>::declare_parameters (ParameterHandler &prm)
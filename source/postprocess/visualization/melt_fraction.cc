@@ -55,13 +55,10 @@ namespace aspect
         // in case the material model computes the melt fraction iself, we use that output
         if (Plugins::plugin_type_matches<const MaterialModel::MeltFractionModel<dim>> (this->get_material_model()))
           {
-            MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                       this->introspection());
-            MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points,
-                                                         this->n_compositional_fields());
-
-            // Compute the melt fraction...
-            this->get_material_model().evaluate(in, out);
+            // Get the material model inputs and outputs from the evaluation that is
+            // shared between all visualization postprocessors
+            const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+            const MaterialModel::MaterialModelInputs<dim> &in = evaluation.in;
 
             const MaterialModel::MeltFractionModel<dim> &melt_material_model =
               Plugins::get_plugin_as_type<const MaterialModel::MeltFractionModel<dim>> (this->get_material_model());
@@ -121,13 +121,8 @@ namespace aspect
         Assert (input_data.solution_values[0].size() == this->introspection().n_components,
                 ExcInternalError());
 
-        MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                   this->introspection());
-        MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points,
-                                                     this->n_compositional_fields());
-
-        this->get_material_model().create_additional_named_outputs(out);
-        this->get_material_model().evaluate(in, out);
+        const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+        const MaterialModel::MaterialModelOutputs<dim> &out = evaluation.out;
 
         unsigned int field_index = 0;
         for (unsigned int k=0; k<out.additional_outputs.size(); ++k)
@@ -148,6 +143,16 @@ namespace aspect
               }
           }
       }
+
+
+
+      template <int dim>
+      void
+      NamedAdditionalOutputs<dim>::
+      create_additional_material_model_outputs(MaterialModel::MaterialModelOutputs<dim> &outputs) const
+      {
+        this->get_material_model().create_additional_named_outputs(outputs);
+      }
     }
   }
 }
@@ -53,15 +53,9 @@ namespace aspect
         Assert (input_data.solution_values[0].size() == this->introspection().n_components,    ExcInternalError());
         Assert (input_data.solution_gradients[0].size() == this->introspection().n_components, ExcInternalError());
 
-        MaterialModel::MaterialModelInputs<dim> in(input_data,
-                                                   this->introspection());
-        MaterialModel::MaterialModelOutputs<dim> out(n_quadrature_points,
-                                                     this->n_compositional_fields());
-
-        out.additional_outputs.push_back(
-          std_cxx14::make_unique<MaterialModel::MaterialModelDerivatives<dim>> (n_quadrature_points));
-
-        this->get_material_model().evaluate(in, out);
+        const MaterialModelEvaluation<dim> &evaluation = evaluate_material_model(*this, input_data);
+        const MaterialModel::MaterialModelInputs<dim> &in = evaluation.in;
+        const MaterialModel::MaterialModelOutputs<dim> &out = evaluation.out;
 
         const MaterialModel::MaterialModelDerivatives<dim> *derivatives = out.template get_additional_output<MaterialModel::MaterialModelDerivatives<dim> >();
 
@@ -73,6 +67,21 @@ namespace aspect
                                                                            this->get_newton_handler().parameters.SPD_safety_factor);
           }
       }
+
+
+
+      template <int dim>
+      void
+      SPD_Factor<dim>::
+      create_additional_material_model_outputs(MaterialModel::MaterialModelOutputs<dim> &outputs) const
+      {
+        if (outputs.template get_additional_output<MaterialModel::MaterialModelDerivatives<dim> >() == nullptr)
+          {
+            const unsigned int n_points = outputs.n_evaluation_points();
+            outputs.additional_outputs.push_back(
+              std_cxx14::make_unique<MaterialModel::MaterialModelDerivatives<dim>> (n_points));
+          }
+      }
     }
   }
 }
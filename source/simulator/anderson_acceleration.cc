@@ -0,0 +1,169 @@
+/*
+  Copyright (C) 2020 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/simulator/anderson_acceleration.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+
+namespace aspect
+{
+  namespace internal
+  {
+    AndersonAcceleration::AndersonAcceleration (const unsigned int max_history_size)
+      :
+      max_history_size (max_history_size),
+      last_residual_norm (0.),
+      has_last_iterate (false),
+      accelerated_steps (0),
+      restarts (0)
+    {}
+
+
+
+    bool
+    AndersonAcceleration::apply (const LinearAlgebra::BlockVector &x,
+                                 LinearAlgebra::BlockVector &g)
+    {
+      LinearAlgebra::BlockVector f (g);
+      f -= x;
+      const double residual_norm = f.l2_norm();
+
+      // Safeguard: if the residual grew, the information in the history
+      // is apparently not helpful. Start over with a plain fixed point step,
+      // and use only the current iterate as the starting point of the new
+      // history: the difference to the previous iterate belongs to the
+      // history that was just discarded.
+      if (has_last_iterate && residual_norm > last_residual_norm)
+        {
+          restart ();
+          ++restarts;
+
+          last_g = g;
+          last_f = f;
+          last_residual_norm = residual_norm;
+          return false;
+        }
+
+      if (has_last_iterate)
+        {
+          delta_g.emplace_back (g);
+          delta_g.back() -= last_g;
+          delta_f.emplace_back (f);
+          delta_f.back() -= last_f;
+
+          if (delta_g.size() > max_history_size)
+            {
+              delta_g.pop_front();
+              delta_f.pop_front();
+            }
+        }
+
+      last_g = g;
+      last_f = f;
+      last_residual_norm = residual_norm;
+      has_last_iterate = true;
+
+      const unsigned int m = delta_f.size();
+      if (m == 0)
+        return false;
+
+      // Solve the least squares problem min |f - sum_i gamma_i delta_f_i|
+      // through its normal equations. The problem is small, so this is
+      // cheap, but it may be badly conditioned; regularize it slightly.
+      FullMatrix<double> normal_matrix (m, m);
+      Vector<double> rhs (m);
+      for (unsigned int i=0; i<m; ++i)
+        {
+          for (unsigned int j=0; j<=i; ++j)
+            {
+              normal_matrix(i,j) = delta_f[i] * delta_f[j];
+              normal_matrix(j,i) = normal_matrix(i,j);
+            }
+          rhs(i) = delta_f[i] * f;
+        }
+
+      double max_diagonal = 0;
+      for (unsigned int i=0; i<m; ++i)
+        max_diagonal = std::max (max_diagonal, normal_matrix(i,i));
+
+      if (!(max_diagonal > 0) || !std::isfinite(max_diagonal))
+        {
+          restart ();
+          ++restarts;
+          return false;
+        }
+
+      for (unsigned int i=0; i<m; ++i)
+        normal_matrix(i,i) += 1e-12 * max_diagonal;
+
+      FullMatrix<double> inverse (m, m);
+      inverse.invert (normal_matrix);
+
+      Vector<double> gamma (m);
+      inverse.vmult (gamma, rhs);
+
+      // Discard the history if the coefficients are not reasonable, which
+      // happens if the differences in the history are nearly linearly
+      // dependent.
+      for (unsigned int i=0; i<m; ++i)
+        if (!std::isfinite(gamma(i)) || std::abs(gamma(i)) > 1e4)
+          {
+            restart ();
+            ++restarts;
+            return false;
+          }
+
+      for (unsigned int i=0; i<m; ++i)
+        g.add (-gamma(i), delta_g[i]);
+
+      ++accelerated_steps;
+      return true;
+    }
+
+
+
+    unsigned int
+    AndersonAcceleration::n_accelerated_steps () const
+    {
+      return accelerated_steps;
+    }
+
+
+
+    unsigned int
+    AndersonAcceleration::n_restarts () const
+    {
+      return restarts;
+    }
+
+
+
+    void
+    AndersonAcceleration::restart ()
+    {
+      delta_g.clear();
+      delta_f.clear();
+    }
+  }
+}
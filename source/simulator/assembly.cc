@@ -572,6 +572,7 @@ namespace aspect
       data.local_pressure_shape_function_integrals = 0;
 
     // initialize the material model data on the cell
+    const auto material_model_start_time = std::chrono::steady_clock::now();
     const bool update_strain_rate =
       assemble_newton_stokes_system || this->parameters.enable_prescribed_dilation || rebuild_stokes_matrix;
     compute_material_model_input_values (current_linearization_point,
@@ -590,6 +591,8 @@ namespace aspect
                                                scratch.finite_element_values.get_quadrature(),
                                                scratch.finite_element_values.get_mapping(),
                                                scratch.material_model_outputs);
+    add_detailed_worker_timing ("Assemble Stokes system: Material model evaluation",
+                                material_model_start_time);
 
     scratch.finite_element_values[introspection.extractors.velocities].get_function_values(current_linearization_point,
         scratch.velocity_values);
@@ -614,8 +617,11 @@ namespace aspect
 
     // trigger the invocation of the various functions that actually do
     // all of the assembling
+    const auto assemblers_start_time = std::chrono::steady_clock::now();
     for (unsigned int i=0; i<assemblers->stokes_system.size(); ++i)
       assemblers->stokes_system[i]->execute(scratch,data);
+    add_detailed_worker_timing ("Assemble Stokes system: Assemblers",
+                                assemblers_start_time);
 
     if (!assemblers->stokes_system_on_boundary_face.empty())
       {
@@ -690,10 +696,21 @@ namespace aspect
 
 
   template <int dim>
-  void Simulator<dim>::assemble_stokes_system ()
+  void Simulator<dim>::assemble_stokes_system (const bool residual_only)
   {
     std::string timer_section_name = "Assemble Stokes system";
 
+    // If only the residual is requested, do not assemble the matrix, but
+    // remember the flags the caller has set so that they can be restored
+    // once we are done.
+    const bool caller_rebuild_stokes_matrix = rebuild_stokes_matrix;
+    const bool caller_assemble_newton_stokes_matrix = assemble_newton_stokes_matrix;
+    if (residual_only)
+      {
+        rebuild_stokes_matrix = false;
+        assemble_newton_stokes_matrix = false;
+      }
+
     if (assemble_newton_stokes_system)
       {
         if (!assemble_newton_stokes_matrix && !stokes_matrix_free)
@@ -722,13 +739,19 @@ namespace aspect
     // if we do not rebuild the Stokes matrix. This produces incorrect results
     // when having inhomogeneous constraints. Make sure that we can not have
     // this situation (no active boundary conditions means that only
-    // no-slip/free slip are used). This should not happen as we set this up
-    // correctly before calling this function.
+    // no-slip/free slip are used, and the velocity constraints of the
+    // defect correction and Newton solvers are homogeneous after the first
+    // nonlinear iteration; the current constraints may still contain
+    // inhomogeneous constraints for temperature and compositions, but
+    // these do not affect the Stokes system). This should not happen as
+    // we set this up correctly before calling this function.
     // Note that for Dirichlet boundary conditions in matrix-free computations,
     // we will update the right-hand side with boundary information in
     // StokesMatrixFreeHandler::correct_stokes_rhs().
-    if (!stokes_matrix_free)
-      Assert(rebuild_stokes_matrix || boundary_velocity_manager.get_active_boundary_velocity_conditions().size()==0,
+    if (!stokes_matrix_free || residual_only)
+      Assert(rebuild_stokes_matrix
+             || boundary_velocity_manager.get_active_boundary_velocity_conditions().size()==0
+             || (assemble_newton_stokes_system && nonlinear_iteration > 0),
              ExcInternalError("If we have inhomogeneous constraints, we must re-assemble the system matrix."));
 
     system_rhs = 0;
@@ -814,11 +837,23 @@ namespace aspect
          StokesSystem<dim> (stokes_dofs_per_cell,
                             do_pressure_rhs_compatibility_modification));
 
-    system_matrix.compress(VectorOperation::add);
-    system_rhs.compress(VectorOperation::add);
+    {
+      // the compress() calls exchange the contributions to ghost entries
+      // between processes, and wait for the other processes to finish
+      // their assembly
+      std::unique_ptr<TimerOutput::Scope> compress_timer;
+      if (parameters.detailed_timing_output)
+        compress_timer = std_cxx14::make_unique<TimerOutput::Scope> (computing_timer, "Assemble Stokes system: Compress");
+
+      system_matrix.compress(VectorOperation::add);
+      system_rhs.compress(VectorOperation::add);
+    }
 
-    // If we change the system_rhs, matrix-free Stokes must update
-    if (stokes_matrix_free)
+    // If we change the system_rhs, matrix-free Stokes must update. This
+    // is not necessary if we only want to know the residual: the viscosity
+    // is only needed to apply the matrix, and with homogeneous constraints
+    // there is nothing to correct in the right-hand side.
+    if (stokes_matrix_free && !residual_only)
       {
         stokes_matrix_free->evaluate_material_model();
         stokes_matrix_free->correct_stokes_rhs();
@@ -833,8 +868,15 @@ namespace aspect
         make_pressure_rhs_compatible(system_rhs);
       }
 
-    // record that we have just rebuilt the matrix
-    rebuild_stokes_matrix = false;
+    // record that we have just rebuilt the matrix, or restore the state
+    // the caller expects if we only assembled the residual
+    if (residual_only)
+      {
+        rebuild_stokes_matrix = caller_rebuild_stokes_matrix;
+        assemble_newton_stokes_matrix = caller_assemble_newton_stokes_matrix;
+      }
+    else
+      rebuild_stokes_matrix = false;
   }
 
 
@@ -917,6 +959,7 @@ namespace aspect
           scratch.mesh_velocity_values);
 
     // compute material properties and heating terms
+    const auto material_model_start_time = std::chrono::steady_clock::now();
     compute_material_model_input_values (current_linearization_point,
                                          scratch.finite_element_values,
                                          cell,
@@ -933,58 +976,119 @@ namespace aspect
                                                           scratch.finite_element_values,
                                                           introspection);
 
-    material_model->evaluate(scratch.material_model_inputs,
-                             scratch.material_model_outputs);
-    if (parameters.formulation_temperature_equation ==
-        Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
+    // If the material model has already been evaluated on this cell for
+    // another compositional field in this nonlinear iteration, swap the stored
+    // outputs into the scratch object rather than evaluating the material and
+    // heating models again. The outputs are swapped back (or, if they have just
+    // been computed, swapped into the cache) after the cell terms are assembled.
+    // The temperature never uses the cache, because its material model inputs
+    // differ from those of the compositional fields (see
+    // assemble_and_solve_composition()).
+    const bool use_material_model_cache = (advection_field.is_temperature() == false)
+                                          &&
+                                          (advection_material_model_outputs_cache_valid.empty() == false);
+    const unsigned int cell_index = cell->active_cell_index();
+    const bool reuse_material_model_evaluation = use_material_model_cache
+                                                 &&
+                                                 (advection_material_model_outputs_cache_valid[cell_index] != 0);
+
+    if (reuse_material_model_evaluation)
+      {
+        std::swap (scratch.material_model_outputs, *advection_material_model_outputs_cache[cell_index]);
+        std::swap (scratch.heating_model_outputs, *advection_heating_model_outputs_cache[cell_index]);
+        ++n_reused_advection_material_model_evaluations;
+      }
+    else
       {
-        const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
-        for (unsigned int q=0; q<n_q_points; ++q)
+        material_model->evaluate(scratch.material_model_inputs,
+                                 scratch.material_model_outputs);
+        if (parameters.formulation_temperature_equation ==
+            Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
           {
-            scratch.material_model_outputs.densities[q] = adiabatic_conditions->density(scratch.material_model_inputs.position[q]);
+            const unsigned int n_q_points = scratch.finite_element_values.n_quadrature_points;
+            for (unsigned int q=0; q<n_q_points; ++q)
+              {
+                scratch.material_model_outputs.densities[q] = adiabatic_conditions->density(scratch.material_model_inputs.position[q]);
+              }
           }
-      }
 
 #ifdef DEBUG
-    // make sure that if the model does not use operator splitting,
-    // the material model outputs do not fill the reaction_rates (because the reaction_terms are used instead)
-    if (!parameters.use_operator_splitting)
-      {
-        material_model->create_additional_named_outputs(scratch.material_model_outputs);
-        MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs
-          = scratch.material_model_outputs.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
-
-        Assert(reaction_rate_outputs == nullptr,
-               ExcMessage("You are using a material model where the reaction rate outputs "
-                          "are created even though the operator splitting solver option is "
-                          "not used in the model, this is not supported! "
-                          "If operator splitting is disabled, the reaction_rates should not "
-                          "be created at all. If you want to run a model where reactions are "
-                          "much faster than the advection, which is what the reaction rate "
-                          "outputs are designed for, you should enable operator splitting."));
-      }
+        // make sure that if the model does not use operator splitting,
+        // the material model outputs do not fill the reaction_rates (because the reaction_terms are used instead)
+        if (!parameters.use_operator_splitting)
+          {
+            material_model->create_additional_named_outputs(scratch.material_model_outputs);
+            MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs
+              = scratch.material_model_outputs.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
+
+            Assert(reaction_rate_outputs == nullptr,
+                   ExcMessage("You are using a material model where the reaction rate outputs "
+                              "are created even though the operator splitting solver option is "
+                              "not used in the model, this is not supported! "
+                              "If operator splitting is disabled, the reaction_rates should not "
+                              "be created at all. If you want to run a model where reactions are "
+                              "much faster than the advection, which is what the reaction rate "
+                              "outputs are designed for, you should enable operator splitting."));
+          }
 #endif
 
-    MaterialModel::MaterialAveraging::average (parameters.material_averaging,
-                                               cell,
-                                               scratch.finite_element_values.get_quadrature(),
-                                               scratch.finite_element_values.get_mapping(),
-                                               scratch.material_model_outputs);
+        MaterialModel::MaterialAveraging::average (parameters.material_averaging,
+                                                   cell,
+                                                   scratch.finite_element_values.get_quadrature(),
+                                                   scratch.finite_element_values.get_mapping(),
+                                                   scratch.material_model_outputs);
 
-    heating_model_manager.evaluate(scratch.material_model_inputs,
-                                   scratch.material_model_outputs,
-                                   scratch.heating_model_outputs);
+        heating_model_manager.evaluate(scratch.material_model_inputs,
+                                       scratch.material_model_outputs,
+                                       scratch.heating_model_outputs);
+
+        if (use_material_model_cache)
+          ++n_advection_material_model_evaluations;
+      }
+    add_detailed_worker_timing ((advection_field.is_temperature() ?
+                                 "Assemble temperature system: Material model evaluation" :
+                                 "Assemble composition system: Material model evaluation"),
+                                material_model_start_time);
 
-    // TODO: Compute artificial viscosity once per timestep instead of each time
-    // temperature system is assembled (as this might happen more than once per
-    // timestep for iterative solvers)
     scratch.artificial_viscosity = viscosity_per_cell[cell->active_cell_index()];
     Assert (scratch.artificial_viscosity >= 0, ExcMessage ("The artificial viscosity needs to be a non-negative quantity."));
 
     // trigger the invocation of the various functions that actually do
     // all of the assembling
+    const auto assemblers_start_time = std::chrono::steady_clock::now();
     for (unsigned int i=0; i<assemblers->advection_system.size(); ++i)
       assemblers->advection_system[i]->execute(scratch,data);
+    add_detailed_worker_timing ((advection_field.is_temperature() ?
+                                 "Assemble temperature system: Assemblers" :
+                                 "Assemble composition system: Assemblers"),
+                                assemblers_start_time);
+
+    if (reuse_material_model_evaluation)
+      {
+        std::swap (scratch.material_model_outputs, *advection_material_model_outputs_cache[cell_index]);
+        std::swap (scratch.heating_model_outputs, *advection_heating_model_outputs_cache[cell_index]);
+      }
+    else if (use_material_model_cache)
+      {
+        // The objects in the cache are only allocated the first time a cell
+        // is stored. Afterwards, swapping gives the scratch object the
+        // outdated outputs of an earlier call, which are overwritten when the
+        // next cell is evaluated; missing additional outputs are created
+        // again at the beginning of this function.
+        if (advection_material_model_outputs_cache[cell_index] == nullptr)
+          {
+            advection_material_model_outputs_cache[cell_index]
+              = std_cxx14::make_unique<MaterialModel::MaterialModelOutputs<dim> > (scratch.finite_element_values.n_quadrature_points,
+                                                                                   introspection.n_compositional_fields);
+            advection_heating_model_outputs_cache[cell_index]
+              = std_cxx14::make_unique<HeatingModel::HeatingModelOutputs> (scratch.finite_element_values.n_quadrature_points,
+                                                                           introspection.n_compositional_fields);
+          }
+
+        std::swap (scratch.material_model_outputs, *advection_material_model_outputs_cache[cell_index]);
+        std::swap (scratch.heating_model_outputs, *advection_heating_model_outputs_cache[cell_index]);
+        advection_material_model_outputs_cache_valid[cell_index] = 1;
+      }
 
     // then also work on possible face terms. if necessary, initialize
     // the material model data on faces
@@ -1156,9 +1260,7 @@ namespace aspect
 
     using CellFilter = FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
 
-    Vector<double> viscosity_per_cell;
-    viscosity_per_cell.reinit(triangulation.n_active_cells());
-    get_artificial_viscosity(viscosity_per_cell, advection_field);
+    const Vector<double> &viscosity_per_cell = get_cached_artificial_viscosity(advection_field);
 
     // We have to assemble the term u.grad phi_i * phi_j, which is
     // of total polynomial degree
@@ -1239,8 +1341,17 @@ namespace aspect
          AdvectionSystem<dim> (finite_element.base_element(advection_field.base_element(introspection)),
                                allocate_neighbor_contributions));
 
-    system_matrix.compress(VectorOperation::add);
-    system_rhs.compress(VectorOperation::add);
+    {
+      std::unique_ptr<TimerOutput::Scope> compress_timer;
+      if (parameters.detailed_timing_output)
+        compress_timer = std_cxx14::make_unique<TimerOutput::Scope> (computing_timer,
+                                                                     (advection_field.is_temperature() ?
+                                                                      "Assemble temperature system: Compress" :
+                                                                      "Assemble composition system: Compress"));
+
+      system_matrix.compress(VectorOperation::add);
+      system_rhs.compress(VectorOperation::add);
+    }
   }
 }
 
@@ -1265,7 +1376,7 @@ namespace aspect
                                                                internal::Assembly::CopyData::StokesSystem<dim> &data); \
   template void Simulator<dim>::copy_local_to_global_stokes_system ( \
                                                                      const internal::Assembly::CopyData::StokesSystem<dim> &data); \
-  template void Simulator<dim>::assemble_stokes_system (); \
+  template void Simulator<dim>::assemble_stokes_system (const bool); \
   template void Simulator<dim>::build_advection_preconditioner (const AdvectionField &, \
                                                                 aspect::LinearAlgebra::PreconditionILU &preconditioner, \
                                                                 const double diagonal_strengthening); \
@@ -28,6 +28,9 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/distributed/solution_transfer.h>
 
+#include <fstream>
+#include <memory>
+
 #ifdef DEAL_II_WITH_ZLIB
 #  include <zlib.h>
 #endif
@@ -66,6 +69,113 @@ namespace aspect
                                               + Utilities::to_string(error) + "."));
         }
     }
+
+
+
+    /**
+     * Compress the serialized state of the simulator with zlib and write it
+     * to the file restart.resume.z.new in the given directory.
+     */
+    void write_resume_file (const std::string &serialized_simulator,
+                            const std::string &output_directory)
+    {
+#ifdef DEAL_II_WITH_ZLIB
+      uLongf compressed_data_length = compressBound (serialized_simulator.length());
+      std::vector<char *> compressed_data (compressed_data_length);
+      int err = compress2 ((Bytef *) &compressed_data[0],
+                           &compressed_data_length,
+                           (const Bytef *) serialized_simulator.data(),
+                           serialized_simulator.length(),
+                           Z_BEST_COMPRESSION);
+      (void)err;
+      Assert (err == Z_OK, ExcInternalError());
+
+      // build compression header
+      const uint32_t compression_header[4]
+        = { 1,                                   /* number of blocks */
+            (uint32_t)serialized_simulator.length(), /* size of block */
+            (uint32_t)serialized_simulator.length(), /* size of last block */
+            (uint32_t)compressed_data_length
+          }; /* list of compressed sizes of blocks */
+
+      std::ofstream f ((output_directory + "restart.resume.z.new").c_str());
+      f.write((const char *)compression_header, 4 * sizeof(compression_header[0]));
+      f.write((char *)&compressed_data[0], compressed_data_length);
+      f.close();
+
+      // We check the fail state of the stream _after_ closing the file to
+      // make sure the writes were completed correctly. This also catches
+      // the cases where the file could not be opened in the first place
+      // or one of the write() commands fails, as the fail state is
+      // "sticky".
+      if (!f)
+        AssertThrow(false, ExcMessage ("Writing of the checkpoint file '" + output_directory
+                                       + "restart.resume.z.new' with size "
+                                       + Utilities::to_string(4 * sizeof(compression_header[0])+compressed_data_length)
+                                       + " failed on processor 0."));
+#else
+      (void)serialized_simulator;
+      (void)output_directory;
+#endif
+    }
+
+
+
+    /**
+     * Rename the files of a newly written snapshot in the given directory
+     * to put the new snapshot in place of the old one. The previous
+     * snapshot, if one exists, is kept with the suffix '.old'.
+     */
+    void move_snapshot_in_place (const std::string &output_directory,
+                                 const bool resume_computation)
+    {
+      // if we have previously written a snapshot, then keep the last
+      // snapshot in case this one fails to save. Note: static variables
+      // will only be initialized once per model run.
+      static bool previous_snapshot_exists = (resume_computation == true);
+
+      if (previous_snapshot_exists == true)
+        {
+          move_file (output_directory + "restart.mesh",
+                     output_directory + "restart.mesh.old");
+          move_file (output_directory + "restart.mesh.info",
+                     output_directory + "restart.mesh.info.old");
+          move_file (output_directory + "restart.resume.z",
+                     output_directory + "restart.resume.z.old");
+
+          move_file (output_directory + "restart.mesh_fixed.data",
+                     output_directory + "restart.mesh_fixed.data.old");
+
+          if (Utilities::fexists(output_directory + "restart.mesh_variable.data"))
+            {
+              move_file (output_directory + "restart.mesh_variable.data",
+                         output_directory + "restart.mesh_variable.data.old");
+            }
+
+        }
+
+      move_file (output_directory + "restart.mesh.new",
+                 output_directory + "restart.mesh");
+      move_file (output_directory + "restart.mesh.new.info",
+                 output_directory + "restart.mesh.info");
+      move_file (output_directory + "restart.resume.z.new",
+                 output_directory + "restart.resume.z");
+
+      move_file (output_directory + "restart.mesh.new_fixed.data",
+                 output_directory + "restart.mesh_fixed.data");
+
+      if (Utilities::fexists(output_directory + "restart.mesh.new_variable.data"))
+        {
+          move_file (output_directory + "restart.mesh.new_variable.data",
+                     output_directory + "restart.mesh_variable.data");
+        }
+
+
+      // from now on, we know that if we get into this
+      // function again that a snapshot has previously
+      // been written
+      previous_snapshot_exists = true;
+    }
   }
 
 
@@ -264,6 +374,10 @@ namespace aspect
     TimerOutput::Scope timer (computing_timer, "Create snapshot");
     const unsigned int my_id = Utilities::MPI::this_mpi_process (mpi_communicator);
 
+    // If the previous snapshot is still being written in the background,
+    // wait for it to finish: it renames the files we are about to write.
+    checkpoint_writer_thread.join();
+
     // save Triangulation and Solution vectors:
     {
       std::vector<const LinearAlgebra::BlockVector *> x_system (3);
@@ -307,6 +421,7 @@ namespace aspect
     // save general information This calls the serialization functions on all
     // processes (so that they can take additional action, if necessary, see
     // the manual) but only writes to the restart file on process 0
+    std::shared_ptr<const std::string> serialized_simulator;
     {
       std::ostringstream oss;
 
@@ -315,113 +430,52 @@ namespace aspect
       save_critical_parameters (this->parameters, oa);
       oa << (*this);
 
-      // compress with zlib and write to file on the root processor
-#ifdef DEAL_II_WITH_ZLIB
       if (my_id == 0)
-        {
-          uLongf compressed_data_length = compressBound (oss.str().length());
-          std::vector<char *> compressed_data (compressed_data_length);
-          int err = compress2 ((Bytef *) &compressed_data[0],
-                               &compressed_data_length,
-                               (const Bytef *) oss.str().data(),
-                               oss.str().length(),
-                               Z_BEST_COMPRESSION);
-          (void)err;
-          Assert (err == Z_OK, ExcInternalError());
-
-          // build compression header
-          const uint32_t compression_header[4]
-            = { 1,                                   /* number of blocks */
-                (uint32_t)oss.str().length(), /* size of block */
-                (uint32_t)oss.str().length(), /* size of last block */
-                (uint32_t)compressed_data_length
-              }; /* list of compressed sizes of blocks */
-
-          std::ofstream f ((parameters.output_directory + "restart.resume.z.new").c_str());
-          f.write((const char *)compression_header, 4 * sizeof(compression_header[0]));
-          f.write((char *)&compressed_data[0], compressed_data_length);
-          f.close();
-
-          // We check the fail state of the stream _after_ closing the file to
-          // make sure the writes were completed correctly. This also catches
-          // the cases where the file could not be opened in the first place
-          // or one of the write() commands fails, as the fail state is
-          // "sticky".
-          if (!f)
-            AssertThrow(false, ExcMessage ("Writing of the checkpoint file '" + parameters.output_directory
-                                           + "restart.resume.z.new' with size "
-                                           + Utilities::to_string(4 * sizeof(compression_header[0])+compressed_data_length)
-                                           + " failed on processor 0."));
-        }
-#else
-      AssertThrow (false,
-                   ExcMessage ("You need to have deal.II configured with the `libz' "
-                               "option to support checkpoint/restart, but deal.II "
-                               "did not detect its presence when you called `cmake'."));
-#endif
-
+        serialized_simulator = std::make_shared<const std::string> (oss.str());
     }
 
-    // Wait for everyone to finish writing
+#ifndef DEAL_II_WITH_ZLIB
+    AssertThrow (false,
+                 ExcMessage ("You need to have deal.II configured with the `libz' "
+                             "option to support checkpoint/restart, but deal.II "
+                             "did not detect its presence when you called `cmake'."));
+#endif
+
+    // Wait for everyone to finish writing the mesh and the attached data
     const int ierr = MPI_Barrier(mpi_communicator);
     AssertThrowMPI(ierr);
 
-    // Now rename the snapshots to put the new one in place of the old one.
+    // Compress and write the serialized simulator on the root processor, and
+    // then rename the snapshots to put the new one in place of the old one.
     // Do this after writing the new one, because writing large checkpoints
     // can be slow, and the model might be cancelled during writing.
     // This way restart remains usable even if restart.new is not completely
-    // written.
+    // written. None of this requires communication, so it can also happen
+    // on a background thread while the computation continues.
     if (my_id == 0)
       {
-        // if we have previously written a snapshot, then keep the last
-        // snapshot in case this one fails to save. Note: static variables
-        // will only be initialized once per model run.
-        static bool previous_snapshot_exists = (parameters.resume_computation == true);
+        const std::string output_directory = parameters.output_directory;
+        const bool resume_computation = parameters.resume_computation;
 
-        if (previous_snapshot_exists == true)
+        if (parameters.write_checkpoint_in_background_thread)
           {
-            move_file (parameters.output_directory + "restart.mesh",
-                       parameters.output_directory + "restart.mesh.old");
-            move_file (parameters.output_directory + "restart.mesh.info",
-                       parameters.output_directory + "restart.mesh.info.old");
-            move_file (parameters.output_directory + "restart.resume.z",
-                       parameters.output_directory + "restart.resume.z.old");
-
-            move_file (parameters.output_directory + "restart.mesh_fixed.data",
-                       parameters.output_directory + "restart.mesh_fixed.data.old");
-
-            if (Utilities::fexists(parameters.output_directory + "restart.mesh_variable.data"))
-              {
-                move_file (parameters.output_directory + "restart.mesh_variable.data",
-                           parameters.output_directory + "restart.mesh_variable.data.old");
-              }
-
+            checkpoint_writer_thread = Threads::new_thread ([=]()
+            {
+              write_resume_file (*serialized_simulator, output_directory);
+              move_snapshot_in_place (output_directory, resume_computation);
+            });
           }
-
-        move_file (parameters.output_directory + "restart.mesh.new",
-                   parameters.output_directory + "restart.mesh");
-        move_file (parameters.output_directory + "restart.mesh.new.info",
-                   parameters.output_directory + "restart.mesh.info");
-        move_file (parameters.output_directory + "restart.resume.z.new",
-                   parameters.output_directory + "restart.resume.z");
-
-        move_file (parameters.output_directory + "restart.mesh.new_fixed.data",
-                   parameters.output_directory + "restart.mesh_fixed.data");
-
-        if (Utilities::fexists(parameters.output_directory + "restart.mesh.new_variable.data"))
+        else
           {
-            move_file (parameters.output_directory + "restart.mesh.new_variable.data",
-                       parameters.output_directory + "restart.mesh_variable.data");
+            write_resume_file (*serialized_simulator, output_directory);
+            move_snapshot_in_place (output_directory, resume_computation);
           }
-
-
-        // from now on, we know that if we get into this
-        // function again that a snapshot has previously
-        // been written
-        previous_snapshot_exists = true;
       }
 
-    pcout << "*** Snapshot created!" << std::endl << std::endl;
+    if (parameters.write_checkpoint_in_background_thread)
+      pcout << "*** Snapshot mesh and solution written, the remaining state is being written in the background!" << std::endl << std::endl;
+    else
+      pcout << "*** Snapshot created!" << std::endl << std::endl;
   }
 
 
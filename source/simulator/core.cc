@@ -163,6 +163,8 @@ namespace aspect
 
     statistics_last_write_size (0),
     statistics_last_hash (0),
+    statistics_columns_written (0),
+    statistics_rows_written (0),
 
     computing_timer (mpi_communicator,
                      pcout,
@@ -193,6 +195,8 @@ namespace aspect
     old_time_step (numbers::signaling_nan<double>()),
     timestep_number (numbers::invalid_unsigned_int),
     nonlinear_iteration (numbers::invalid_unsigned_int),
+    last_refinement_timestep_number (0),
+    cells_advected_since_last_refinement (0.),
 
     // We need to disable eliminate_refined_boundary_islands as this leads to
     // a deadlock for deal.II <= 9.2.0 as described in
@@ -432,6 +436,7 @@ namespace aspect
     time_stepping_manager.parse_parameters (prm);
 
     lateral_averaging.initialize_simulator (*this);
+    lateral_averaging.initialize ();
 
     geometry_model->create_coarse_mesh (triangulation);
     global_Omega_diameter = GridTools::diameter (triangulation);
@@ -525,6 +530,13 @@ namespace aspect
     // object (set from the output_statistics() function)
     output_statistics_thread.join();
 
+    // also wait for a snapshot that may still be written in the background
+    checkpoint_writer_thread.join();
+
+    // the objects in the scratch object pool reference the mapping, which
+    // may be deleted before the pool itself (see MeshDeformationHandler)
+    scratch_object_pool.clear();
+
     // If an exception is being thrown (for example due to AssertThrow()), we
     // might end up here with currently active timing sections. The destructor
     // of TimerOutput does MPI communication, which can lead to deadlocks,
@@ -1318,6 +1330,9 @@ namespace aspect
 
     dof_handler.distribute_dofs(finite_element);
 
+    // the artificial viscosity computed on the previous mesh is no longer valid
+    artificial_viscosity_cache.clear();
+
     // Renumber the DoFs hierarchical so that we get the
     // same numbering if we resume the computation. This
     // is because the numbering depends on the order the
@@ -1532,9 +1547,54 @@ namespace aspect
     std::unique_ptr<parallel::distributed::SolutionTransfer<dim,LinearAlgebra::Vector> >
     mesh_deformation_trans;
 
+    // If requested, time the individual phases of the refinement in
+    // addition to the two parts below.
+    const auto time_phase = [&] (const std::string &section_name) -> std::unique_ptr<TimerOutput::Scope>
+    {
+      if (parameters.detailed_timing_output)
+        return std_cxx14::make_unique<TimerOutput::Scope> (computing_timer, section_name);
+      else
+        return nullptr;
+    };
+
+    last_refinement_timestep_number = timestep_number;
+    cells_advected_since_last_refinement = 0;
+
+    // Communicate refinement flags on ghost cells from the owner of the
+    // cell. This is necessary to get consistent refinement, as mesh
+    // smoothing would undo some of the requested coarsening/refinement.
+    const auto exchange_refinement_flags = [&] ()
+    {
+      auto pack
+      = [] (const typename DoFHandler<dim>::active_cell_iterator &cell) -> unsigned int
+      {
+        if (cell->refine_flag_set())
+          return 1;
+        if (cell->coarsen_flag_set())
+          return 2;
+        return 0;
+      };
+      auto unpack
+      = [] (const typename DoFHandler<dim>::active_cell_iterator &cell, const unsigned int &flag) -> void
+      {
+        cell->clear_coarsen_flag();
+        cell->clear_refine_flag();
+        if (flag==1)
+          cell->set_refine_flag();
+        else if (flag==2)
+          cell->set_coarsen_flag();
+      };
+
+      GridTools::exchange_cell_data_to_ghosts<unsigned int, DoFHandler<dim>>
+                                                                          (dof_handler, pack, unpack);
+    };
+
     {
       TimerOutput::Scope timer (computing_timer, "Refine mesh structure, part 1");
 
+      std::unique_ptr<TimerOutput::Scope> phase_timer
+        = time_phase ("Refine mesh structure, part 1: compute refinement indicators");
+
       Vector<float> estimated_error_per_cell (triangulation.n_active_cells());
       mesh_refinement_manager.execute (estimated_error_per_cell);
 
@@ -1553,6 +1613,39 @@ namespace aspect
 
       mesh_refinement_manager.tag_additional_cells ();
 
+      // If requested, also refine the neighbors of the cells flagged for
+      // refinement, one layer at a time, so that features moving with the
+      // flow stay within the refined region until the next refinement.
+      // Neighbors that are already finer than the flagged cell are left
+      // alone.
+      for (unsigned int layer=0; layer<parameters.refinement_buffer_layers; ++layer)
+        {
+          exchange_refinement_flags ();
+
+          std::vector<typename DoFHandler<dim>::active_cell_iterator> buffer_cells;
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (cell->is_locally_owned() && !cell->refine_flag_set())
+              {
+                const std::vector<typename DoFHandler<dim>::active_cell_iterator> neighbors
+                  = GridTools::get_active_neighbors<DoFHandler<dim>> (cell);
+
+                for (const auto &neighbor : neighbors)
+                  if (neighbor->refine_flag_set() && neighbor->level() >= cell->level())
+                    {
+                      buffer_cells.push_back (cell);
+                      break;
+                    }
+              }
+
+          for (const auto &cell : buffer_cells)
+            {
+              cell->clear_coarsen_flag ();
+              cell->set_refine_flag ();
+            }
+        }
+
+      phase_timer = time_phase ("Refine mesh structure, part 1: prepare refinement");
+
 
       // clear refinement flags if parameter.refinement_fraction=0.0
       if (parameters.refinement_fraction==0.0)
@@ -1609,41 +1702,45 @@ namespace aspect
       signals.pre_refinement_store_user_data(triangulation);
 
 
-      {
-        // Communicate refinement flags on ghost cells from the owner of the
-        // cell. This is necessary to get consistent refinement, as mesh
-        // smoothing would undo some of the requested coarsening/refinement.
+      exchange_refinement_flags ();
+      triangulation.prepare_coarsening_and_refinement();
 
-        auto pack
-        = [] (const typename DoFHandler<dim>::active_cell_iterator &cell) -> unsigned int
+      // If no cell is going to be refined or coarsened, there is nothing to
+      // transfer and the degrees of freedom, constraints, and sparsity
+      // patterns we have are still correct. We can only skip the remaining
+      // work if no one else relies on it happening, i.e., if no plugin
+      // stores data on the cells and cells are not weighted for
+      // repartitioning.
+      if (parameters.skip_unchanged_mesh_refinement
+          && signals.pre_refinement_store_user_data.empty()
+          && signals.post_refinement_load_user_data.empty()
+          && triangulation.signals.cell_weight.empty())
         {
-          if (cell->refine_flag_set())
-            return 1;
-          if (cell->coarsen_flag_set())
-            return 2;
-          return 0;
-        };
-        auto unpack
-        = [] (const typename DoFHandler<dim>::active_cell_iterator &cell, const unsigned int &flag) -> void
-        {
-          cell->clear_coarsen_flag();
-          cell->clear_refine_flag();
-          if (flag==1)
-            cell->set_refine_flag();
-          else if (flag==2)
-            cell->set_coarsen_flag();
-        };
+          bool mesh_changes = false;
+          for (const auto &cell : triangulation.active_cell_iterators())
+            if (cell->is_locally_owned()
+                && (cell->refine_flag_set() || cell->coarsen_flag_set()))
+              {
+                mesh_changes = true;
+                break;
+              }
 
-        GridTools::exchange_cell_data_to_ghosts<unsigned int, DoFHandler<dim>>
-                                                                            (dof_handler, pack, unpack);
+          if (Utilities::MPI::max (mesh_changes ? 1 : 0, mpi_communicator) == 0)
+            {
+              pcout << "   No cells were flagged for refinement or coarsening, keeping the current mesh."
+                    << std::endl
+                    << std::endl;
+              return;
+            }
+        }
 
-      }
-      triangulation.prepare_coarsening_and_refinement();
       system_trans.prepare_for_coarsening_and_refinement(x_system);
 
       if (parameters.mesh_deformation_enabled)
         mesh_deformation_trans->prepare_for_coarsening_and_refinement(x_fs_system);
 
+      phase_timer = time_phase ("Refine mesh structure, part 1: execute refinement");
+
       triangulation.execute_coarsening_and_refinement ();
       if (MappingQCache<dim> *map = dynamic_cast<MappingQCache<dim>*>(&(*mapping)))
         map->initialize(triangulation,MappingQGeneric<dim>(4));
@@ -1654,6 +1751,9 @@ namespace aspect
     {
       TimerOutput::Scope timer (computing_timer, "Refine mesh structure, part 2");
 
+      std::unique_ptr<TimerOutput::Scope> phase_timer
+        = time_phase ("Refine mesh structure, part 2: transfer solution");
+
       LinearAlgebra::BlockVector distributed_system;
       LinearAlgebra::BlockVector old_distributed_system;
       LinearAlgebra::BlockVector distributed_mesh_velocity;
@@ -1695,6 +1795,8 @@ namespace aspect
       // do the same as above, but for the mesh deformation solution
       if (parameters.mesh_deformation_enabled)
         {
+          phase_timer = time_phase ("Refine mesh structure, part 2: transfer mesh deformation");
+
           constraints.distribute (distributed_mesh_velocity);
           mesh_deformation->mesh_velocity = distributed_mesh_velocity;
 
@@ -1727,8 +1829,11 @@ namespace aspect
         }
 
       // Possibly load data of plugins associated with cells
+      phase_timer = time_phase ("Refine mesh structure, part 2: load cell data");
       signals.post_refinement_load_user_data(triangulation);
 
+      phase_timer.reset ();
+
       // calculate global volume after displacing mesh (if we have, in fact, displaced it)
       global_volume = GridTools::volume (triangulation, *mapping);
     }
@@ -1745,6 +1850,10 @@ namespace aspect
     // two time steps if those are available
     initialize_current_linearization_point();
 
+    // the artificial viscosity depends on the solution of the previous time
+    // steps, which has changed since the last time we computed it
+    artificial_viscosity_cache.clear();
+
     // The mesh deformation scheme is currently not built to work inside a nonlinear solver.
     // We do the mesh deformation execution at the beginning of the timestep for a specific reason.
     // The time step size is calculated AFTER the whole solve_timestep() function.  If we call
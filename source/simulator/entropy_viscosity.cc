@@ -23,6 +23,7 @@
 #include <aspect/melt.h>
 
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/work_stream.h>
 #include <deal.II/fe/fe_values.h>
 
 
@@ -276,360 +277,378 @@ namespace aspect
                                           update_normal_vectors |
                                           update_JxW_values;
 
-    internal::Assembly::Scratch::
-    AdvectionSystem<dim> scratch (finite_element,
-                                  finite_element.base_element(advection_field.base_element(introspection)),
-                                  *mapping,
-                                  QGauss<dim>(advection_field.polynomial_degree(introspection)
-                                              +
-                                              (parameters.stokes_velocity_degree+1)/2),
-                                  QTrapez<dim-1> (),
-                                  update_flags,
-                                  face_update_flags,
-                                  introspection.n_compositional_fields,
-                                  advection_field);
-
-    std::vector<Tensor<1,dim> > face_old_velocity_values (scratch.face_finite_element_values->n_quadrature_points);
-    std::vector<Tensor<1,dim> > face_old_old_velocity_values (scratch.face_finite_element_values->n_quadrature_points);
+    // Compute the artificial viscosity on all cells in parallel. Every cell
+    // only writes its own entry of viscosity_per_cell, which the copier below
+    // does for the value computed by the worker.
+    auto worker = [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+                      internal::Assembly::Scratch::AdvectionSystem<dim> &scratch,
+                      std::pair<unsigned int,T> &data)
+    {
+      data.first = cell->active_cell_index();
+
+      // Skip cells for which we can not/do not need to compute the
+      // stabilization. We need to compute the artificial viscosity
+      // on all locally owned cells, but if we want to
+      // smooth/average it over a neighborhood of a locally owned
+      // cell, then we also need it on ghost cells; we could get it
+      // there through parallel communication, but the easier way is
+      // to simply compute it there as well
+      if (cell->is_artificial()
+          ||
+          (cell->is_ghost() &&
+           parameters.use_artificial_viscosity_smoothing == false))
+        {
+          data.second = numbers::signaling_nan<T>();
+          return;
+        }
+      // Also skip all interior cells if we are asked to do so. Do not
+      // skip neighbor cells of boundary cells if smoothing is on, because
+      // the smoothing uses both the boundary cell and its neighbor.
+      else if (skip_interior_cells && !cell->at_boundary())
+        {
+          bool neighbor_at_boundary = false;
+          for (unsigned int face_no=0; face_no<GeometryInfo<dim>::faces_per_cell; ++face_no)
+            if (cell->neighbor(face_no)->at_boundary() == true)
+              neighbor_at_boundary = true;
 
-    for (const auto &cell : dof_handler.active_cell_iterators())
-      {
-        // Skip cells for which we can not/do not need to compute the
-        // stabilization. We need to compute the artificial viscosity
-        // on all locally owned cells, but if we want to
-        // smooth/average it over a neighborhood of a locally owned
-        // cell, then we also need it on ghost cells; we could get it
-        // there through parallel communication, but the easier way is
-        // to simply compute it there as well
-        if (cell->is_artificial()
-            ||
-            (cell->is_ghost() &&
-             parameters.use_artificial_viscosity_smoothing == false))
-          {
-            viscosity_per_cell[cell->active_cell_index()] = numbers::signaling_nan<T>();
-            continue;
-          }
-        // Also skip all interior cells if we are asked to do so. Do not
-        // skip neighbor cells of boundary cells if smoothing is on, because
-        // the smoothing uses both the boundary cell and its neighbor.
-        else if (skip_interior_cells && !cell->at_boundary())
-          {
-            bool neighbor_at_boundary = false;
-            for (unsigned int face_no=0; face_no<GeometryInfo<dim>::faces_per_cell; ++face_no)
-              if (cell->neighbor(face_no)->at_boundary() == true)
-                neighbor_at_boundary = true;
+          if (parameters.use_artificial_viscosity_smoothing == false ||
+              neighbor_at_boundary == false)
+            {
+              data.second = numbers::signaling_nan<T>();
+              return;
+            }
+        }
 
-            if (parameters.use_artificial_viscosity_smoothing == false ||
-                neighbor_at_boundary == false)
+      // For fields that have physical diffusion (e.g. temperature),
+      // we can disable artificial viscosity stabilization at
+      // Dirichlet boundaries, because the boundary is conduction
+      // dominated anyway. Moreover, the residual we would compute
+      // would be erroneously large, because it does not take into
+      // account the boundary constraints. This would lead to
+      // unnecessary large diffusion in the cells that matter most
+      // for the overall energy balance of the system. However, we
+      // sometimes have Dirichlet temperature boundary conditions
+      // with prescribed non-tangential velocities, in these cases
+      // we need the stabilization, because the boundary cells can
+      // be advection dominated. Hence, only disable artificial
+      // viscosity if flow through the boundary is slow, or
+      // tangential.
+      if (parameters.advection_stabilization_method
+          == Parameters<dim>::AdvectionStabilizationMethod::entropy_viscosity
+          && advection_field.is_temperature())
+        {
+          const std::set<types::boundary_id> &fixed_temperature_boundaries =
+            boundary_temperature_manager.get_fixed_temperature_boundary_indicators();
+          const std::set<types::boundary_id> &tangential_velocity_boundaries =
+            boundary_velocity_manager.get_tangential_boundary_velocity_indicators();
+          const std::set<types::boundary_id> &zero_velocity_boundaries =
+            boundary_velocity_manager.get_zero_boundary_velocity_indicators();
+
+          bool cell_at_conduction_dominated_dirichlet_boundary = false;
+          for (unsigned int face_no=0; face_no<GeometryInfo<dim>::faces_per_cell; ++face_no)
+            if (cell->at_boundary(face_no) == true &&
+                fixed_temperature_boundaries.find(cell->face(face_no)->boundary_id()) != fixed_temperature_boundaries.end())
               {
-                viscosity_per_cell[cell->active_cell_index()] = numbers::signaling_nan<T>();
-                continue;
-              }
-          }
+                // If the velocity is tangential or zero we can always disable stabilization, except if there is another
+                // face at a different boundary. Therefore continue with the next face rather than break the loop.
+                if ((tangential_velocity_boundaries.find(cell->face(face_no)->boundary_id())
+                     != tangential_velocity_boundaries.end())
+                    ||
+                    (zero_velocity_boundaries.find(cell->face(face_no)->boundary_id())
+                     != zero_velocity_boundaries.end()))
+                  {
+                    cell_at_conduction_dominated_dirichlet_boundary = true;
+                    continue;   // test next face
+                  }
 
-        // For fields that have physical diffusion (e.g. temperature),
-        // we can disable artificial viscosity stabilization at
-        // Dirichlet boundaries, because the boundary is conduction
-        // dominated anyway. Moreover, the residual we would compute
-        // would be erroneously large, because it does not take into
-        // account the boundary constraints. This would lead to
-        // unnecessary large diffusion in the cells that matter most
-        // for the overall energy balance of the system. However, we
-        // sometimes have Dirichlet temperature boundary conditions
-        // with prescribed non-tangential velocities, in these cases
-        // we need the stabilization, because the boundary cells can
-        // be advection dominated. Hence, only disable artificial
-        // viscosity if flow through the boundary is slow, or
-        // tangential.
-        if (parameters.advection_stabilization_method
-            == Parameters<dim>::AdvectionStabilizationMethod::entropy_viscosity
-            && advection_field.is_temperature())
-          {
-            const std::set<types::boundary_id> &fixed_temperature_boundaries =
-              boundary_temperature_manager.get_fixed_temperature_boundary_indicators();
-            const std::set<types::boundary_id> &tangential_velocity_boundaries =
-              boundary_velocity_manager.get_tangential_boundary_velocity_indicators();
-            const std::set<types::boundary_id> &zero_velocity_boundaries =
-              boundary_velocity_manager.get_zero_boundary_velocity_indicators();
-
-            bool cell_at_conduction_dominated_dirichlet_boundary = false;
-            for (unsigned int face_no=0; face_no<GeometryInfo<dim>::faces_per_cell; ++face_no)
-              if (cell->at_boundary(face_no) == true &&
-                  fixed_temperature_boundaries.find(cell->face(face_no)->boundary_id()) != fixed_temperature_boundaries.end())
-                {
-                  // If the velocity is tangential or zero we can always disable stabilization, except if there is another
-                  // face at a different boundary. Therefore continue with the next face rather than break the loop.
-                  if ((tangential_velocity_boundaries.find(cell->face(face_no)->boundary_id())
-                       != tangential_velocity_boundaries.end())
-                      ||
-                      (zero_velocity_boundaries.find(cell->face(face_no)->boundary_id())
-                       != zero_velocity_boundaries.end()))
-                    {
-                      cell_at_conduction_dominated_dirichlet_boundary = true;
-                      continue;   // test next face
-                    }
-
-                  scratch.face_finite_element_values->reinit (cell, face_no);
-                  (*scratch.face_finite_element_values)[introspection.extractors.velocities].get_function_values(old_solution,
-                      face_old_velocity_values);
-                  (*scratch.face_finite_element_values)[introspection.extractors.velocities].get_function_values(old_old_solution,
-                      face_old_old_velocity_values);
-
-                  // ... check if the face is a boundary with normal flow by integrating the normal velocities
-                  // (flux through the boundary) as: int u*n ds = Sum_q u(x_q)*n(x_q) JxW(x_q)...
-                  double normal_flow = 0.0;
-                  double flow = 0.0;
-                  double area = 0.0;
-                  for (unsigned int q=0; q<scratch.face_finite_element_values->n_quadrature_points; ++q)
-                    {
-                      normal_flow += ((face_old_velocity_values[q]+face_old_old_velocity_values[q])/2.0 *
-                                      scratch.face_finite_element_values->normal_vector(q)) *
-                                     scratch.face_finite_element_values->JxW(q);
-                      flow += ((face_old_velocity_values[q]+face_old_old_velocity_values[q])/2.0).norm() *
-                              scratch.face_finite_element_values->JxW(q);
-                      area += scratch.face_finite_element_values->JxW(q);
-                    }
-
-                  // Disable stabilization for boundaries with slow flow, or tangential flow.
-                  // Break the loop in case a face is at multiple boundaries, some with flow, some without.
-                  // In those cases we can not disable stabilization.
-                  if ((std::abs(flow/area) * time_step
-                       < std::sqrt(std::numeric_limits<double>::epsilon()) * cell->diameter())
-                      ||
-                      (std::abs(normal_flow)
-                       < std::sqrt(std::numeric_limits<double>::epsilon()) * std::abs(flow)))
-                    {
-                      cell_at_conduction_dominated_dirichlet_boundary = true;
-                    }
-                  else
-                    {
-                      cell_at_conduction_dominated_dirichlet_boundary = false;
-                      break; // no need to check any other face
-                    }
-                }
-
-            if (cell_at_conduction_dominated_dirichlet_boundary)
-              {
-                // If we set the viscosity to zero, we don't need any further computation on this cell
-                viscosity_per_cell[cell->active_cell_index()] = 0.0;
-                continue;   // next cell
+                std::vector<Tensor<1,dim> > face_old_velocity_values (scratch.face_finite_element_values->n_quadrature_points);
+                std::vector<Tensor<1,dim> > face_old_old_velocity_values (scratch.face_finite_element_values->n_quadrature_points);
+
+                scratch.face_finite_element_values->reinit (cell, face_no);
+                (*scratch.face_finite_element_values)[introspection.extractors.velocities].get_function_values(old_solution,
+                    face_old_velocity_values);
+                (*scratch.face_finite_element_values)[introspection.extractors.velocities].get_function_values(old_old_solution,
+                    face_old_old_velocity_values);
+
+                // ... check if the face is a boundary with normal flow by integrating the normal velocities
+                // (flux through the boundary) as: int u*n ds = Sum_q u(x_q)*n(x_q) JxW(x_q)...
+                double normal_flow = 0.0;
+                double flow = 0.0;
+                double area = 0.0;
+                for (unsigned int q=0; q<scratch.face_finite_element_values->n_quadrature_points; ++q)
+                  {
+                    normal_flow += ((face_old_velocity_values[q]+face_old_old_velocity_values[q])/2.0 *
+                                    scratch.face_finite_element_values->normal_vector(q)) *
+                                   scratch.face_finite_element_values->JxW(q);
+                    flow += ((face_old_velocity_values[q]+face_old_old_velocity_values[q])/2.0).norm() *
+                            scratch.face_finite_element_values->JxW(q);
+                    area += scratch.face_finite_element_values->JxW(q);
+                  }
+
+                // Disable stabilization for boundaries with slow flow, or tangential flow.
+                // Break the loop in case a face is at multiple boundaries, some with flow, some without.
+                // In those cases we can not disable stabilization.
+                if ((std::abs(flow/area) * time_step
+                     < std::sqrt(std::numeric_limits<double>::epsilon()) * cell->diameter())
+                    ||
+                    (std::abs(normal_flow)
+                     < std::sqrt(std::numeric_limits<double>::epsilon()) * std::abs(flow)))
+                  {
+                    cell_at_conduction_dominated_dirichlet_boundary = true;
+                  }
+                else
+                  {
+                    cell_at_conduction_dominated_dirichlet_boundary = false;
+                    break; // no need to check any other face
+                  }
               }
-          }
 
-        const unsigned int n_q_points    = scratch.finite_element_values.n_quadrature_points;
+          if (cell_at_conduction_dominated_dirichlet_boundary)
+            {
+              // If we set the viscosity to zero, we don't need any further computation on this cell
+              data.second = 0.0;
+              return;   // next cell
+            }
+        }
 
-        // also have the number of dofs that correspond just to the element for
-        // the system we are currently trying to assemble
-        const unsigned int advection_dofs_per_cell = scratch.phi_field.size();
-        (void)advection_dofs_per_cell;
-        Assert (advection_dofs_per_cell < scratch.finite_element_values.get_fe().dofs_per_cell, ExcInternalError());
-        Assert (scratch.grad_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
-        Assert (scratch.phi_field.size() == advection_dofs_per_cell, ExcInternalError());
+      const unsigned int n_q_points    = scratch.finite_element_values.n_quadrature_points;
 
-        const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
+      // also have the number of dofs that correspond just to the element for
+      // the system we are currently trying to assemble
+      const unsigned int advection_dofs_per_cell = scratch.phi_field.size();
+      (void)advection_dofs_per_cell;
+      Assert (advection_dofs_per_cell < scratch.finite_element_values.get_fe().dofs_per_cell, ExcInternalError());
+      Assert (scratch.grad_phi_field.size() == advection_dofs_per_cell, ExcInternalError());
+      Assert (scratch.phi_field.size() == advection_dofs_per_cell, ExcInternalError());
 
-        scratch.finite_element_values.reinit (cell);
+      const FEValuesExtractors::Scalar solution_field = advection_field.scalar_extractor(introspection);
 
-        // get all dof indices on the current cell, then extract those
-        // that correspond to the solution_field we are interested in
-        cell->get_dof_indices (scratch.local_dof_indices);
+      scratch.finite_element_values.reinit (cell);
 
-        // initialize all of the scratch fields for further down
-        scratch.finite_element_values[introspection.extractors.temperature].get_function_values (old_solution,
-            scratch.old_temperature_values);
-        scratch.finite_element_values[introspection.extractors.temperature].get_function_values (old_old_solution,
-            scratch.old_old_temperature_values);
+      // get all dof indices on the current cell, then extract those
+      // that correspond to the solution_field we are interested in
+      cell->get_dof_indices (scratch.local_dof_indices);
 
-        scratch.finite_element_values[introspection.extractors.velocities].get_function_symmetric_gradients (old_solution,
-            scratch.old_strain_rates);
-        scratch.finite_element_values[introspection.extractors.velocities].get_function_symmetric_gradients (old_old_solution,
-            scratch.old_old_strain_rates);
+      // initialize all of the scratch fields for further down
+      scratch.finite_element_values[introspection.extractors.temperature].get_function_values (old_solution,
+          scratch.old_temperature_values);
+      scratch.finite_element_values[introspection.extractors.temperature].get_function_values (old_old_solution,
+          scratch.old_old_temperature_values);
 
-        scratch.finite_element_values[introspection.extractors.pressure].get_function_values (old_solution,
-            scratch.old_pressure);
-        scratch.finite_element_values[introspection.extractors.pressure].get_function_values (old_old_solution,
-            scratch.old_old_pressure);
+      scratch.finite_element_values[introspection.extractors.velocities].get_function_symmetric_gradients (old_solution,
+          scratch.old_strain_rates);
+      scratch.finite_element_values[introspection.extractors.velocities].get_function_symmetric_gradients (old_old_solution,
+          scratch.old_old_strain_rates);
 
-        for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
-          {
-            scratch.finite_element_values[introspection.extractors.compositional_fields[c]].get_function_values(old_solution,
-                scratch.old_composition_values[c]);
-            scratch.finite_element_values[introspection.extractors.compositional_fields[c]].get_function_values(old_old_solution,
-                scratch.old_old_composition_values[c]);
-          }
+      scratch.finite_element_values[introspection.extractors.pressure].get_function_values (old_solution,
+          scratch.old_pressure);
+      scratch.finite_element_values[introspection.extractors.pressure].get_function_values (old_old_solution,
+          scratch.old_old_pressure);
 
-        scratch.finite_element_values[introspection.extractors.velocities].get_function_values (old_solution,
-            scratch.old_velocity_values);
-        scratch.finite_element_values[introspection.extractors.velocities].get_function_values (old_old_solution,
-            scratch.old_old_velocity_values);
-        scratch.finite_element_values[introspection.extractors.velocities].get_function_values(current_linearization_point,
-            scratch.current_velocity_values);
-
-        scratch.finite_element_values[introspection.extractors.pressure].get_function_gradients (old_solution,
-            scratch.old_pressure_gradients);
-        scratch.finite_element_values[introspection.extractors.pressure].get_function_gradients (old_old_solution,
-            scratch.old_old_pressure_gradients);
-
-
-        scratch.old_field_values = (advection_field.is_temperature()
-                                    ?
-                                    scratch.old_temperature_values
-                                    :
-                                    scratch.old_composition_values[advection_field.compositional_variable]);
-        scratch.old_old_field_values = (advection_field.is_temperature()
-                                        ?
-                                        scratch.old_old_temperature_values
-                                        :
-                                        scratch.old_old_composition_values[advection_field.compositional_variable]);
-
-        scratch.finite_element_values[solution_field].get_function_gradients (old_solution,
-                                                                              scratch.old_field_grads);
-        scratch.finite_element_values[solution_field].get_function_gradients (old_old_solution,
-                                                                              scratch.old_old_field_grads);
-
-        if (update_flags & update_hessians)
-          {
-            scratch.finite_element_values[solution_field].get_function_laplacians (old_solution,
-                                                                                   scratch.old_field_laplacians);
-            scratch.finite_element_values[solution_field].get_function_laplacians (old_old_solution,
-                                                                                   scratch.old_old_field_laplacians);
-          }
+      for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
+        {
+          scratch.finite_element_values[introspection.extractors.compositional_fields[c]].get_function_values(old_solution,
+              scratch.old_composition_values[c]);
+          scratch.finite_element_values[introspection.extractors.compositional_fields[c]].get_function_values(old_old_solution,
+              scratch.old_old_composition_values[c]);
+        }
 
-        if (parameters.include_melt_transport && melt_handler->is_porosity(advection_field))
-          {
-            scratch.finite_element_values[introspection.extractors.velocities].get_function_divergences (current_linearization_point,
-                scratch.current_velocity_divergences);
-          }
+      scratch.finite_element_values[introspection.extractors.velocities].get_function_values (old_solution,
+          scratch.old_velocity_values);
+      scratch.finite_element_values[introspection.extractors.velocities].get_function_values (old_old_solution,
+          scratch.old_old_velocity_values);
+      scratch.finite_element_values[introspection.extractors.velocities].get_function_values(current_linearization_point,
+          scratch.current_velocity_values);
+
+      scratch.finite_element_values[introspection.extractors.pressure].get_function_gradients (old_solution,
+          scratch.old_pressure_gradients);
+      scratch.finite_element_values[introspection.extractors.pressure].get_function_gradients (old_old_solution,
+          scratch.old_old_pressure_gradients);
+
+
+      scratch.old_field_values = (advection_field.is_temperature()
+                                  ?
+                                  scratch.old_temperature_values
+                                  :
+                                  scratch.old_composition_values[advection_field.compositional_variable]);
+      scratch.old_old_field_values = (advection_field.is_temperature()
+                                      ?
+                                      scratch.old_old_temperature_values
+                                      :
+                                      scratch.old_old_composition_values[advection_field.compositional_variable]);
+
+      scratch.finite_element_values[solution_field].get_function_gradients (old_solution,
+                                                                            scratch.old_field_grads);
+      scratch.finite_element_values[solution_field].get_function_gradients (old_old_solution,
+                                                                            scratch.old_old_field_grads);
+
+      if (update_flags & update_hessians)
+        {
+          scratch.finite_element_values[solution_field].get_function_laplacians (old_solution,
+                                                                                 scratch.old_field_laplacians);
+          scratch.finite_element_values[solution_field].get_function_laplacians (old_old_solution,
+                                                                                 scratch.old_old_field_laplacians);
+        }
 
-        /**
-         * Explicit material model inputs and outputs.
-         */
-        for (unsigned int q=0; q<n_q_points; ++q)
-          {
-            scratch.material_model_inputs.temperature[q] = (scratch.old_temperature_values[q] + scratch.old_old_temperature_values[q]) / 2;
-            scratch.material_model_inputs.position[q] = scratch.finite_element_values.quadrature_point(q);
-            scratch.material_model_inputs.pressure[q] = (scratch.old_pressure[q] + scratch.old_old_pressure[q]) / 2;
-            scratch.material_model_inputs.velocity[q] = (scratch.old_velocity_values[q] + scratch.old_old_velocity_values[q]) / 2;
-            scratch.material_model_inputs.pressure_gradient[q] = (scratch.old_pressure_gradients[q] + scratch.old_old_pressure_gradients[q]) / 2;
-
-            for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
-              scratch.material_model_inputs.composition[q][c] = (scratch.old_composition_values[c][q] + scratch.old_old_composition_values[c][q]) / 2;
-            scratch.material_model_inputs.strain_rate[q] = (scratch.old_strain_rates[q] + scratch.old_old_strain_rates[q]) / 2;
-          }
-        scratch.material_model_inputs.current_cell = cell;
-
-        for (unsigned int i=0; i<assemblers->advection_system.size(); ++i)
-          assemblers->advection_system[i]->create_additional_material_model_outputs(scratch.material_model_outputs);
-        heating_model_manager.create_additional_material_model_inputs_and_outputs(scratch.material_model_inputs,
-                                                                                  scratch.material_model_outputs);
-
-        material_model->fill_additional_material_model_inputs(scratch.material_model_inputs,
-                                                              solution,
-                                                              scratch.finite_element_values,
-                                                              introspection);
-        material_model->evaluate(scratch.material_model_inputs,scratch.material_model_outputs);
-        heating_model_manager.evaluate(scratch.material_model_inputs,scratch.material_model_outputs,scratch.heating_model_outputs);
-
-        if (parameters.formulation_temperature_equation
-            == Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
-          {
-            // Overwrite the density by the reference density coming from the
-            // adiabatic conditions as required by the formulation
-            for (unsigned int q=0; q<n_q_points; ++q)
-              scratch.material_model_outputs.densities[q] = adiabatic_conditions->density(scratch.material_model_inputs.position[q]);
-          }
-        else if (parameters.formulation_temperature_equation
-                 == Parameters<dim>::Formulation::TemperatureEquation::real_density)
-          {
-            // use real density
-          }
-        else
-          AssertThrow(false, ExcNotImplemented());
+      if (parameters.include_melt_transport && melt_handler->is_porosity(advection_field))
+        {
+          scratch.finite_element_values[introspection.extractors.velocities].get_function_divergences (current_linearization_point,
+              scratch.current_velocity_divergences);
+        }
 
-        MaterialModel::MaterialAveraging::average (parameters.material_averaging,
-                                                   cell,
-                                                   scratch.finite_element_values.get_quadrature(),
-                                                   scratch.finite_element_values.get_mapping(),
-                                                   scratch.material_model_outputs);
+      /**
+       * Explicit material model inputs and outputs.
+       */
+      for (unsigned int q=0; q<n_q_points; ++q)
+        {
+          scratch.material_model_inputs.temperature[q] = (scratch.old_temperature_values[q] + scratch.old_old_temperature_values[q]) / 2;
+          scratch.material_model_inputs.position[q] = scratch.finite_element_values.quadrature_point(q);
+          scratch.material_model_inputs.pressure[q] = (scratch.old_pressure[q] + scratch.old_old_pressure[q]) / 2;
+          scratch.material_model_inputs.velocity[q] = (scratch.old_velocity_values[q] + scratch.old_old_velocity_values[q]) / 2;
+          scratch.material_model_inputs.pressure_gradient[q] = (scratch.old_pressure_gradients[q] + scratch.old_old_pressure_gradients[q]) / 2;
+
+          for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
+            scratch.material_model_inputs.composition[q][c] = (scratch.old_composition_values[c][q] + scratch.old_old_composition_values[c][q]) / 2;
+          scratch.material_model_inputs.strain_rate[q] = (scratch.old_strain_rates[q] + scratch.old_old_strain_rates[q]) / 2;
+        }
+      scratch.material_model_inputs.current_cell = cell;
+
+      for (unsigned int i=0; i<assemblers->advection_system.size(); ++i)
+        assemblers->advection_system[i]->create_additional_material_model_outputs(scratch.material_model_outputs);
+      heating_model_manager.create_additional_material_model_inputs_and_outputs(scratch.material_model_inputs,
+                                                                                scratch.material_model_outputs);
+
+      material_model->fill_additional_material_model_inputs(scratch.material_model_inputs,
+                                                            solution,
+                                                            scratch.finite_element_values,
+                                                            introspection);
+      material_model->evaluate(scratch.material_model_inputs,scratch.material_model_outputs);
+      heating_model_manager.evaluate(scratch.material_model_inputs,scratch.material_model_outputs,scratch.heating_model_outputs);
+
+      if (parameters.formulation_temperature_equation
+          == Parameters<dim>::Formulation::TemperatureEquation::reference_density_profile)
+        {
+          // Overwrite the density by the reference density coming from the
+          // adiabatic conditions as required by the formulation
+          for (unsigned int q=0; q<n_q_points; ++q)
+            scratch.material_model_outputs.densities[q] = adiabatic_conditions->density(scratch.material_model_inputs.position[q]);
+        }
+      else if (parameters.formulation_temperature_equation
+               == Parameters<dim>::Formulation::TemperatureEquation::real_density)
+        {
+          // use real density
+        }
+      else
+        AssertThrow(false, ExcNotImplemented());
 
-        if (parameters.advection_stabilization_method == Parameters<dim>::AdvectionStabilizationMethod::entropy_viscosity)
-          {
-            viscosity_per_cell[cell->active_cell_index()] = compute_viscosity(scratch,
-                                                                              global_max_velocity,
-                                                                              global_field_range.second - global_field_range.first,
-                                                                              0.5 * (global_field_range.second + global_field_range.first),
-                                                                              global_entropy_variation,
-                                                                              cell->diameter(),
-                                                                              advection_field);
-          }
-        else if (parameters.advection_stabilization_method == Parameters<dim>::AdvectionStabilizationMethod::supg)
-          {
-            double norm_of_advection_term = 0.0;
-            double max_conductivity_on_cell = 0.0;
+      MaterialModel::MaterialAveraging::average (parameters.material_averaging,
+                                                 cell,
+                                                 scratch.finite_element_values.get_quadrature(),
+                                                 scratch.finite_element_values.get_mapping(),
+                                                 scratch.material_model_outputs);
 
-            {
-              for (unsigned int q=0; q<n_q_points; ++q)
-                {
-                  if (advection_field.is_temperature())
-                    {
-                      norm_of_advection_term =
-                        std::max(scratch.current_velocity_values[q].norm()*
-                                 (scratch.material_model_outputs.densities[q] *
-                                  scratch.material_model_outputs.specific_heat[q] +
-                                  scratch.heating_model_outputs.lhs_latent_heat_terms[q]),
-                                 norm_of_advection_term);
-
-                      max_conductivity_on_cell =
-                        std::max(scratch.material_model_outputs.thermal_conductivities[q],max_conductivity_on_cell);
-                    }
-                  else
-                    {
-                      norm_of_advection_term =
-                        std::max(scratch.current_velocity_values[q].norm(),norm_of_advection_term);
-
-                      max_conductivity_on_cell = 0.0;
-                    }
-                }
-            }
+      if (parameters.advection_stabilization_method == Parameters<dim>::AdvectionStabilizationMethod::entropy_viscosity)
+        {
+          data.second = compute_viscosity(scratch,
+                                          global_max_velocity,
+                                          global_field_range.second - global_field_range.first,
+                                          0.5 * (global_field_range.second + global_field_range.first),
+                                          global_entropy_variation,
+                                          cell->diameter(),
+                                          advection_field);
+        }
+      else if (parameters.advection_stabilization_method == Parameters<dim>::AdvectionStabilizationMethod::supg)
+        {
+          double norm_of_advection_term = 0.0;
+          double max_conductivity_on_cell = 0.0;
 
-            const double fe_order
-              = (advection_field.is_temperature()
-                 ?
-                 parameters.temperature_degree
-                 :
-                 parameters.composition_degree
-                );
-            const double h = cell->diameter();
-            const double eps = max_conductivity_on_cell;
-
-            // SUPG parameter design from "On Discontinuity-Capturing Methods
-            // for Convection-Diffusion Equations" by Volker John and Petr
-            // Knobloch. Also see deal.II step-63:
-            // delta_k = h / (2 \|u\| k) * (coth(Pe) - 1/Pe)
-            // Pe = \| u \| h/(2 p eps)
-            const double peclet_times_eps = norm_of_advection_term * h / (2.0 * fe_order);
-
-            // Instead of Pe < 1, we check Pe*eps < eps as eps can be ==0:
-            if (peclet_times_eps==0.0 || peclet_times_eps < eps)
-              {
-                // Diffusion dominant case, no stabilization needed:
-                viscosity_per_cell[cell->active_cell_index()] = 0.0;
-              }
-            else
+          {
+            for (unsigned int q=0; q<n_q_points; ++q)
               {
-                // To avoid a division by zero, increase eps slightly. The actual value is not
-                // important, as long as the result is still a valid number. Note that this
-                // is only important if \|u\| and eps are zero.
-                const double peclet = peclet_times_eps / (eps + 1e-100);
-                const double coth_of_peclet = (1.0 + exp(-2.0*peclet)) / (1.0 - exp(-2.0*peclet));
-                const double delta = h/(2.0*norm_of_advection_term*fe_order) * (coth_of_peclet - 1.0/peclet);
-                viscosity_per_cell[cell->active_cell_index()] = delta;
+                if (advection_field.is_temperature())
+                  {
+                    norm_of_advection_term =
+                      std::max(scratch.current_velocity_values[q].norm()*
+                               (scratch.material_model_outputs.densities[q] *
+                                scratch.material_model_outputs.specific_heat[q] +
+                                scratch.heating_model_outputs.lhs_latent_heat_terms[q]),
+                               norm_of_advection_term);
+
+                    max_conductivity_on_cell =
+                      std::max(scratch.material_model_outputs.thermal_conductivities[q],max_conductivity_on_cell);
+                  }
+                else
+                  {
+                    norm_of_advection_term =
+                      std::max(scratch.current_velocity_values[q].norm(),norm_of_advection_term);
+
+                    max_conductivity_on_cell = 0.0;
+                  }
               }
-            Assert (viscosity_per_cell[cell->active_cell_index()] >= 0, ExcMessage ("tau for SUPG needs to be a nonnegative constant."));
           }
-        else
-          AssertThrow(false, ExcNotImplemented());
-      }
+
+          const double fe_order
+            = (advection_field.is_temperature()
+               ?
+               parameters.temperature_degree
+               :
+               parameters.composition_degree
+              );
+          const double h = cell->diameter();
+          const double eps = max_conductivity_on_cell;
+
+          // SUPG parameter design from "On Discontinuity-Capturing Methods
+          // for Convection-Diffusion Equations" by Volker John and Petr
+          // Knobloch. Also see deal.II step-63:
+          // delta_k = h / (2 \|u\| k) * (coth(Pe) - 1/Pe)
+          // Pe = \| u \| h/(2 p eps)
+          const double peclet_times_eps = norm_of_advection_term * h / (2.0 * fe_order);
+
+          // Instead of Pe < 1, we check Pe*eps < eps as eps can be ==0:
+          if (peclet_times_eps==0.0 || peclet_times_eps < eps)
+            {
+              // Diffusion dominant case, no stabilization needed:
+              data.second = 0.0;
+            }
+          else
+            {
+              // To avoid a division by zero, increase eps slightly. The actual value is not
+              // important, as long as the result is still a valid number. Note that this
+              // is only important if \|u\| and eps are zero.
+              const double peclet = peclet_times_eps / (eps + 1e-100);
+              const double coth_of_peclet = (1.0 + exp(-2.0*peclet)) / (1.0 - exp(-2.0*peclet));
+              const double delta = h/(2.0*norm_of_advection_term*fe_order) * (coth_of_peclet - 1.0/peclet);
+              data.second = delta;
+            }
+          Assert (data.second >= 0, ExcMessage ("tau for SUPG needs to be a nonnegative constant."));
+        }
+      else
+        AssertThrow(false, ExcNotImplemented());
+    };
+
+    auto copier = [&](const std::pair<unsigned int,T> &data)
+    {
+      viscosity_per_cell[data.first] = data.second;
+    };
+
+    WorkStream::
+    run (dof_handler.begin_active(),
+         dof_handler.end(),
+         worker,
+         copier,
+         internal::Assembly::Scratch::
+         AdvectionSystem<dim> (finite_element,
+                               finite_element.base_element(advection_field.base_element(introspection)),
+                               *mapping,
+                               QGauss<dim>(advection_field.polynomial_degree(introspection)
+                                           +
+                                           (parameters.stokes_velocity_degree+1)/2),
+                               QTrapez<dim-1> (),
+                               update_flags,
+                               face_update_flags,
+                               introspection.n_compositional_fields,
+                               advection_field),
+         std::pair<unsigned int,T> ());
 
     // if set to true, the maximum of the artificial viscosity in the cell as well
     // as the neighbors of the cell is computed and used instead
@@ -660,6 +679,38 @@ namespace aspect
             }
       }
   }
+
+
+
+  template <int dim>
+  const Vector<double> &
+  Simulator<dim>::get_cached_artificial_viscosity (const AdvectionField &advection_field)
+  {
+    // The entropy viscosity only depends on the solution of the previous
+    // time steps, so we only need to compute it once per time step. The
+    // SUPG parameter, and the entropy viscosity of the porosity field in
+    // models with melt transport, also depend on the current velocity,
+    // which changes between nonlinear iterations.
+    const bool viscosity_depends_on_current_solution
+      = (parameters.advection_stabilization_method
+         != Parameters<dim>::AdvectionStabilizationMethod::entropy_viscosity)
+        ||
+        (parameters.include_melt_transport && melt_handler->is_porosity(advection_field));
+
+    const unsigned int field_index = advection_field.field_index();
+    if (viscosity_depends_on_current_solution == false)
+      {
+        const auto cached_viscosity = artificial_viscosity_cache.find(field_index);
+        if (cached_viscosity != artificial_viscosity_cache.end())
+          return cached_viscosity->second;
+      }
+
+    Vector<double> &viscosity_per_cell = artificial_viscosity_cache[field_index];
+    viscosity_per_cell.reinit(triangulation.n_active_cells());
+    get_artificial_viscosity(viscosity_per_cell, advection_field);
+
+    return viscosity_per_cell;
+  }
 }
 
 
@@ -673,6 +724,7 @@ namespace aspect
   template void Simulator<dim>::get_artificial_viscosity (Vector<float> &viscosity_per_cell,  \
                                                           const AdvectionField &advection_field, \
                                                           const bool skip_interior_cells) const; \
+  template const Vector<double> &Simulator<dim>::get_cached_artificial_viscosity (const AdvectionField &advection_field); \
 
 
   ASPECT_INSTANTIATE(INSTANTIATE)
@@ -36,11 +36,14 @@
 #include <aspect/postprocess/visualization.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/work_stream.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/filtered_iterator.h>
 
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_accessor.h>
@@ -51,15 +54,70 @@
 #include <deal.II/fe/fe_dgp.h>
 #include <deal.II/fe/fe_values.h>
 
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iomanip>
 #include <locale>
+#include <set>
 #include <string>
 
 
 namespace aspect
 {
+  namespace internal
+  {
+    unsigned int
+    StatisticsTable::n_columns () const
+    {
+      return column_order.size();
+    }
+
+
+
+    void
+    StatisticsTable::write_text_rows (std::ostream &out,
+                                      const unsigned int first_column,
+                                      const unsigned int first_row) const
+    {
+      for (unsigned int j=first_column; j<column_order.size(); ++j)
+        out << "# " << j+1 << ": " << column_order[j] << '\n';
+
+      const unsigned int n_rows = this->n_rows();
+      for (unsigned int i=first_row; i<n_rows; ++i)
+        {
+          for (unsigned int j=0; j<column_order.size(); ++j)
+            {
+              if (j > 0)
+                out << ' ';
+
+              // Columns are filled automatically, but the last row may not
+              // yet have an entry in every column. Like TableHandler does,
+              // write empty strings as "" to keep the number of entries per
+              // row intact.
+              const Column &column = columns.find(column_order[j])->second;
+              if (i < column.entries.size())
+                {
+                  column.entries[i].cache_string(column.scientific, column.precision);
+                  const std::string &entry = column.entries[i].get_cached_string();
+                  if (entry.size() > 0)
+                    out << entry;
+                  else
+                    out << "\"\"";
+                }
+              else
+                out << "\"\"";
+            }
+          out << '\n';
+        }
+    }
+  }
+
+
 
   template <int dim>
   Simulator<dim>::AdvectionField::
@@ -266,6 +324,37 @@ namespace aspect
     // step on each other's feet.
     output_statistics_thread.join();
 
+    if (parameters.append_only_statistics)
+      {
+        // Only format the rows (and the descriptions of the columns) that
+        // were added since the last time we got here, and append them to
+        // the file. If we have not written anything yet, which is also
+        // the case after restarting from a checkpoint, replace whatever
+        // is in the file (see the discussion of 'write_everything' below).
+        const bool write_everything = (statistics_rows_written == 0);
+
+        std::ostringstream stream;
+        statistics.write_text_rows (stream,
+                                    statistics_columns_written,
+                                    statistics_rows_written);
+        statistics_columns_written = statistics.n_columns();
+        statistics_rows_written = statistics.n_rows();
+
+        const std::shared_ptr<const std::string> new_contents
+          = std::make_shared<const std::string> (stream.str());
+        const std::string stat_file_name = parameters.output_directory + "statistics";
+
+        output_statistics_thread = Threads::new_thread ([new_contents, write_everything, stat_file_name]()
+        {
+          std::ofstream stat_file (stat_file_name,
+                                   write_everything ?
+                                   std::ios::out | std::ios::trunc :
+                                   std::ios::out | std::ios::app);
+          stat_file << *new_contents;
+        });
+        return;
+      }
+
     // TODO[C++14]: The following code could be made significantly simpler
     // if we could just copy the statistics table as part of the capture
     // list of the lambda function. In C++14, this would then simply be
@@ -425,6 +514,42 @@ namespace aspect
 
 
 
+  template <int dim>
+  double
+  Simulator<dim>::
+  get_maximal_speed_over_meshsize (const LinearAlgebra::BlockVector &solution) const
+  {
+    // use the same quadrature formula as get_maximal_velocity()
+    const QIterated<dim> quadrature_formula (QTrapez<1>(),
+                                             parameters.stokes_velocity_degree);
+    const unsigned int n_q_points = quadrature_formula.size();
+
+    FEValues<dim> fe_values (*mapping, finite_element, quadrature_formula, update_values);
+    std::vector<Tensor<1,dim> > velocity_values(n_q_points);
+
+    double max_local_speed_over_meshsize = 0;
+
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit (cell);
+          fe_values[introspection.extractors.velocities].get_function_values (solution,
+                                                                              velocity_values);
+
+          double max_cell_velocity = 0;
+          for (unsigned int q=0; q<n_q_points; ++q)
+            max_cell_velocity = std::max (max_cell_velocity,
+                                          velocity_values[q].norm());
+
+          max_local_speed_over_meshsize = std::max (max_local_speed_over_meshsize,
+                                                    max_cell_velocity / cell->minimum_vertex_distance());
+        }
+
+    return Utilities::MPI::max (max_local_speed_over_meshsize, mpi_communicator);
+  }
+
+
+
   template <int dim>
   bool Simulator<dim>::maybe_do_initial_refinement (const unsigned int max_refinement_level)
   {
@@ -480,6 +605,21 @@ namespace aspect
             .erase (parameters.additional_refinement_times.begin());
           }
       }
+    // if the refinement interval is adapted to the flow, see if the
+    // fastest features will have moved far enough relative to the
+    // cell size by the end of the next time step
+    else if (parameters.adapt_refinement_interval_to_flow)
+      {
+        if (parameters.adaptive_refinement_interval > 0)
+          {
+            cells_advected_since_last_refinement += new_time_step * get_maximal_speed_over_meshsize (solution);
+
+            if (timestep_number >= last_refinement_timestep_number + parameters.adaptive_refinement_interval
+                &&
+                cells_advected_since_last_refinement >= parameters.cell_advection_between_refinements)
+              refine_mesh (max_refinement_level);
+          }
+      }
     // see if this is a time step where regular refinement is requested
     else if ((timestep_number > 0
               &&
@@ -509,6 +649,194 @@ namespace aspect
     // if requested output a summary of the current timing information
     if (write_timing_output)
       computing_timer.print_summary ();
+
+    if (parameters.detailed_timing_output)
+      write_detailed_timing_output ();
+  }
+
+
+
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * One node in the tree of timer sections that is written by
+       * Simulator::write_detailed_timing_output(). Sections with names of the
+       * form "Section: Subsection" become children of the node for
+       * "Section".
+       */
+      struct TimingNode
+      {
+        TimingNode ()
+          :
+          has_data (false),
+          n_calls (0)
+        {}
+
+        bool has_data;
+        double n_calls;
+        Utilities::MPI::MinMaxAvg wall_time;
+        std::map<std::string, TimingNode> subsections;
+      };
+
+
+
+      std::string
+      json_escape (const std::string &text)
+      {
+        std::string escaped;
+        for (const char c : text)
+          {
+            if (c == '"' || c == '\\')
+              escaped += '\\';
+            escaped += c;
+          }
+        return escaped;
+      }
+
+
+
+      void
+      write_timing_node (std::ostream &out,
+                         const TimingNode &node)
+      {
+        out << '{';
+        bool first_entry = true;
+        if (node.has_data)
+          {
+            out << "\"calls\": " << node.n_calls
+                << ", \"wall time\": {\"min\": " << node.wall_time.min
+                << ", \"avg\": " << node.wall_time.avg
+                << ", \"max\": " << node.wall_time.max
+                << ", \"min rank\": " << node.wall_time.min_index
+                << ", \"max rank\": " << node.wall_time.max_index
+                << '}';
+            first_entry = false;
+          }
+
+        if (node.subsections.size() > 0)
+          {
+            if (!first_entry)
+              out << ", ";
+            out << "\"subsections\": {";
+            for (auto child = node.subsections.begin(); child != node.subsections.end(); ++child)
+              {
+                if (child != node.subsections.begin())
+                  out << ", ";
+                out << '"' << json_escape(child->first) << "\": ";
+                write_timing_node (out, child->second);
+              }
+            out << '}';
+          }
+        out << '}';
+      }
+    }
+  }
+
+
+
+  template <int dim>
+  void Simulator<dim>::write_detailed_timing_output () const
+  {
+    // Start a new file the first time this function is called in this run,
+    // unless we continue a previous computation
+    const bool start_new_file = (last_detailed_timing_data.empty()
+                                 && parameters.resume_computation == false);
+
+    std::map<std::string, double> wall_times
+      = computing_timer.get_summary_data (TimerOutput::total_wall_time);
+    std::map<std::string, double> n_calls
+      = computing_timer.get_summary_data (TimerOutput::n_calls);
+
+    // Add the parts of threaded cell loops, which are not timed by the
+    // computing timer. Every thread has accumulated its own times; no cell
+    // loop is running at this point, so we can simply add them up.
+    const auto add_worker_timing = [&](const std::map<std::string, std::pair<double,double> > &thread_data)
+    {
+      for (const auto &section : thread_data)
+        {
+          wall_times[section.first] += section.second.first;
+          n_calls[section.first] += section.second.second;
+        }
+    };
+#ifdef DEAL_II_WITH_THREADS
+    for (const auto &thread_data : detailed_worker_timing_data.get_implementation())
+      add_worker_timing (thread_data);
+#else
+    add_worker_timing (detailed_worker_timing_data.get());
+#endif
+
+    // Not every process necessarily enters every section, but the reduction
+    // below needs to happen for the same sections on all processes. Use the
+    // union of the section names of all processes.
+    std::vector<std::string> local_section_names;
+    for (const auto &section : wall_times)
+      local_section_names.push_back (section.first);
+
+    std::set<std::string> section_names;
+    for (const auto &names : dealii::Utilities::MPI::all_gather (mpi_communicator, local_section_names))
+      section_names.insert (names.begin(), names.end());
+
+    // Compute the time spent in each section since the last call,
+    // reduce it over all processes, and sort it into a tree
+    internal::TimingNode root;
+    for (const auto &name : section_names)
+      {
+        const auto wall_time = wall_times.find(name);
+        const auto calls = n_calls.find(name);
+        const std::pair<double,double> current_data
+          = (wall_time != wall_times.end()
+             ?
+             std::make_pair (wall_time->second, calls->second)
+             :
+             std::make_pair (0., 0.));
+
+        std::pair<double,double> &last_data = last_detailed_timing_data[name];
+        const double local_wall_time = current_data.first - last_data.first;
+        const double local_n_calls = current_data.second - last_data.second;
+        last_data = current_data;
+
+        internal::TimingNode *node = &root;
+        for (const auto &part : dealii::Utilities::split_string_list (name, ':'))
+          node = &node->subsections[part];
+
+        node->has_data = true;
+        node->wall_time = dealii::Utilities::MPI::min_max_avg (local_wall_time, mpi_communicator);
+        node->n_calls = dealii::Utilities::MPI::max (local_n_calls, mpi_communicator);
+      }
+
+    if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
+      return;
+
+    const std::string filename = parameters.output_directory + "timing.jsonl";
+    std::ofstream out (filename.c_str(),
+                       start_new_file ? std::ios::out : std::ios::app);
+    AssertThrow (out,
+                 ExcMessage (std::string("Could not open file <") + filename + ">."));
+
+    out << std::setprecision(6)
+        << "{\"timestep\": " << timestep_number
+        << ", \"time\": " << time
+        << ", \"sections\": ";
+    internal::write_timing_node (out, root);
+    out << "}\n";
+  }
+
+
+
+  template <int dim>
+  void Simulator<dim>::add_detailed_worker_timing (const char *section_name,
+                                                   const std::chrono::steady_clock::time_point &start_time) const
+  {
+    if (parameters.detailed_timing_output == false)
+      return;
+
+    const double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::pair<double,double> &data = detailed_worker_timing_data.get()[section_name];
+    data.first += wall_time;
+    data.second += 1;
   }
 
 
@@ -1471,6 +1799,322 @@ namespace aspect
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * The scratch object for the loop over all cells in
+       * Simulator::compute_reactions(). It stores the finite element values
+       * and the material and heating model inputs and outputs at the support
+       * points of the composition and the temperature element.
+       */
+      template <int dim>
+      struct ReactionScratchData
+      {
+        ReactionScratchData (const Mapping<dim> &mapping,
+                             const FiniteElement<dim> &fe,
+                             const Quadrature<dim> &quadrature_C,
+                             const Quadrature<dim> &quadrature_T,
+                             const unsigned int n_compositional_fields,
+                             const MaterialModel::Interface<dim> &material_model,
+                             const HeatingModel::Manager<dim> &heating_model_manager);
+
+        ReactionScratchData (const ReactionScratchData &scratch);
+
+        /**
+         * Attach the reaction rate outputs and the additional inputs and
+         * outputs the heating models require to the material model inputs
+         * and outputs.
+         */
+        void create_additional_inputs_and_outputs ();
+
+        FEValues<dim> fe_values_C;
+        FEValues<dim> fe_values_T;
+        std::vector<types::global_dof_index> local_dof_indices;
+        const unsigned int n_compositional_fields;
+
+        MaterialModel::MaterialModelInputs<dim> in_C;
+        MaterialModel::MaterialModelOutputs<dim> out_C;
+        HeatingModel::HeatingModelOutputs heating_model_outputs_C;
+
+        MaterialModel::MaterialModelInputs<dim> in_T;
+        MaterialModel::MaterialModelOutputs<dim> out_T;
+        HeatingModel::HeatingModelOutputs heating_model_outputs_T;
+
+        const MaterialModel::Interface<dim> &material_model;
+        const HeatingModel::Manager<dim> &heating_model_manager;
+      };
+
+
+
+      template <int dim>
+      ReactionScratchData<dim>::
+      ReactionScratchData (const Mapping<dim> &mapping,
+                           const FiniteElement<dim> &fe,
+                           const Quadrature<dim> &quadrature_C,
+                           const Quadrature<dim> &quadrature_T,
+                           const unsigned int n_compositional_fields,
+                           const MaterialModel::Interface<dim> &material_model,
+                           const HeatingModel::Manager<dim> &heating_model_manager)
+        :
+        fe_values_C (mapping, fe, quadrature_C,
+                     update_quadrature_points | update_values | update_gradients),
+        fe_values_T (mapping, fe, quadrature_T,
+                     update_quadrature_points | update_values | update_gradients),
+        local_dof_indices (fe.dofs_per_cell),
+        n_compositional_fields (n_compositional_fields),
+        in_C (quadrature_C.size(), n_compositional_fields),
+        out_C (quadrature_C.size(), n_compositional_fields),
+        heating_model_outputs_C (quadrature_C.size(), n_compositional_fields),
+        in_T (quadrature_T.size(), n_compositional_fields),
+        out_T (quadrature_T.size(), n_compositional_fields),
+        heating_model_outputs_T (quadrature_T.size(), n_compositional_fields),
+        material_model (material_model),
+        heating_model_manager (heating_model_manager)
+      {
+        create_additional_inputs_and_outputs ();
+      }
+
+
+
+      template <int dim>
+      ReactionScratchData<dim>::
+      ReactionScratchData (const ReactionScratchData &scratch)
+        :
+        fe_values_C (scratch.fe_values_C.get_mapping(),
+                     scratch.fe_values_C.get_fe(),
+                     scratch.fe_values_C.get_quadrature(),
+                     scratch.fe_values_C.get_update_flags()),
+        fe_values_T (scratch.fe_values_T.get_mapping(),
+                     scratch.fe_values_T.get_fe(),
+                     scratch.fe_values_T.get_quadrature(),
+                     scratch.fe_values_T.get_update_flags()),
+        local_dof_indices (scratch.local_dof_indices),
+        n_compositional_fields (scratch.n_compositional_fields),
+        in_C (scratch.fe_values_C.n_quadrature_points, n_compositional_fields),
+        out_C (scratch.fe_values_C.n_quadrature_points, n_compositional_fields),
+        heating_model_outputs_C (scratch.fe_values_C.n_quadrature_points, n_compositional_fields),
+        in_T (scratch.fe_values_T.n_quadrature_points, n_compositional_fields),
+        out_T (scratch.fe_values_T.n_quadrature_points, n_compositional_fields),
+        heating_model_outputs_T (scratch.fe_values_T.n_quadrature_points, n_compositional_fields),
+        material_model (scratch.material_model),
+        heating_model_manager (scratch.heating_model_manager)
+      {
+        create_additional_inputs_and_outputs ();
+      }
+
+
+
+      template <int dim>
+      void
+      ReactionScratchData<dim>::create_additional_inputs_and_outputs ()
+      {
+        // add reaction rate outputs
+        material_model.create_additional_named_outputs(out_C);
+        material_model.create_additional_named_outputs(out_T);
+
+        // some heating models require the additional outputs
+        heating_model_manager.create_additional_material_model_inputs_and_outputs(in_C, out_C);
+        heating_model_manager.create_additional_material_model_inputs_and_outputs(in_T, out_T);
+      }
+
+
+
+      /**
+       * The copy object for the loop over all cells in
+       * Simulator::compute_reactions(). It stores the new values and the
+       * accumulated reactions of all locally owned temperature and
+       * composition degrees of freedom of one cell, together with the number
+       * of reaction substeps that were necessary on this cell.
+       */
+      struct ReactionCopyData
+      {
+        std::vector<types::global_dof_index> dof_indices;
+        std::vector<double> new_values;
+        std::vector<double> reactions;
+
+        unsigned int n_substeps = 0;
+        unsigned int n_rejected_substeps = 0;
+      };
+
+
+
+      /**
+       * Integrate the reaction equations for the temperature and all
+       * compositional fields in all evaluation points of @p in from time zero
+       * to @p time_step, using the embedded pair of the explicit Euler and the
+       * Heun method to estimate the local error of every step. Every
+       * evaluation point is integrated with its own sequence of step sizes:
+       * A step is accepted if the error of all values in this point, measured
+       * relative to the maximum of 1 and the magnitude of the value, is below
+       * @p tolerance, and the size of the next step in this point is chosen
+       * from its own error estimate. The first step has the size
+       * @p initial_step_size in every point.
+       *
+       * Because the reaction rates in one point only depend on the values in
+       * this point, the result in a point is therefore independent of the
+       * other points of the cell. This is necessary because degrees of
+       * freedom on the interface between cells are integrated once for every
+       * adjacent cell, and all of these computations have to yield the same
+       * value. The material model is still evaluated for all points at once;
+       * points that have already reached the end of the interval take steps
+       * of size zero.
+       *
+       * @p evaluate_rates needs to fill @p reaction_rate_outputs and
+       * @p heating_model_outputs with the rates of change for the current
+       * values in @p in. On return, @p in contains the values at the end of
+       * the interval. The function returns the largest number of accepted
+       * steps of any point and adds the number of rejected steps of all
+       * points to @p n_rejected_steps.
+       */
+      template <int dim>
+      unsigned int
+      integrate_reactions_adaptively (const std::function<void ()> &evaluate_rates,
+                                      MaterialModel::MaterialModelInputs<dim> &in,
+                                      const MaterialModel::ReactionRateOutputs<dim> &reaction_rate_outputs,
+                                      const HeatingModel::HeatingModelOutputs &heating_model_outputs,
+                                      const double time_step,
+                                      const double initial_step_size,
+                                      const double tolerance,
+                                      unsigned int &n_rejected_steps)
+      {
+        const unsigned int n_points = in.n_evaluation_points();
+        const unsigned int n_fields = (n_points > 0 ? in.composition[0].size() : 0);
+        const unsigned int n_values = n_fields + 1;
+
+        // Store temperature and compositions of all points in one vector
+        // each for the current values, the rates at the beginning of the
+        // step, the rates at the Euler predictor, and the new values.
+        std::vector<double> values (n_points * n_values);
+        std::vector<double> rates (n_points * n_values);
+        std::vector<double> predictor_rates (n_points * n_values);
+        std::vector<double> new_values (n_points * n_values);
+
+        const auto get_values = [&](std::vector<double> &v)
+        {
+          for (unsigned int j=0; j<n_points; ++j)
+            {
+              v[j*n_values] = in.temperature[j];
+              for (unsigned int c=0; c<n_fields; ++c)
+                v[j*n_values+1+c] = in.composition[j][c];
+            }
+        };
+
+        const auto set_values = [&](const std::vector<double> &v)
+        {
+          for (unsigned int j=0; j<n_points; ++j)
+            {
+              in.temperature[j] = v[j*n_values];
+              for (unsigned int c=0; c<n_fields; ++c)
+                in.composition[j][c] = v[j*n_values+1+c];
+            }
+        };
+
+        const auto get_rates = [&](std::vector<double> &r)
+        {
+          evaluate_rates();
+          for (unsigned int j=0; j<n_points; ++j)
+            {
+              r[j*n_values] = heating_model_outputs.rates_of_temperature_change[j];
+              for (unsigned int c=0; c<n_fields; ++c)
+                r[j*n_values+1+c] = reaction_rate_outputs.reaction_rates[j][c];
+            }
+        };
+
+        // Steps below this size are accepted regardless of their error,
+        // so that the integration always terminates.
+        const double minimum_step_size = 1e-10 * time_step;
+
+        get_values (values);
+        get_rates (rates);
+
+        // the current time, the size of the next step, and the number
+        // of accepted steps in every point
+        std::vector<double> time (n_points, 0.);
+        std::vector<double> step_size (n_points, std::min(initial_step_size, time_step));
+        std::vector<unsigned int> n_steps (n_points, 0);
+        std::vector<double> current_step_size (n_points, 0.);
+
+        unsigned int n_unfinished_points = n_points;
+
+        while (n_unfinished_points > 0)
+          {
+            // forward Euler predictor; points that are finished do not move
+            for (unsigned int j=0; j<n_points; ++j)
+              {
+                if (time[j] >= time_step)
+                  current_step_size[j] = 0.;
+                // end the last step exactly at the end of the interval
+                else if (time[j] + step_size[j] >= time_step * (1. - 1e-12))
+                  current_step_size[j] = time_step - time[j];
+                else
+                  current_step_size[j] = step_size[j];
+
+                for (unsigned int k=j*n_values; k<(j+1)*n_values; ++k)
+                  new_values[k] = values[k] + current_step_size[j] * rates[k];
+              }
+
+            set_values (new_values);
+            get_rates (predictor_rates);
+
+            for (unsigned int j=0; j<n_points; ++j)
+              {
+                if (time[j] >= time_step)
+                  continue;
+
+                const double h = current_step_size[j];
+
+                // Heun corrector; the difference to the predictor is the
+                // error estimate of the (first order) Euler step
+                double error = 0;
+                for (unsigned int k=j*n_values; k<(j+1)*n_values; ++k)
+                  {
+                    const double corrected_value = values[k] + 0.5 * h * (rates[k] + predictor_rates[k]);
+                    const double scale = std::max(1., std::max(std::abs(values[k]), std::abs(corrected_value)));
+                    error = std::max(error, std::abs(corrected_value - new_values[k]) / (tolerance * scale));
+                    new_values[k] = corrected_value;
+                  }
+
+                if (error <= 1. || h <= minimum_step_size)
+                  {
+                    for (unsigned int k=j*n_values; k<(j+1)*n_values; ++k)
+                      values[k] = new_values[k];
+
+                    time[j] = (h == time_step - time[j] ? time_step : time[j] + h);
+                    ++n_steps[j];
+
+                    if (time[j] >= time_step)
+                      --n_unfinished_points;
+                  }
+                else
+                  ++n_rejected_steps;
+
+                // the error estimate is of second order in the step size
+                const double step_size_factor = (error > 0.
+                                                 ?
+                                                 std::min(5., std::max(0.2, 0.9 / std::sqrt(error)))
+                                                 :
+                                                 5.);
+                step_size[j] = std::max(minimum_step_size, h * step_size_factor);
+              }
+
+            // The rates of points that were rejected or are finished are
+            // recomputed from unchanged values here, which yields the same
+            // rates as before.
+            set_values (values);
+            if (n_unfinished_points > 0)
+              get_rates (rates);
+          }
+
+        set_values (values);
+        return (n_points > 0 ? *std::max_element(n_steps.begin(), n_steps.end()) : 0);
+      }
+    }
+  }
+
+
+
   template <int dim>
   void Simulator<dim>::compute_reactions ()
   {
@@ -1489,7 +2133,9 @@ namespace aspect
                                                             mpi_communicator);
 
     // we use a different (potentially smaller) time step than in the advection scheme,
-    // and we want all of our reaction time steps (within one advection step) to have the same size
+    // and we want all of our reaction time steps (within one advection step) to have the same size.
+    // For the adaptive reaction solver, this is only the size of the first step in every
+    // degree of freedom.
     const unsigned int number_of_reaction_steps = std::max(static_cast<unsigned int>(time_step / parameters.reaction_time_step),
                                                            std::max(parameters.reaction_steps_per_advection_step,1U));
 
@@ -1498,64 +2144,46 @@ namespace aspect
     Assert (reaction_time_step_size > 0,
             ExcMessage("Reaction time step must be greater than 0."));
 
-    pcout << "   Solving composition reactions... " << std::flush;
+    const bool use_adaptive_reaction_solver
+      = (parameters.reaction_solver_type == Parameters<dim>::ReactionSolverType::adaptive_step);
 
-    // make one fevalues for the composition, and one for the temperature (they might use different finite elements)
-    const Quadrature<dim> quadrature_C(dof_handler.get_fe().base_element(introspection.base_elements.compositional_fields).get_unit_support_points());
+    pcout << "   Solving composition reactions... " << std::flush;
 
-    FEValues<dim> fe_values_C (*mapping,
-                               dof_handler.get_fe(),
-                               quadrature_C,
-                               update_quadrature_points | update_values | update_gradients);
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    const unsigned int composition_dofs_per_cell = fe.base_element(introspection.base_elements.compositional_fields).dofs_per_cell;
+    const unsigned int temperature_dofs_per_cell = fe.base_element(introspection.base_elements.temperature).dofs_per_cell;
 
-    std::vector<types::global_dof_index> local_dof_indices (dof_handler.get_fe().dofs_per_cell);
-    MaterialModel::MaterialModelInputs<dim> in_C(quadrature_C.size(), introspection.n_compositional_fields);
-    MaterialModel::MaterialModelOutputs<dim> out_C(quadrature_C.size(), introspection.n_compositional_fields);
-    HeatingModel::HeatingModelOutputs heating_model_outputs_C(quadrature_C.size(), introspection.n_compositional_fields);
+    // make one fevalues for the composition, and one for the temperature (they might use different finite elements)
+    const Quadrature<dim> quadrature_C(fe.base_element(introspection.base_elements.compositional_fields).get_unit_support_points());
+    const Quadrature<dim> quadrature_T(fe.base_element(introspection.base_elements.temperature).get_unit_support_points());
 
     const bool temperature_and_composition_use_same_fe =
       (parameters.use_discontinuous_composition_discretization == parameters.use_discontinuous_temperature_discretization)
       &&
       (parameters.temperature_degree == parameters.composition_degree);
 
-    // temperature element
-    const Quadrature<dim> quadrature_T(dof_handler.get_fe().base_element(introspection.base_elements.temperature).get_unit_support_points());
-
-    FEValues<dim> fe_values_T (*mapping,
-                               dof_handler.get_fe(),
-                               quadrature_T,
-                               update_quadrature_points | update_values | update_gradients);
+    const internal::ReactionScratchData<dim> scratch_data (*mapping,
+                                                           fe,
+                                                           quadrature_C,
+                                                           quadrature_T,
+                                                           introspection.n_compositional_fields,
+                                                           *material_model,
+                                                           heating_model_manager);
 
-    MaterialModel::MaterialModelInputs<dim> in_T(quadrature_T.size(), introspection.n_compositional_fields);
-    MaterialModel::MaterialModelOutputs<dim> out_T(quadrature_T.size(), introspection.n_compositional_fields);
-    HeatingModel::HeatingModelOutputs heating_model_outputs_T(quadrature_T.size(), introspection.n_compositional_fields);
-
-    // add reaction rate outputs
-    material_model->create_additional_named_outputs(out_C);
-    material_model->create_additional_named_outputs(out_T);
-
-    MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs_C
-      = out_C.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
-
-    MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs_T
-      = out_T.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
-
-    AssertThrow(reaction_rate_outputs_C != nullptr && reaction_rate_outputs_T != nullptr,
+    AssertThrow(scratch_data.out_C.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >() != nullptr
+                && scratch_data.out_T.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >() != nullptr,
                 ExcMessage("You are trying to use the operator splitting solver scheme, "
                            "but the material model you use does not support operator splitting "
                            "(it does not create ReactionRateOutputs, which are required for this "
                            "solver scheme)."));
 
-    // some heating models require the additional outputs
-    heating_model_manager.create_additional_material_model_inputs_and_outputs(in_C, out_C);
-    heating_model_manager.create_additional_material_model_inputs_and_outputs(in_T, out_T);
+    // Loop over all cells, and on every cell over all reaction time steps and all
+    // degrees of freedom to compute the reactions. This is possible because the
+    // reactions only depend on the temperature and composition values at a given
+    // degree of freedom (and are independent of the solution in other points), which
+    // also means that the cells can be worked on in parallel.
 
-    // Make a loop first over all cells, than over all reaction time steps, and then over
-    // all degrees of freedom in each element to compute the reactions. This is possible
-    // because the reactions only depend on the temperature and composition values at a given
-    // degree of freedom (and are independent of the solution in other points).
-
-    // Note that the values for some degrees of freedom are set more than once in the loop
+    // Note that the values for some degrees of freedom are set more than once in the copier
     // below where we assign the new values to distributed_vector (if they are located on the
     // interface between cells), as we loop over all cells, and then over all degrees of freedom
     // on each cell. Although this means we do some additional work, the results are still
@@ -1565,23 +2193,57 @@ namespace aspect
     // distributed_vector vector. Only after the loop over all cells do we copy distributed_vector
     // back onto the solution vector.
     // So even though we touch some DoF more than once, we always start from the same value, compute the
-    // same value, and then overwrite the same value in distributed_vector.
-    // TODO: make this more efficient.
-    for (const auto &cell : dof_handler.active_cell_iterators())
-      if (cell->is_locally_owned())
+    // same value, and then overwrite the same value in distributed_vector. For the fixed step
+    // solver, this is the case because all cells use the same step size. The adaptive solver
+    // chooses the step sizes separately for every degree of freedom, based only on the values
+    // in this degree of freedom (see internal::integrate_reactions_adaptively()), so that the
+    // sequence of steps does not depend on the cell either.
+    auto worker = [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+                      internal::ReactionScratchData<dim> &scratch,
+                      internal::ReactionCopyData &data)
+    {
+      MaterialModel::MaterialModelInputs<dim> &in_C = scratch.in_C;
+      MaterialModel::MaterialModelInputs<dim> &in_T = scratch.in_T;
+
+      const MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs_C
+        = scratch.out_C.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
+
+      const MaterialModel::ReactionRateOutputs<dim> *reaction_rate_outputs_T
+        = scratch.out_T.template get_additional_output<MaterialModel::ReactionRateOutputs<dim> >();
+
+      const auto evaluate_rates_C = [&]()
+      {
+        material_model->fill_additional_material_model_inputs(in_C, solution, scratch.fe_values_C, introspection);
+
+        material_model->evaluate(in_C, scratch.out_C);
+        heating_model_manager.evaluate(in_C, scratch.out_C, scratch.heating_model_outputs_C);
+      };
+
+      const auto evaluate_rates_T = [&]()
+      {
+        material_model->fill_additional_material_model_inputs(in_T, solution, scratch.fe_values_T, introspection);
+
+        material_model->evaluate(in_T, scratch.out_T);
+        heating_model_manager.evaluate(in_T, scratch.out_T, scratch.heating_model_outputs_T);
+      };
+
+      scratch.fe_values_C.reinit (cell);
+      in_C.reinit(scratch.fe_values_C, cell, introspection, solution);
+
+      if (temperature_and_composition_use_same_fe == false)
         {
-          fe_values_C.reinit (cell);
-          in_C.reinit(fe_values_C, cell, introspection, solution);
+          scratch.fe_values_T.reinit (cell);
+          in_T.reinit(scratch.fe_values_T, cell, introspection, solution);
+        }
 
-          if (temperature_and_composition_use_same_fe == false)
-            {
-              fe_values_T.reinit (cell);
-              in_T.reinit(fe_values_T, cell, introspection, solution);
-            }
+      std::vector<std::vector<double> > accumulated_reactions_C (quadrature_C.size(),std::vector<double> (introspection.n_compositional_fields));
+      std::vector<double> accumulated_reactions_T (quadrature_T.size());
 
-          std::vector<std::vector<double> > accumulated_reactions_C (quadrature_C.size(),std::vector<double> (introspection.n_compositional_fields));
-          std::vector<double> accumulated_reactions_T (quadrature_T.size());
+      data.n_substeps = 0;
+      data.n_rejected_substeps = 0;
 
+      if (use_adaptive_reaction_solver == false)
+        {
           // Make the reaction time steps: We have to update the values of compositional fields and the temperature.
           // Because temperature and composition might use different finite elements, we loop through their elements
           // separately, and update the temperature and the compositions for both.
@@ -1591,12 +2253,9 @@ namespace aspect
           for (unsigned int i=0; i<number_of_reaction_steps; ++i)
             {
               // Loop over composition element
-              material_model->fill_additional_material_model_inputs(in_C, solution, fe_values_C, introspection);
+              evaluate_rates_C();
 
-              material_model->evaluate(in_C, out_C);
-              heating_model_manager.evaluate(in_C, out_C, heating_model_outputs_C);
-
-              for (unsigned int j=0; j<dof_handler.get_fe().base_element(introspection.base_elements.compositional_fields).dofs_per_cell; ++j)
+              for (unsigned int j=0; j<composition_dofs_per_cell; ++j)
                 {
                   for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
                     {
@@ -1606,26 +2265,23 @@ namespace aspect
                       accumulated_reactions_C[j][c] += reaction_time_step_size * reaction_rate_outputs_C->reaction_rates[j][c];
                     }
                   in_C.temperature[j] = in_C.temperature[j]
-                                        + reaction_time_step_size * heating_model_outputs_C.rates_of_temperature_change[j];
+                                        + reaction_time_step_size * scratch.heating_model_outputs_C.rates_of_temperature_change[j];
 
                   if (temperature_and_composition_use_same_fe)
-                    accumulated_reactions_T[j] += reaction_time_step_size * heating_model_outputs_C.rates_of_temperature_change[j];
+                    accumulated_reactions_T[j] += reaction_time_step_size * scratch.heating_model_outputs_C.rates_of_temperature_change[j];
                 }
 
               if (!temperature_and_composition_use_same_fe)
                 {
                   // loop over temperature element
-                  material_model->fill_additional_material_model_inputs(in_T, solution, fe_values_T, introspection);
-
-                  material_model->evaluate(in_T, out_T);
-                  heating_model_manager.evaluate(in_T, out_T, heating_model_outputs_T);
+                  evaluate_rates_T();
 
-                  for (unsigned int j=0; j<dof_handler.get_fe().base_element(introspection.base_elements.temperature).dofs_per_cell; ++j)
+                  for (unsigned int j=0; j<temperature_dofs_per_cell; ++j)
                     {
                       // simple forward euler
                       in_T.temperature[j] = in_T.temperature[j]
-                                            + reaction_time_step_size * heating_model_outputs_T.rates_of_temperature_change[j];
-                      accumulated_reactions_T[j] += reaction_time_step_size * heating_model_outputs_T.rates_of_temperature_change[j];
+                                            + reaction_time_step_size * scratch.heating_model_outputs_T.rates_of_temperature_change[j];
+                      accumulated_reactions_T[j] += reaction_time_step_size * scratch.heating_model_outputs_T.rates_of_temperature_change[j];
 
                       for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
                         in_T.composition[j][c] = in_T.composition[j][c]
@@ -1634,43 +2290,127 @@ namespace aspect
                 }
             }
 
-          cell->get_dof_indices (local_dof_indices);
+          data.n_substeps = number_of_reaction_steps;
+        }
+      else
+        {
+          // Integrate the composition element and (if different) the temperature
+          // element separately with their own step sizes, and compute the
+          // accumulated reactions from the difference to the initial values.
+          const std::vector<double> initial_temperature_C = in_C.temperature;
+          const std::vector<std::vector<double> > initial_composition_C = in_C.composition;
+
+          data.n_substeps = internal::integrate_reactions_adaptively<dim> (evaluate_rates_C,
+                                                                           in_C,
+                                                                           *reaction_rate_outputs_C,
+                                                                           scratch.heating_model_outputs_C,
+                                                                           time_step,
+                                                                           reaction_time_step_size,
+                                                                           parameters.reaction_solver_tolerance,
+                                                                           data.n_rejected_substeps);
+
+          for (unsigned int j=0; j<composition_dofs_per_cell; ++j)
+            {
+              for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
+                accumulated_reactions_C[j][c] = in_C.composition[j][c] - initial_composition_C[j][c];
 
-          // copy reaction rates and new values for the compositional fields
-          for (unsigned int j=0; j<dof_handler.get_fe().base_element(introspection.base_elements.compositional_fields).dofs_per_cell; ++j)
-            for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
-              {
-                const unsigned int composition_idx
-                  = dof_handler.get_fe().component_to_system_index(introspection.component_indices.compositional_fields[c],
-                                                                   /*dof index within component=*/ j);
+              if (temperature_and_composition_use_same_fe)
+                accumulated_reactions_T[j] = in_C.temperature[j] - initial_temperature_C[j];
+            }
 
-                // skip entries that are not locally owned:
-                if (dof_handler.locally_owned_dofs().is_element(local_dof_indices[composition_idx]))
-                  {
-                    distributed_vector(local_dof_indices[composition_idx]) = in_C.composition[j][c];
-                    distributed_reaction_vector(local_dof_indices[composition_idx]) = accumulated_reactions_C[j][c];
-                  }
+          if (!temperature_and_composition_use_same_fe)
+            {
+              const std::vector<double> initial_temperature_T = in_T.temperature;
+
+              const unsigned int n_substeps_T
+                = internal::integrate_reactions_adaptively<dim> (evaluate_rates_T,
+                                                                 in_T,
+                                                                 *reaction_rate_outputs_T,
+                                                                 scratch.heating_model_outputs_T,
+                                                                 time_step,
+                                                                 reaction_time_step_size,
+                                                                 parameters.reaction_solver_tolerance,
+                                                                 data.n_rejected_substeps);
+              data.n_substeps = std::max(data.n_substeps, n_substeps_T);
+
+              for (unsigned int j=0; j<temperature_dofs_per_cell; ++j)
+                accumulated_reactions_T[j] = in_T.temperature[j] - initial_temperature_T[j];
+            }
+        }
+
+      cell->get_dof_indices (scratch.local_dof_indices);
+
+      data.dof_indices.clear();
+      data.new_values.clear();
+      data.reactions.clear();
+
+      // copy reaction rates and new values for the compositional fields
+      for (unsigned int j=0; j<composition_dofs_per_cell; ++j)
+        for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
+          {
+            const unsigned int composition_idx
+              = fe.component_to_system_index(introspection.component_indices.compositional_fields[c],
+                                             /*dof index within component=*/ j);
+
+            // skip entries that are not locally owned:
+            if (dof_handler.locally_owned_dofs().is_element(scratch.local_dof_indices[composition_idx]))
+              {
+                data.dof_indices.push_back(scratch.local_dof_indices[composition_idx]);
+                data.new_values.push_back(in_C.composition[j][c]);
+                data.reactions.push_back(accumulated_reactions_C[j][c]);
               }
+          }
 
-          // copy reaction rates and new values for the temperature field
-          for (unsigned int j=0; j<dof_handler.get_fe().base_element(introspection.base_elements.temperature).dofs_per_cell; ++j)
-            {
-              const unsigned int temperature_idx
-                = dof_handler.get_fe().component_to_system_index(introspection.component_indices.temperature,
-                                                                 /*dof index within component=*/ j);
+      // copy reaction rates and new values for the temperature field
+      for (unsigned int j=0; j<temperature_dofs_per_cell; ++j)
+        {
+          const unsigned int temperature_idx
+            = fe.component_to_system_index(introspection.component_indices.temperature,
+                                           /*dof index within component=*/ j);
 
-              // skip entries that are not locally owned:
-              if (dof_handler.locally_owned_dofs().is_element(local_dof_indices[temperature_idx]))
-                {
-                  if (temperature_and_composition_use_same_fe)
-                    distributed_vector(local_dof_indices[temperature_idx]) = in_C.temperature[j];
-                  else
-                    distributed_vector(local_dof_indices[temperature_idx]) = in_T.temperature[j];
+          // skip entries that are not locally owned:
+          if (dof_handler.locally_owned_dofs().is_element(scratch.local_dof_indices[temperature_idx]))
+            {
+              data.dof_indices.push_back(scratch.local_dof_indices[temperature_idx]);
+              if (temperature_and_composition_use_same_fe)
+                data.new_values.push_back(in_C.temperature[j]);
+              else
+                data.new_values.push_back(in_T.temperature[j]);
 
-                  distributed_reaction_vector(local_dof_indices[temperature_idx]) = accumulated_reactions_T[j];
-                }
+              data.reactions.push_back(accumulated_reactions_T[j]);
             }
         }
+    };
+
+    // statistics about the number of substeps that the reaction solver needed
+    double local_n_substeps = 0;
+    double local_n_rejected_substeps = 0;
+    unsigned int local_max_substeps = 0;
+
+    auto copier = [&](const internal::ReactionCopyData &data)
+    {
+      for (unsigned int i=0; i<data.dof_indices.size(); ++i)
+        {
+          distributed_vector(data.dof_indices[i]) = data.new_values[i];
+          distributed_reaction_vector(data.dof_indices[i]) = data.reactions[i];
+        }
+
+      local_n_substeps += data.n_substeps;
+      local_n_rejected_substeps += data.n_rejected_substeps;
+      local_max_substeps = std::max(local_max_substeps, data.n_substeps);
+    };
+
+    using CellFilter = FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
+
+    WorkStream::
+    run (CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.begin_active()),
+         CellFilter (IteratorFilters::LocallyOwnedCell(),
+                     dof_handler.end()),
+         worker,
+         copier,
+         scratch_data,
+         internal::ReactionCopyData());
 
     distributed_vector.compress(VectorOperation::insert);
     distributed_reaction_vector.compress(VectorOperation::insert);
@@ -1687,10 +2427,31 @@ namespace aspect
 
     initialize_current_linearization_point();
 
-    pcout << "in "
-          << number_of_reaction_steps
-          << " substep(s)."
-          << std::endl;
+    if (use_adaptive_reaction_solver == false)
+      pcout << "in "
+            << number_of_reaction_steps
+            << " substep(s)."
+            << std::endl;
+    else
+      {
+        const double average_substeps = Utilities::MPI::sum (local_n_substeps, mpi_communicator)
+                                        / triangulation.n_global_active_cells();
+        const unsigned int max_substeps = Utilities::MPI::max (local_max_substeps, mpi_communicator);
+        const double rejected_substeps = Utilities::MPI::sum (local_n_rejected_substeps, mpi_communicator);
+
+        pcout << "in "
+              << average_substeps
+              << " substep(s) per cell on average (maximum: "
+              << max_substeps
+              << ", rejected: "
+              << rejected_substeps
+              << ")."
+              << std::endl;
+
+        statistics.add_value("Average reaction substeps per cell", average_substeps);
+        statistics.add_value("Maximum reaction substeps per cell", max_substeps);
+        statistics.add_value("Rejected reaction substeps", static_cast<unsigned int>(rejected_substeps));
+      }
   }
 
 
@@ -2331,8 +3092,12 @@ namespace aspect
                                                      const LinearAlgebra::BlockVector &relevant_vector) const; \
   template void Simulator<dim>::compute_pressure_scaling_factor (); \
   template double Simulator<dim>::get_maximal_velocity (const LinearAlgebra::BlockVector &solution) const; \
+  template double Simulator<dim>::get_maximal_speed_over_meshsize (const LinearAlgebra::BlockVector &solution) const; \
   template std::pair<double,double> Simulator<dim>::get_extrapolated_advection_field_range (const AdvectionField &advection_field) const; \
   template void Simulator<dim>::maybe_write_timing_output () const; \
+  template void Simulator<dim>::write_detailed_timing_output () const; \
+  template void Simulator<dim>::add_detailed_worker_timing (const char *, \
+                                                           const std::chrono::steady_clock::time_point &) const; \
   template bool Simulator<dim>::maybe_write_checkpoint (const time_t, const bool); \
   template bool Simulator<dim>::maybe_do_initial_refinement (const unsigned int max_refinement_level); \
   template void Simulator<dim>::maybe_refine_mesh (const double new_time_step, unsigned int &max_refinement_level); \
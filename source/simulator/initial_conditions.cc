@@ -66,78 +66,72 @@ namespace aspect
     //
     // to work around this problem, the following code is essentially
     // a (simplified) copy of the code in VectorTools::interpolate
-    // that only works on the temperature component
-    //
-    // TODO: it would be great if we had a cleaner way than iterating to 1+n_fields.
-    // Additionally, the n==1 logic for normalization at the bottom is not pretty.
-    for (unsigned int n=0; n<1+introspection.n_compositional_fields; ++n)
-      {
-        AdvectionField advf = ((n == 0) ? AdvectionField::temperature()
-                               : AdvectionField::composition(n-1));
+    // that only works on the temperature and composition components.
+    // rather than interpolating one field after the other, we evaluate
+    // the initial temperature and all initial compositions in a single
+    // loop over all cells. this way, the support points of each cell are
+    // only computed once, and initial condition plugins get the chance to
+    // share work between all fields at the same position, which matters
+    // for plugins that need an expensive geometric search for each point.
+    const unsigned int n_compositional_fields = introspection.n_compositional_fields;
+
+    const std::vector<Point<dim> > temperature_support_points
+      = finite_element.base_element(introspection.base_elements.temperature).get_unit_support_points();
+    Assert (temperature_support_points.size() != 0,
+            ExcInternalError());
 
-        const unsigned int base_element = advf.base_element(introspection);
+    FEValues<dim> temperature_fe_values (*mapping, finite_element,
+                                         temperature_support_points,
+                                         update_quadrature_points);
 
-        // get the temperature/composition support points
-        const std::vector<Point<dim> > support_points
-          = finite_element.base_element(base_element).get_unit_support_points();
-        Assert (support_points.size() != 0,
+    std::unique_ptr<FEValues<dim> > composition_fe_values;
+    if (n_compositional_fields > 0)
+      {
+        const std::vector<Point<dim> > composition_support_points
+          = finite_element.base_element(introspection.base_elements.compositional_fields).get_unit_support_points();
+        Assert (composition_support_points.size() != 0,
                 ExcInternalError());
 
-        // create an FEValues object with just the temperature/composition element
-        FEValues<dim> fe_values (*mapping, finite_element,
-                                 support_points,
-                                 update_quadrature_points);
+        composition_fe_values = std_cxx14::make_unique<FEValues<dim> > (*mapping, finite_element,
+                                                                         composition_support_points,
+                                                                         update_quadrature_points);
+      }
 
-        std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
+    // for every vector component, the index of the compositional
+    // field it belongs to, if any
+    std::vector<unsigned int> component_to_compositional_field (introspection.n_components,
+                                                                numbers::invalid_unsigned_int);
+    for (unsigned int c=0; c<n_compositional_fields; ++c)
+      component_to_compositional_field[introspection.component_indices.compositional_fields[c]] = c;
 
-        const VectorFunctionFromScalarFunctionObject<dim, double> &advf_init_function
-          =
-            (advf.is_temperature()
-             ?
-             VectorFunctionFromScalarFunctionObject<dim, double>(
-               [&](const Point<dim> &p) -> double
-        {
-          return initial_temperature_manager.initial_temperature(p);
-        },
-        introspection.component_indices.temperature,
-        introspection.n_components)
-        :
-        VectorFunctionFromScalarFunctionObject<dim, double>(
-          [&](const Point<dim> &p) -> double
+    const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    std::vector<types::global_dof_index> local_dof_indices (finite_element.dofs_per_cell);
+    std::vector<double> temperature_values;
+    std::vector<std::vector<double> > composition_values;
+
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
         {
-          return initial_composition_manager.initial_composition(p, n-1);
-        },
-        introspection.component_indices.compositional_fields[n-1],
-        introspection.n_components));
-
-        const ComponentMask advf_mask =
-          (advf.is_temperature()
-           ?
-           introspection.component_masks.temperature
-           :
-           introspection.component_masks.compositional_fields[n-1]);
-
-        VectorTools::interpolate(*mapping,
-                                 dof_handler,
-                                 advf_init_function,
-                                 initial_solution,
-                                 advf_mask);
-
-        if (parameters.normalized_fields.size()>0 && n==1)
-          for (const auto &cell : dof_handler.active_cell_iterators())
-            if (cell->is_locally_owned())
-              {
-                fe_values.reinit (cell);
+          cell->get_dof_indices (local_dof_indices);
+
+          temperature_fe_values.reinit (cell);
+          initial_temperature_manager.initial_temperatures (temperature_fe_values.get_quadrature_points(),
+                                                            temperature_values);
 
-                // Go through the support points for each dof
-                for (unsigned int i=0; i<finite_element.base_element(base_element).dofs_per_cell; ++i)
+          if (n_compositional_fields > 0)
+            {
+              composition_fe_values->reinit (cell);
+              initial_composition_manager.initial_compositions (composition_fe_values->get_quadrature_points(),
+                                                                composition_values);
+
+              // if it is specified in the parameter file that the sum of all compositional fields
+              // must not exceed one, this should be checked
+              if (parameters.normalized_fields.size() > 0)
+                for (unsigned int i=0; i<composition_fe_values->n_quadrature_points; ++i)
                   {
-                    // if it is specified in the parameter file that the sum of all compositional fields
-                    // must not exceed one, this should be checked
                     double sum = 0;
-                    for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
-                      sum += initial_composition_manager.initial_composition(fe_values.quadrature_point(i),
-                                                                             parameters.normalized_fields[m]);
+                    for (const unsigned int field : parameters.normalized_fields)
+                      sum += composition_values[field][i];
 
                     if (std::abs(sum) > 1.0+std::numeric_limits<double>::epsilon())
                       {
@@ -145,27 +139,39 @@ namespace aspect
                         normalize_composition = true;
                       }
                   }
+            }
+
+          for (unsigned int i=0; i<finite_element.dofs_per_cell; ++i)
+            if (finite_element.is_primitive(i)
+                && locally_owned_dofs.is_element(local_dof_indices[i]))
+              {
+                const std::pair<unsigned int, unsigned int> component_and_index
+                  = finite_element.system_to_component_index(i);
+
+                if (component_and_index.first == introspection.component_indices.temperature)
+                  initial_solution(local_dof_indices[i]) = temperature_values[component_and_index.second];
+                else if (component_to_compositional_field[component_and_index.first] != numbers::invalid_unsigned_int)
+                  initial_solution(local_dof_indices[i])
+                    = composition_values[component_to_compositional_field[component_and_index.first]][component_and_index.second];
               }
+        }
+
+    initial_solution.compress(VectorOperation::insert);
+
+    // if at least one processor decides that it needs
+    // to normalize, do the same on all processors.
+    if (Utilities::MPI::max (normalize_composition ? 1 : 0,
+                             mpi_communicator)
+        == 1)
+      {
+        const double global_max
+          = Utilities::MPI::max (max_sum_comp, mpi_communicator);
+
+        pcout << "Sum of compositional fields is not one, fields will be normalized"
+              << std::endl;
 
-        initial_solution.compress(VectorOperation::insert);
-
-        // if at least one processor decides that it needs
-        // to normalize, do the same on all processors.
-        if (Utilities::MPI::max (normalize_composition ? 1 : 0,
-                                 mpi_communicator)
-            == 1)
-          {
-            const double global_max
-              = Utilities::MPI::max (max_sum_comp, mpi_communicator);
-
-            if (n==1)
-              pcout << "Sum of compositional fields is not one, fields will be normalized"
-                    << std::endl;
-
-            for (unsigned int m=0; m<parameters.normalized_fields.size(); ++m)
-              if (n-1==parameters.normalized_fields[m])
-                initial_solution.block(introspection.block_indices.compositional_fields[n-1]) /= global_max;
-          }
+        for (const unsigned int field : parameters.normalized_fields)
+          initial_solution.block(introspection.block_indices.compositional_fields[field]) /= global_max;
       }
 
     // then apply constraints and copy the
@@ -26,6 +26,7 @@
 #include <aspect/geometry_model/ellipsoidal_chunk.h>
 #include <aspect/geometry_model/spherical_shell.h>
 #include <aspect/geometry_model/two_merged_boxes.h>
+#include <aspect/simulator/scratch_object_pool.h>
 
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/base/quadrature_lib.h>
@@ -423,6 +424,36 @@ namespace aspect
 
 
 
+  template <int dim>
+  void
+  LateralAveraging<dim>::initialize ()
+  {
+    // The assignment of quadrature points to depth slices is only valid
+    // as long as the mesh does not change.
+    this->get_triangulation().signals.any_change.connect(
+      [&]()
+    {
+      this->clear_cache();
+    });
+
+    this->get_signals().post_mesh_deformation.connect(
+      [&](const SimulatorAccess<dim> &)
+    {
+      this->clear_cache();
+    });
+  }
+
+
+
+  template <int dim>
+  void
+  LateralAveraging<dim>::clear_cache ()
+  {
+    slice_data_cache.clear();
+  }
+
+
+
   template <int dim>
   std::vector<std::vector<double> >
   LateralAveraging<dim>::compute_lateral_averages(const std::vector<double> &depth_bounds,
@@ -443,62 +474,66 @@ namespace aspect
 
     std::vector<std::vector<double> > values(n_properties,
                                              std::vector<double>(n_slices,0.0));
-    std::vector<double> volume(n_slices,0.0);
-
-    // We would like to use a quadrature formula that is appropriately accurate laterally,
-    // but has a higher resolution in depth (to have values for all depth slices, even if there
-    // are adaptively coarsened cells that are much bigger than individual slices).
-    // For that we need to know the depth direction in the unit cell coordinate system, which
-    // is only unique (= the same for all cells) in some geometries. In these geometries we
-    // can optimize the quadrature, otherwise we need to use a high-resolution quadrature in
-    // all directions, which is more expensive.
-    // The Chunk geometry model has depth as first dimension (radius, lon, lat),
-    // all others with unique direction have it last; however, the Chunk and
-    // EllipsoidalChunk geometry have not been successfully tested with
-    // the lower quadrature, so we leave it at the conservative quadrature for now.
-
-    unsigned int geometry_unique_depth_direction;
-    if (Plugins::plugin_type_matches<GeometryModel::Box<dim> >(this->get_geometry_model()) ||
-        Plugins::plugin_type_matches<GeometryModel::SphericalShell<dim> >(this->get_geometry_model()) ||
-        Plugins::plugin_type_matches<GeometryModel::TwoMergedBoxes<dim> >(this->get_geometry_model()))
-      geometry_unique_depth_direction = dim;
-    else if (Plugins::plugin_type_matches<GeometryModel::Chunk<dim> >(this->get_geometry_model()) ||
-             Plugins::plugin_type_matches<GeometryModel::EllipsoidalChunk<dim> >(this->get_geometry_model()))
-      geometry_unique_depth_direction = numbers::invalid_unsigned_int;
-    else
-      geometry_unique_depth_direction = numbers::invalid_unsigned_int;
-
-    const unsigned int max_fe_degree = std::max(this->introspection().polynomial_degree.velocities,
-                                                std::max(this->introspection().polynomial_degree.temperature,
-                                                         this->introspection().polynomial_degree.compositional_fields));
-
-    // We want to integrate over a polynomial of degree p = max_fe_degree, for which we
-    // need a quadrature of at least q, with p <= 2q-1 --> q >= (p+1)/2
-    const unsigned int lateral_quadrature_degree = static_cast<unsigned int>(std::ceil((max_fe_degree+1.0)/2.0));
-
-    std::unique_ptr<Quadrature<dim> > quadrature_formula;
-    if (geometry_unique_depth_direction != numbers::invalid_unsigned_int)
-      quadrature_formula = std_cxx14::make_unique<Quadrature<dim> >(internal::get_quadrature_formula<dim>(lateral_quadrature_degree,
-                                                                    geometry_unique_depth_direction));
-    else
-      quadrature_formula = std_cxx14::make_unique<Quadrature<dim> >(QIterated<dim>(QMidpoint<1>(),10));
+
+    // The quadrature formula does not change during the model run,
+    // so only create it on first use.
+    if (quadrature_formula == nullptr)
+      {
+        // We would like to use a quadrature formula that is appropriately accurate laterally,
+        // but has a higher resolution in depth (to have values for all depth slices, even if there
+        // are adaptively coarsened cells that are much bigger than individual slices).
+        // For that we need to know the depth direction in the unit cell coordinate system, which
+        // is only unique (= the same for all cells) in some geometries. In these geometries we
+        // can optimize the quadrature, otherwise we need to use a high-resolution quadrature in
+        // all directions, which is more expensive.
+        // The Chunk geometry model has depth as first dimension (radius, lon, lat),
+        // all others with unique direction have it last; however, the Chunk and
+        // EllipsoidalChunk geometry have not been successfully tested with
+        // the lower quadrature, so we leave it at the conservative quadrature for now.
+
+        unsigned int geometry_unique_depth_direction;
+        if (Plugins::plugin_type_matches<GeometryModel::Box<dim> >(this->get_geometry_model()) ||
+            Plugins::plugin_type_matches<GeometryModel::SphericalShell<dim> >(this->get_geometry_model()) ||
+            Plugins::plugin_type_matches<GeometryModel::TwoMergedBoxes<dim> >(this->get_geometry_model()))
+          geometry_unique_depth_direction = dim;
+        else if (Plugins::plugin_type_matches<GeometryModel::Chunk<dim> >(this->get_geometry_model()) ||
+                 Plugins::plugin_type_matches<GeometryModel::EllipsoidalChunk<dim> >(this->get_geometry_model()))
+          geometry_unique_depth_direction = numbers::invalid_unsigned_int;
+        else
+          geometry_unique_depth_direction = numbers::invalid_unsigned_int;
+
+        const unsigned int max_fe_degree = std::max(this->introspection().polynomial_degree.velocities,
+                                                    std::max(this->introspection().polynomial_degree.temperature,
+                                                             this->introspection().polynomial_degree.compositional_fields));
+
+        // We want to integrate over a polynomial of degree p = max_fe_degree, for which we
+        // need a quadrature of at least q, with p <= 2q-1 --> q >= (p+1)/2
+        const unsigned int lateral_quadrature_degree = static_cast<unsigned int>(std::ceil((max_fe_degree+1.0)/2.0));
+
+        if (geometry_unique_depth_direction != numbers::invalid_unsigned_int)
+          quadrature_formula = std_cxx14::make_unique<Quadrature<dim> >(internal::get_quadrature_formula<dim>(lateral_quadrature_degree,
+                                                                      geometry_unique_depth_direction));
+        else
+          quadrature_formula = std_cxx14::make_unique<Quadrature<dim> >(QIterated<dim>(QMidpoint<1>(),10));
+      }
 
     const unsigned int n_q_points = quadrature_formula->size();
 
-    FEValues<dim> fe_values (this->get_mapping(),
-                             this->get_fe(),
-                             *quadrature_formula,
-                             update_values | update_gradients | update_quadrature_points | update_JxW_values);
+    // Borrow the FEValues object and the material model inputs and outputs
+    // from the pool of the simulator, because the depth average postprocessor
+    // and several plugins call this function on every time step.
+    const std::shared_ptr<CellEvaluationScratch<dim> > scratch
+      = this->borrow_cell_evaluation_scratch (*quadrature_formula,
+                                              update_values | update_gradients | update_quadrature_points | update_JxW_values);
+    FEValues<dim> &fe_values = scratch->fe_values;
 
     std::vector<std::vector<double> > composition_values (this->n_compositional_fields(),
                                                           std::vector<double> (n_q_points));
     std::vector<std::vector<double> > output_values(n_properties,
                                                     std::vector<double>(n_q_points));
 
-    MaterialModel::MaterialModelInputs<dim> in(n_q_points,
-                                               this->n_compositional_fields());
-    MaterialModel::MaterialModelOutputs<dim> out(n_q_points,
-                                                 this->n_compositional_fields());
+    MaterialModel::MaterialModelInputs<dim> &in = scratch->material_model_inputs;
+    MaterialModel::MaterialModelOutputs<dim> &out = scratch->material_model_outputs;
 
     bool functors_need_material_output = false;
     for (unsigned int i=0; i<n_properties; ++i)
@@ -510,6 +545,20 @@ namespace aspect
         functors[i]->create_additional_material_model_outputs(n_q_points,out);
       }
 
+    // See if we have already determined which depth slice each quadrature
+    // point belongs to for the current mesh and these depth bounds. If not,
+    // compute this information during the loop over all cells below.
+    const bool compute_slice_data = (slice_data_cache.find(depth_bounds) == slice_data_cache.end());
+    SliceData &slice_data = slice_data_cache[depth_bounds];
+
+    std::vector<double> volume;
+    if (compute_slice_data)
+      {
+        slice_data.slice_indices.reserve(this->get_triangulation().n_locally_owned_active_cells() * n_q_points);
+        volume.resize(n_slices, 0.0);
+      }
+
+    unsigned int point_index = 0;
     for (const auto &cell : this->get_dof_handler().active_cell_iterators())
       if (cell->is_locally_owned())
         {
@@ -528,33 +577,51 @@ namespace aspect
           for (unsigned int i = 0; i < n_properties; ++i)
             (*functors[i])(in, out, fe_values, this->get_solution(), output_values[i]);
 
-          for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int q = 0; q < n_q_points; ++q, ++point_index)
             {
-              const double depth = this->get_geometry_model().depth(fe_values.quadrature_point(q));
-
-              if (depth < depth_bounds.front() || depth > depth_bounds.back())
+              if (compute_slice_data)
+                {
+                  const double depth = this->get_geometry_model().depth(fe_values.quadrature_point(q));
+
+                  unsigned int layer_index = numbers::invalid_unsigned_int;
+                  if (depth >= depth_bounds.front() && depth <= depth_bounds.back())
+                    {
+                      // This makes sure depth == front() and depth == back() are handled correctly.
+                      // lower_bound returns the first layer boundary larger than depth, the correct
+                      // layer index is then one less than this (except for depth == depth_bounds[0],
+                      // in which case the depth_bounds index is also the layer_index, namely 0).
+                      layer_index = std::distance(depth_bounds.begin(),
+                                                  std::lower_bound(depth_bounds.begin(),depth_bounds.end(),depth));
+                      if (layer_index > 0)
+                        layer_index -= 1;
+
+                      Assert(layer_index<n_slices, ExcInternalError());
+
+                      volume[layer_index] += fe_values.JxW(q);
+                    }
+
+                  slice_data.slice_indices.push_back(layer_index);
+                }
+
+              Assert(point_index < slice_data.slice_indices.size(), ExcInternalError());
+              const unsigned int layer_index = slice_data.slice_indices[point_index];
+
+              // Skip quadrature points that are not in any depth slice
+              if (layer_index == numbers::invalid_unsigned_int)
                 continue;
 
-              // This makes sure depth == front() and depth == back() are handled correctly.
-              // lower_bound returns the first layer boundary larger than depth, the correct
-              // layer index is then one less than this (except for depth == depth_bounds[0],
-              // in which case the depth_bounds index is also the layer_index, namely 0).
-              unsigned int layer_index = std::distance(depth_bounds.begin(),
-                                                       std::lower_bound(depth_bounds.begin(),depth_bounds.end(),depth));
-              if (layer_index > 0)
-                layer_index -= 1;
-
-              Assert(layer_index<n_slices, ExcInternalError());
-
               for (unsigned int i = 0; i < n_properties; ++i)
                 values[i][layer_index] += output_values[i][q] * fe_values.JxW(q);
-
-              volume[layer_index] += fe_values.JxW(q);
             }
         }
 
-    std::vector<double> volume_all(n_slices);
-    Utilities::MPI::sum(volume, this->get_mpi_communicator(), volume_all);
+    if (compute_slice_data)
+      {
+        slice_data.volumes.resize(n_slices);
+        Utilities::MPI::sum(volume, this->get_mpi_communicator(), slice_data.volumes);
+      }
+
+    const std::vector<double> &volume_all = slice_data.volumes;
 
     bool print_under_res_warning=false;
     for (unsigned int property=0; property<n_properties; ++property)
@@ -102,6 +102,28 @@ namespace aspect
                        "value is set to zero it will also output timing information at the "
                        "initiation timesteps.");
 
+    prm.declare_entry ("Detailed timing output", "false",
+                       Patterns::Bool (),
+                       "Whether to collect and write more detailed timing information. "
+                       "If set to true, a number of additional sections are timed "
+                       "within the ones that are always timed, for example the "
+                       "execution of each postprocessor and the individual attempts "
+                       "of the Stokes solver. These nested sections are named "
+                       "`Section: Subsection' in the timing summary. In addition, "
+                       "the wall time spent in every section during each time step "
+                       "is appended as a single line of JSON to the file "
+                       "<output directory>/timing.jsonl, together with the minimum, "
+                       "average, and maximum of this time over all MPI processes. "
+                       "This file also contains the time spent in the material model "
+                       "evaluation and in the assemblers of the Stokes, temperature, "
+                       "and composition assembly. These parts are executed on several "
+                       "threads and are not part of the timing summary; their times "
+                       "are summed over all threads, and can therefore exceed the time "
+                       "of the surrounding section. "
+                       "This file is intended to be read by scripts that track the "
+                       "performance of a model over time or between versions of "
+                       "ASPECT.");
+
     prm.declare_entry ("Use years in output instead of seconds", "true",
                        Patterns::Bool (),
                        "When computing results for mantle convection simulations, "
@@ -258,6 +280,30 @@ namespace aspect
                        "iterations, in other words, if it is set to something other than "
                        "`single Advection, single Stokes' or `single Advection, no Stokes'.");
 
+    prm.declare_entry ("Nonlinear solver acceleration", "none",
+                       Patterns::Selection (NonlinearSolverAcceleration::pattern()),
+                       "A method to accelerate the convergence of the Picard iterations "
+                       "of the Stokes system in the `no Advection, iterated Stokes', "
+                       "`single Advection, iterated Stokes', and `iterated Advection "
+                       "and Stokes' nonlinear solver schemes. If set to `Anderson', the "
+                       "velocity and pressure used as the next linearization point are "
+                       "not simply the solution of the last Stokes solve, but a linear "
+                       "combination of the last solutions that minimizes the difference "
+                       "between consecutive iterates (Anderson acceleration). The number "
+                       "of previous iterates that is used is set by the `Nonlinear solver "
+                       "acceleration depth' parameter. If the difference between "
+                       "consecutive iterates grows, the history is discarded and a plain "
+                       "Picard step is taken instead. The number of accelerated "
+                       "iterations and of such restarts is written to the statistics "
+                       "file. This is not supported for models with melt transport.");
+
+    prm.declare_entry ("Nonlinear solver acceleration depth", "5",
+                       Patterns::Integer (0),
+                       "The maximal number of previous iterates that is used by the "
+                       "`Nonlinear solver acceleration' method. If set to zero, no "
+                       "previous iterates are used, and the iterations are the same "
+                       "as without acceleration.");
+
     prm.declare_entry ("Pressure normalization", "surface",
                        Patterns::Selection ("surface|volume|no"),
                        "If and how to normalize the pressure after the solution step. "
@@ -319,6 +365,21 @@ namespace aspect
                        "The name of the directory into which all output files should be "
                        "placed. This may be an absolute or a relative path.");
 
+    prm.declare_entry ("Statistics file format", "table",
+                       Patterns::Selection ("table|append only"),
+                       "The format of the `statistics' file in the output directory. "
+                       "For `table', the file contains the statistics of all time steps "
+                       "as a table with aligned columns. Since the width of a column "
+                       "can change when a new row is added, the whole table has to be "
+                       "formatted again after every time step, and the cost of "
+                       "writing the file grows with the number of time steps. "
+                       "For `append only', only the rows added since the last output "
+                       "are written, with the entries of a row separated by single "
+                       "spaces. Columns that are added during the model run are "
+                       "described by additional comment lines of the form "
+                       "`# n: name' before the first row that contains them; rows "
+                       "written before contain no entry for these columns.");
+
     prm.declare_entry ("Use operator splitting", "false",
                        Patterns::Bool(),
                        "If set to true, the advection and reactions of compositional fields and "
@@ -356,6 +417,24 @@ namespace aspect
                            "increasing this number increases the memory usage "
                            "of the advection solver, and makes individual "
                            "iterations more expensive.");
+
+        prm.declare_entry ("Reuse material model evaluation for compositional fields", "false",
+                           Patterns::Bool(),
+                           "Whether the material model and heating model outputs computed while "
+                           "assembling the system of the first compositional field should be stored "
+                           "for every cell and reused when assembling the systems of all other "
+                           "compositional fields in the same nonlinear iteration, rather than "
+                           "evaluating the material model again for every field. This is possible "
+                           "because the linearization point, and with it the material model inputs, "
+                           "only changes after all compositional fields have been solved. The "
+                           "temperature system is always assembled with its own evaluation, because "
+                           "the linearization point changes after the temperature solve. Enabling "
+                           "this option requires memory for the material model outputs in all "
+                           "quadrature points of all locally owned cells, and is only correct for "
+                           "material models whose outputs depend only on the material model inputs "
+                           "(and not, for example, on the solution vector accessed directly). "
+                           "If ``Detailed timing output'' is enabled, the fraction of reused "
+                           "evaluations is written to the screen output.");
       }
       prm.leave_subsection();
 
@@ -560,6 +639,28 @@ namespace aspect
                            "this criterion and the ``Reaction time step'', whichever yields the "
                            "smaller time step. "
                            "Units: none.");
+
+        prm.declare_entry ("Reaction solver type", "fixed step",
+                           Patterns::Selection (ReactionSolverType::pattern()),
+                           "The time integrator used for the reactions of the compositional "
+                           "fields and the temperature field in case operator splitting is used. "
+                           "The ``fixed step'' integrator uses forward Euler steps of the size "
+                           "determined by ``Reaction time step'' and ``Reaction time steps per "
+                           "advection step''. The ``adaptive step'' integrator uses an embedded "
+                           "Euler/Heun pair of explicit Runge-Kutta methods and chooses the step "
+                           "size separately for every degree of freedom so that the estimated local "
+                           "error stays below the ``Reaction solver tolerance''. This allows regions "
+                           "with slow reactions to take few large steps, while regions with fast "
+                           "reactions take many small steps. In this case, the step size determined "
+                           "by the two parameters above is only used as the initial step size.");
+
+        prm.declare_entry ("Reaction solver tolerance", "1e-6",
+                           Patterns::Double (0.),
+                           "The tolerance for the local error estimate of the ``adaptive step'' "
+                           "reaction solver. The error of every temperature and composition value "
+                           "is measured relative to the maximum of 1 and the magnitude of the value. "
+                           "This parameter is ignored for the ``fixed step'' reaction solver. "
+                           "Units: none.");
       }
       prm.leave_subsection ();
       prm.enter_subsection ("Diffusion solver parameters");
@@ -805,6 +906,46 @@ namespace aspect
                          "Use fraction of the total number of cells instead of "
                          "fraction of the total error as the limit for refinement "
                          "and coarsening.");
+      prm.declare_entry ("Adapt refinement interval to flow", "false",
+                         Patterns::Bool(),
+                         "Whether to decide when to refine the mesh based on how far "
+                         "the flow moves features relative to the size of the cells, "
+                         "instead of refining every 'Time steps between mesh refinement' "
+                         "time steps. If this is set, the mesh is refined once the "
+                         "fastest features of the flow are predicted to have moved by "
+                         "'Cell advection between mesh refinements' cells since the last "
+                         "refinement, measured as the sum over all time steps of the time "
+                         "step size times the largest ratio of velocity and cell size. "
+                         "'Time steps between mesh refinement' is then the minimal "
+                         "number of time steps between two refinements, and a value of "
+                         "zero still disables adaptive refinement. This avoids refining "
+                         "a mesh when the solution has hardly changed, and refines more "
+                         "often when the flow is fast.");
+      prm.declare_entry ("Cell advection between mesh refinements", "1.",
+                         Patterns::Double(0.),
+                         "If 'Adapt refinement interval to flow' is set, the number of "
+                         "cells the fastest features of the flow may move before the "
+                         "mesh is refined again. Units: none.");
+      prm.declare_entry ("Refinement buffer layers", "0",
+                         Patterns::Integer(0),
+                         "The number of layers of cells around the cells flagged for "
+                         "refinement that are also refined. Such a buffer zone keeps "
+                         "features that move with the flow within the refined region "
+                         "until the mesh is refined again. A cell is only refined as "
+                         "part of the buffer zone if it is not finer than the "
+                         "neighbor that is flagged for refinement.");
+      prm.declare_entry ("Skip unchanged mesh refinement", "false",
+                         Patterns::Bool(),
+                         "Whether to skip the remaining work of a mesh refinement step "
+                         "if, after all refinement criteria and limits on the refinement "
+                         "level have been applied, no cell is flagged for refinement or "
+                         "coarsening. In that case the transfer of the solution vectors "
+                         "and the setup of degrees of freedom, constraints, and sparsity "
+                         "patterns are skipped, and the existing ones are reused. This "
+                         "happens, for example, once all cells have reached the minimal "
+                         "or maximal refinement level. The work is not skipped if "
+                         "particles or other plugins store data on the cells, or if "
+                         "cells are weighted during repartitioning.");
       prm.declare_entry ("Minimum refinement level", "0",
                          Patterns::Integer (0),
                          "The minimum refinement level each cell should have, "
@@ -869,6 +1010,29 @@ namespace aspect
                          "If 0 and time between checkpoint is not specified, "
                          "checkpointing will not be performed. "
                          "Units: None.");
+      prm.declare_entry ("Write in background thread", "false",
+                         Patterns::Bool (),
+                         "Writing a checkpoint stalls the computation until all "
+                         "files are on disk. If this parameter is set to true, "
+                         "only part of this work is moved to a background thread: "
+                         "The state of the simulator and its plugins is serialized "
+                         "into memory, and the compression and writing of this "
+                         "state as well as the replacement of the previous "
+                         "checkpoint by the new one happen on a background thread "
+                         "while the time stepping continues. The mesh, the solution "
+                         "vectors, and the data of particles attached to the mesh, "
+                         "which usually make up most of a checkpoint, are still "
+                         "written synchronously by all processes before the "
+                         "computation continues, because this requires collective "
+                         "parallel I/O. The time spent on this part of a checkpoint "
+                         "is therefore not hidden, and this "
+                         "option mostly helps for models whose serialized state "
+                         "is large, for example because of postprocessors with a "
+                         "long output history. "
+                         "Since the new checkpoint is only moved into place after "
+                         "all of its files have been written completely, the "
+                         "previous checkpoint remains usable until then. "
+                         "Units: None.");
     }
     prm.leave_subsection ();
 
@@ -1314,6 +1478,7 @@ namespace aspect
     use_conduction_timestep = prm.get_bool ("Use conduction timestep");
     convert_to_years        = prm.get_bool ("Use years in output instead of seconds");
     timing_output_frequency = prm.get_integer ("Timing output frequency");
+    detailed_timing_output  = prm.get_bool ("Detailed timing output");
     world_builder_file      = prm.get("World builder file");
 
     maximum_time_step       = prm.get_double("Maximum time step");
@@ -1365,6 +1530,7 @@ namespace aspect
       prm.enter_subsection ("Advection solver parameters");
       {
         advection_gmres_restart_length     = prm.get_integer("GMRES solver restart length");
+        reuse_material_model_evaluation_for_compositional_fields = prm.get_bool("Reuse material model evaluation for compositional fields");
       }
       prm.leave_subsection ();
 
@@ -1403,6 +1569,12 @@ namespace aspect
         if (convert_to_years == true)
           reaction_time_step *= year_in_seconds;
         reaction_steps_per_advection_step = prm.get_integer ("Reaction time steps per advection step");
+        reaction_solver_type = ReactionSolverType::parse(prm.get("Reaction solver type"));
+        reaction_solver_tolerance = prm.get_double ("Reaction solver tolerance");
+        AssertThrow (reaction_solver_type != ReactionSolverType::adaptive_step
+                     || reaction_solver_tolerance > 0,
+                     ExcMessage("The reaction solver tolerance must be greater than 0 "
+                                "when the adaptive step reaction solver is used."));
       }
       prm.leave_subsection ();
       prm.enter_subsection ("Diffusion solver parameters");
@@ -1414,6 +1586,8 @@ namespace aspect
     prm.leave_subsection ();
 
     nonlinear_tolerance = prm.get_double("Nonlinear solver tolerance");
+    nonlinear_solver_acceleration = NonlinearSolverAcceleration::parse(prm.get("Nonlinear solver acceleration"));
+    nonlinear_solver_acceleration_depth = prm.get_integer ("Nonlinear solver acceleration depth");
 
     max_nonlinear_iterations = prm.get_integer ("Max nonlinear iterations");
     max_nonlinear_iterations_in_prerefinement = prm.get_integer ("Max nonlinear iterations in pre-refinement");
@@ -1432,6 +1606,8 @@ namespace aspect
                                  mpi_communicator,
                                  false);
 
+    append_only_statistics = (prm.get ("Statistics file format") == "append only");
+
     if (prm.get ("Resume computation") == "true")
       resume_computation = true;
     else if (prm.get ("Resume computation") == "false")
@@ -1461,9 +1637,13 @@ namespace aspect
       initial_adaptive_refinement  = prm.get_integer ("Initial adaptive refinement");
 
       adaptive_refinement_interval = prm.get_integer ("Time steps between mesh refinement");
+      adapt_refinement_interval_to_flow  = prm.get_bool ("Adapt refinement interval to flow");
+      cell_advection_between_refinements = prm.get_double ("Cell advection between mesh refinements");
+      refinement_buffer_layers     = prm.get_integer ("Refinement buffer layers");
       refinement_fraction          = prm.get_double ("Refinement fraction");
       coarsening_fraction          = prm.get_double ("Coarsening fraction");
       adapt_by_fraction_of_cells   = prm.get_bool ("Adapt by fraction of cells");
+      skip_unchanged_mesh_refinement = prm.get_bool ("Skip unchanged mesh refinement");
       min_grid_level               = prm.get_integer ("Minimum refinement level");
 
       AssertThrow(refinement_fraction >= 0 && coarsening_fraction >= 0,
@@ -1609,6 +1789,7 @@ namespace aspect
     {
       checkpoint_time_secs = prm.get_integer ("Time between checkpoint");
       checkpoint_steps     = prm.get_integer ("Steps between checkpoint");
+      write_checkpoint_in_background_thread = prm.get_bool ("Write in background thread");
 
 #ifndef DEAL_II_WITH_ZLIB
       AssertThrow ((checkpoint_time_secs == 0)
@@ -0,0 +1,130 @@
+/*
+  Copyright (C) 2020 by the authors of the ASPECT code.
+
+  This file is part of ASPECT.
+
+  ASPECT is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2, or (at your option)
+  any later version.
+
+  ASPECT is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ASPECT; see the file LICENSE.  If not see
+  <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <aspect/simulator/scratch_object_pool.h>
+
+#include <deal.II/base/signaling_nan.h>
+
+namespace aspect
+{
+  template <int dim>
+  CellEvaluationScratch<dim>::
+  CellEvaluationScratch (const Mapping<dim> &mapping,
+                         const FiniteElement<dim> &fe,
+                         const Quadrature<dim> &quadrature,
+                         const UpdateFlags update_flags,
+                         const unsigned int n_compositional_fields)
+    :
+    fe_values (mapping, fe, quadrature, update_flags),
+    material_model_inputs (quadrature.size(), n_compositional_fields),
+    material_model_outputs (quadrature.size(), n_compositional_fields)
+  {}
+
+
+
+  namespace internal
+  {
+    template <int dim>
+    std::shared_ptr<CellEvaluationScratch<dim> >
+    ScratchObjectPool<dim>::borrow (const Mapping<dim> &mapping,
+                                    const FiniteElement<dim> &fe,
+                                    const Quadrature<dim> &quadrature,
+                                    const UpdateFlags update_flags,
+                                    const unsigned int n_compositional_fields)
+    {
+      std::unique_ptr<CellEvaluationScratch<dim> > scratch;
+
+      {
+        std::lock_guard<std::mutex> lock (mutex);
+        for (auto entry = available_objects.begin(); entry != available_objects.end(); ++entry)
+          if (entry->update_flags == update_flags
+              && entry->n_compositional_fields == n_compositional_fields
+              && &entry->scratch->fe_values.get_mapping() == &mapping
+              && &entry->scratch->fe_values.get_fe() == &fe
+              && entry->quadrature == quadrature)
+            {
+              scratch = std::move(entry->scratch);
+              available_objects.erase(entry);
+              break;
+            }
+      }
+
+      if (scratch == nullptr)
+        scratch = std_cxx14::make_unique<CellEvaluationScratch<dim> > (mapping,
+                                                                        fe,
+                                                                        quadrature,
+                                                                        update_flags,
+                                                                        n_compositional_fields);
+      else
+        {
+          // Remove everything the previous user may have attached to or
+          // changed in the material model inputs and outputs.
+          scratch->material_model_inputs.additional_inputs.clear();
+          scratch->material_model_inputs.requested_properties = MaterialModel::MaterialProperties::all_properties;
+          // MaterialModelInputs::reinit() removes the strain rate if it is
+          // not requested, so make sure it has the correct size again
+          scratch->material_model_inputs.strain_rate.resize(quadrature.size(),
+                                                             numbers::signaling_nan<SymmetricTensor<2,dim> >());
+          scratch->material_model_outputs.additional_outputs.clear();
+        }
+
+      // Hand out a pointer that puts the object back into the pool
+      // instead of deleting it.
+      return std::shared_ptr<CellEvaluationScratch<dim> >
+             (scratch.release(),
+              [this, quadrature, update_flags, n_compositional_fields] (CellEvaluationScratch<dim> *returned_scratch)
+      {
+        std::lock_guard<std::mutex> lock (mutex);
+        available_objects.push_back (Entry {quadrature,
+                                            update_flags,
+                                            n_compositional_fields,
+                                            std::unique_ptr<CellEvaluationScratch<dim> >(returned_scratch)
+                                           });
+      });
+    }
+
+
+
+    template <int dim>
+    void
+    ScratchObjectPool<dim>::clear ()
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      available_objects.clear();
+    }
+  }
+}
+
+
+// explicit instantiations
+namespace aspect
+{
+#define INSTANTIATE(dim) \
+  template struct CellEvaluationScratch<dim>; \
+  namespace internal \
+  { \
+    template class ScratchObjectPool<dim>; \
+  }
+
+  ASPECT_INSTANTIATE(INSTANTIATE)
+
+#undef INSTANTIATE
+}
@@ -755,6 +755,20 @@ namespace aspect
 
 
 
+  template <int dim>
+  std::shared_ptr<CellEvaluationScratch<dim> >
+  SimulatorAccess<dim>::borrow_cell_evaluation_scratch (const Quadrature<dim> &quadrature,
+                                                        const UpdateFlags update_flags) const
+  {
+    return simulator->scratch_object_pool.borrow (*simulator->mapping,
+                                                  simulator->finite_element,
+                                                  quadrature,
+                                                  update_flags,
+                                                  simulator->introspection.n_compositional_fields);
+  }
+
+
+
   template <int dim>
   RotationProperties<dim>
   SimulatorAccess<dim>::compute_net_angular_momentum(const bool use_constant_density,
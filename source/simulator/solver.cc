@@ -842,6 +842,11 @@ namespace aspect
             if (parameters.n_cheap_stokes_solver_steps == 0)
               throw SolverControl::NoConvergence(0,0);
 
+            std::unique_ptr<TimerOutput::Scope> timer_section;
+            if (parameters.detailed_timing_output)
+              timer_section = std_cxx14::make_unique<TimerOutput::Scope> (computing_timer,
+                                                                         "Solve Stokes system: cheap solver iterations");
+
             SolverFGMRES<LinearAlgebra::BlockVector>
             solver(solver_control_cheap, mem,
                    SolverFGMRES<LinearAlgebra::BlockVector>::
@@ -878,6 +883,11 @@ namespace aspect
                              ExcMessage ("The Stokes solver did not converge in the number of requested cheap iterations and "
                                          "you requested 0 for ``Maximum number of expensive Stokes solver steps''. Aborting."));
 
+                std::unique_ptr<TimerOutput::Scope> timer_section;
+                if (parameters.detailed_timing_output)
+                  timer_section = std_cxx14::make_unique<TimerOutput::Scope> (computing_timer,
+                                                                             "Solve Stokes system: expensive solver iterations");
+
                 solver.solve(stokes_block,
                              distributed_stokes_solution,
                              distributed_stokes_rhs,
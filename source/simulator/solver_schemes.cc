@@ -215,6 +215,27 @@ namespace aspect
         Assert(initial_residual->size() == introspection.n_compositional_fields, ExcInternalError());
       }
 
+    // The linearization point does not change until all compositional fields
+    // are solved, so the material model outputs computed while assembling
+    // the first field can be reused for all other fields. The temperature
+    // system can not share these outputs: It is assembled before the
+    // temperature solve, and assemble_and_solve_temperature() then copies the
+    // new temperature into current_linearization_point, so the material model
+    // inputs of the compositional fields differ from those of the temperature.
+    //
+    // The storage for the outputs is kept between calls and only (re)allocated
+    // when the number of cells changes; here we only mark all entries invalid.
+    const bool reuse_material_model_evaluation = parameters.reuse_material_model_evaluation_for_compositional_fields
+                                                 && (introspection.n_compositional_fields > 1);
+    if (reuse_material_model_evaluation)
+      {
+        advection_material_model_outputs_cache.resize (triangulation.n_active_cells());
+        advection_heating_model_outputs_cache.resize (triangulation.n_active_cells());
+        advection_material_model_outputs_cache_valid.assign (triangulation.n_active_cells(), 0);
+        n_advection_material_model_evaluations = 0;
+        n_reused_advection_material_model_evaluations = 0;
+      }
+
     for (unsigned int c=0; c < introspection.n_compositional_fields; ++c)
       {
         const AdvectionField adv_field (AdvectionField::composition(c));
@@ -301,6 +322,23 @@ namespace aspect
           }
       }
 
+    if (reuse_material_model_evaluation)
+      {
+        advection_material_model_outputs_cache_valid.clear();
+
+        if (parameters.detailed_timing_output)
+          {
+            const double n_evaluations = Utilities::MPI::sum (static_cast<double>(n_advection_material_model_evaluations),
+                                                              mpi_communicator);
+            const double n_reused_evaluations = Utilities::MPI::sum (static_cast<double>(n_reused_advection_material_model_evaluations),
+                                                                     mpi_communicator);
+            if (n_evaluations + n_reused_evaluations > 0)
+              pcout << "   Reused the material model evaluation in "
+                    << 100. * n_reused_evaluations / (n_evaluations + n_reused_evaluations)
+                    << "% of the composition cell assemblies." << std::endl;
+          }
+      }
+
     // for consistency we update the current linearization point only after we have solved
     // all fields, so that we use the same point in time for every field when solving
     for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
@@ -388,6 +426,97 @@ namespace aspect
   }
 
 
+
+  template <int dim>
+  LinearAlgebra::BlockVector
+  Simulator<dim>::get_scaled_stokes_iterate (const LinearAlgebra::BlockVector &vector) const
+  {
+    // the Stokes partitioning has either one block that contains both
+    // velocity and pressure, or a velocity block followed by a pressure
+    // block, and these blocks are the first blocks of the system
+    LinearAlgebra::BlockVector iterate (introspection.index_sets.stokes_partitioning,
+                                        mpi_communicator);
+    for (unsigned int b=0; b<iterate.n_blocks(); ++b)
+      iterate.block(b) = vector.block(b);
+
+    const IndexSet &pressure_dofs = introspection.index_sets.locally_owned_pressure_dofs;
+    for (unsigned int i=0; i<pressure_dofs.n_elements(); ++i)
+      {
+        const types::global_dof_index idx = pressure_dofs.nth_index_in_set(i);
+        iterate(idx) /= pressure_scaling;
+      }
+    iterate.compress(VectorOperation::insert);
+
+    return iterate;
+  }
+
+
+
+  template <int dim>
+  void
+  Simulator<dim>::apply_nonlinear_solver_acceleration (internal::AndersonAcceleration &acceleration,
+                                                       const LinearAlgebra::BlockVector &scaled_linearization_point)
+  {
+    LinearAlgebra::BlockVector iterate = get_scaled_stokes_iterate (solution);
+    if (acceleration.apply (scaled_linearization_point, iterate) == false)
+      return;
+
+    const IndexSet &pressure_dofs = introspection.index_sets.locally_owned_pressure_dofs;
+    for (unsigned int i=0; i<pressure_dofs.n_elements(); ++i)
+      {
+        const types::global_dof_index idx = pressure_dofs.nth_index_in_set(i);
+        iterate(idx) *= pressure_scaling;
+      }
+    iterate.compress(VectorOperation::insert);
+
+    for (unsigned int b=0; b<iterate.n_blocks(); ++b)
+      {
+        solution.block(b) = iterate.block(b);
+        current_linearization_point.block(b) = iterate.block(b);
+      }
+  }
+
+
+
+  namespace
+  {
+    /**
+     * Create the object that accelerates the nonlinear iterations of the
+     * Stokes system, or return a null pointer if no acceleration was
+     * requested.
+     */
+    template <int dim>
+    std::unique_ptr<internal::AndersonAcceleration>
+    create_nonlinear_solver_acceleration (const Parameters<dim> &parameters)
+    {
+      if (parameters.nonlinear_solver_acceleration == Parameters<dim>::NonlinearSolverAcceleration::none)
+        return std::unique_ptr<internal::AndersonAcceleration>();
+
+      AssertThrow (parameters.include_melt_transport == false,
+                   ExcMessage ("Nonlinear solver acceleration is not supported for models "
+                               "with melt transport."));
+
+      return std_cxx14::make_unique<internal::AndersonAcceleration> (parameters.nonlinear_solver_acceleration_depth);
+    }
+
+
+
+    /**
+     * Add the number of accelerated nonlinear iterations and restarts of
+     * the acceleration in this time step to the statistics table.
+     */
+    void
+    add_nonlinear_solver_acceleration_statistics (const internal::AndersonAcceleration &acceleration,
+                                                  TableHandler &statistics)
+    {
+      statistics.add_value ("Number of accelerated nonlinear iterations",
+                            acceleration.n_accelerated_steps());
+      statistics.add_value ("Number of nonlinear acceleration restarts",
+                            acceleration.n_restarts());
+    }
+  }
+
+
   template <int dim>
   void Simulator<dim>::assemble_and_solve_defect_correction_Stokes(DefectCorrectionResiduals &dcr,
                                                                    const bool use_picard)
@@ -637,12 +766,12 @@ namespace aspect
             current_linearization_point.block(introspection.block_indices.pressure) += search_direction.block(introspection.block_indices.pressure);
             current_linearization_point.block(introspection.block_indices.velocities) += search_direction.block(introspection.block_indices.velocities);
 
-            // Rebuild the rhs to determine the new residual.
-            assemble_newton_stokes_matrix = rebuild_stokes_preconditioner = false;
-            rebuild_stokes_matrix = (boundary_velocity_manager.get_active_boundary_velocity_conditions().empty()
-                                     == false);
-
-            assemble_stokes_system();
+            // Rebuild the rhs to determine the new residual. The constraints
+            // are homogeneous after the first nonlinear iteration, so we
+            // neither need to assemble the matrix nor to update anything
+            // that is only needed for the matrix.
+            rebuild_stokes_preconditioner = false;
+            assemble_stokes_system (/*residual_only=*/ true);
 
             test_velocity_residual = system_rhs.block(introspection.block_indices.velocities).l2_norm();
             test_pressure_residual = system_rhs.block(introspection.block_indices.pressure).l2_norm();
@@ -752,10 +881,16 @@ namespace aspect
     SolverControl nonlinear_solver_control(max_nonlinear_iterations,
                                            parameters.nonlinear_tolerance);
 
+    const std::unique_ptr<internal::AndersonAcceleration> acceleration
+      = create_nonlinear_solver_acceleration (parameters);
+
     double relative_residual = std::numeric_limits<double>::max();
     nonlinear_iteration = 0;
     do
       {
+        const LinearAlgebra::BlockVector scaled_linearization_point
+          = (acceleration ? get_scaled_stokes_iterate (current_linearization_point) : LinearAlgebra::BlockVector());
+
         relative_residual =
           assemble_and_solve_stokes(nonlinear_iteration == 0, &initial_stokes_residual);
 
@@ -764,6 +899,9 @@ namespace aspect
               << std::endl
               << std::endl;
 
+        if (acceleration)
+          apply_nonlinear_solver_acceleration (*acceleration, scaled_linearization_point);
+
         if (parameters.run_postprocessors_on_nonlinear_iterations)
           postprocess ();
 
@@ -771,6 +909,9 @@ namespace aspect
       }
     while (nonlinear_solver_control.check(nonlinear_iteration, relative_residual) == SolverControl::iterate);
 
+    if (acceleration)
+      add_nonlinear_solver_acceleration_statistics (*acceleration, statistics);
+
     signals.post_nonlinear_solver(nonlinear_solver_control);
   }
 
@@ -1067,6 +1208,9 @@ namespace aspect
     SolverControl nonlinear_solver_control(max_nonlinear_iterations,
                                            parameters.nonlinear_tolerance);
 
+    const std::unique_ptr<internal::AndersonAcceleration> acceleration
+      = create_nonlinear_solver_acceleration (parameters);
+
     double relative_residual = std::numeric_limits<double>::max();
     nonlinear_iteration = 0;
 
@@ -1089,9 +1233,15 @@ namespace aspect
         const std::vector<double>  relative_composition_residual =
           assemble_and_solve_composition(nonlinear_iteration == 0, &initial_composition_residual);
 
+        const LinearAlgebra::BlockVector scaled_linearization_point
+          = (acceleration ? get_scaled_stokes_iterate (current_linearization_point) : LinearAlgebra::BlockVector());
+
         const double relative_nonlinear_stokes_residual =
           assemble_and_solve_stokes(nonlinear_iteration == 0, &initial_stokes_residual);
 
+        if (acceleration)
+          apply_nonlinear_solver_acceleration (*acceleration, scaled_linearization_point);
+
         // write the residual output in the same order as the solutions
         pcout << "      Relative nonlinear residuals (temperature, compositional fields, Stokes system): " << relative_temperature_residual;
         for (unsigned int c=0; c<introspection.n_compositional_fields; ++c)
@@ -1129,6 +1279,9 @@ namespace aspect
       }
     while (nonlinear_solver_control.check(nonlinear_iteration, relative_residual) == SolverControl::iterate);
 
+    if (acceleration)
+      add_nonlinear_solver_acceleration_statistics (*acceleration, statistics);
+
     signals.post_nonlinear_solver(nonlinear_solver_control);
   }
 
@@ -1156,10 +1309,16 @@ namespace aspect
     SolverControl nonlinear_solver_control(max_nonlinear_iterations,
                                            parameters.nonlinear_tolerance);
 
+    const std::unique_ptr<internal::AndersonAcceleration> acceleration
+      = create_nonlinear_solver_acceleration (parameters);
+
     double relative_residual = std::numeric_limits<double>::max();
     nonlinear_iteration = 0;
     do
       {
+        const LinearAlgebra::BlockVector scaled_linearization_point
+          = (acceleration ? get_scaled_stokes_iterate (current_linearization_point) : LinearAlgebra::BlockVector());
+
         relative_residual =
           assemble_and_solve_stokes(nonlinear_iteration == 0, &initial_stokes_residual);
 
@@ -1168,6 +1327,9 @@ namespace aspect
               << std::endl
               << std::endl;
 
+        if (acceleration)
+          apply_nonlinear_solver_acceleration (*acceleration, scaled_linearization_point);
+
         if (parameters.run_postprocessors_on_nonlinear_iterations)
           postprocess ();
 
@@ -1175,6 +1337,9 @@ namespace aspect
       }
     while (nonlinear_solver_control.check(nonlinear_iteration, relative_residual) == SolverControl::iterate);
 
+    if (acceleration)
+      add_nonlinear_solver_acceleration_statistics (*acceleration, statistics);
+
     signals.post_nonlinear_solver(nonlinear_solver_control);
   }
 
@@ -1481,6 +1646,8 @@ namespace aspect
   template void Simulator<dim>::solve_no_advection_single_stokes(); \
   template void Simulator<dim>::solve_iterated_advection_and_stokes(); \
   template void Simulator<dim>::solve_single_advection_iterated_stokes(); \
+  template LinearAlgebra::BlockVector Simulator<dim>::get_scaled_stokes_iterate(const LinearAlgebra::BlockVector &) const; \
+  template void Simulator<dim>::apply_nonlinear_solver_acceleration(internal::AndersonAcceleration &, const LinearAlgebra::BlockVector &); \
   template void Simulator<dim>::solve_no_advection_iterated_defect_correction_stokes(); \
   template void Simulator<dim>::solve_single_advection_iterated_defect_correction_stokes(); \
   template void Simulator<dim>::solve_iterated_advection_and_defect_correction_stokes(); \
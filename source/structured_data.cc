@@ -1212,6 +1212,29 @@ namespace aspect
     AsciiDataInitial<dim>::
     get_data_component (const Point<dim>                    &position,
                         const unsigned int                   component) const
+    {
+      return lookup->get_data(data_position(position),component);
+    }
+
+
+
+    template <int dim>
+    void
+    AsciiDataInitial<dim>::
+    get_data_components (const Point<dim>                    &position,
+                         std::vector<double>                 &values) const
+    {
+      const Point<dim> internal_position = data_position(position);
+      for (unsigned int c=0; c<values.size(); ++c)
+        values[c] = lookup->get_data(internal_position,c);
+    }
+
+
+
+    template <int dim>
+    Point<dim>
+    AsciiDataInitial<dim>::
+    data_position (const Point<dim> &position) const
     {
       Point<dim> internal_position = position;
 
@@ -1224,7 +1247,7 @@ namespace aspect
           for (unsigned int i = 0; i < dim; i++)
             internal_position[i] = spherical_position[i];
         }
-      return lookup->get_data(internal_position,component);
+      return internal_position;
     }
 
 
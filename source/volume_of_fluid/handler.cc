@@ -261,6 +261,18 @@ namespace aspect
                          "'Solver parameters/Composition solver tolerance' "
                          "for more details.");
 
+      prm.declare_entry ("Explicit volume fraction update", "false",
+                         Patterns::Bool (),
+                         "Whether to update the volume fractions in each direction "
+                         "of the dimensionally split advection step explicitly. "
+                         "Since the volume fractions are piecewise constant, the "
+                         "linear system of each directional update has a diagonal "
+                         "matrix. If this is set, only this diagonal is assembled "
+                         "and the right hand side is divided by it, instead of "
+                         "assembling the sparse matrix and solving the system with "
+                         "an iterative solver. The 'Volume of Fluid solver "
+                         "tolerance' is not used in this case.");
+
       prm.declare_entry ("Number initialization samples", "3",
                          Patterns::Integer (1),
                          "Number of divisions per dimension when computing the initial volume fractions."
@@ -332,6 +344,8 @@ namespace aspect
 
       volume_of_fluid_solver_tolerance = prm.get_double("Volume of Fluid solver tolerance");
 
+      explicit_volume_fraction_update = prm.get_bool("Explicit volume fraction update");
+
       n_init_samples = prm.get_integer ("Number initialization samples");
     }
     prm.leave_subsection ();
@@ -549,15 +563,32 @@ namespace aspect
     const unsigned int block0_idx = field_struct_for_field_index(0).volume_fraction.block_index;
     const unsigned int block_idx = field.volume_fraction.block_index;
 
-    if (block0_idx!=block_idx)
+    if (explicit_volume_fraction_update)
       {
-        // Allocate the system matrix for the current VoF field by
-        // reusing the Trilinos sparsity pattern from the matrix stored for
-        // composition 0 (this is the place we allocate the matrix at).
-        sim.system_matrix.block(block_idx, block_idx).reinit(sim.system_matrix.block(block0_idx, block0_idx));
+        // The matrix is diagonal, so only assemble its diagonal. All volume
+        // fractions use the same element, so the vector can be reused for
+        // every field and sweep as long as the mesh has not changed.
+        const IndexSet &locally_owned = this->introspection().index_sets.system_partitioning[block_idx];
+        if (explicit_update_diagonal.size() != locally_owned.size()
+            ||
+            explicit_update_diagonal.locally_owned_elements() != locally_owned)
+          explicit_update_diagonal.reinit (locally_owned,
+                                           this->get_mpi_communicator());
+        else
+          explicit_update_diagonal = 0;
       }
+    else
+      {
+        if (block0_idx!=block_idx)
+          {
+            // Allocate the system matrix for the current VoF field by
+            // reusing the Trilinos sparsity pattern from the matrix stored for
+            // composition 0 (this is the place we allocate the matrix at).
+            sim.system_matrix.block(block_idx, block_idx).reinit(sim.system_matrix.block(block0_idx, block0_idx));
+          }
 
-    sim.system_matrix.block(block_idx, block_idx) = 0;
+        sim.system_matrix.block(block_idx, block_idx) = 0;
+      }
     sim.system_rhs = 0;
 
     using CellFilter = FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>;
@@ -601,7 +632,10 @@ namespace aspect
          internal::Assembly::CopyData::
          VolumeOfFluidSystem<dim> (volume_of_fluid_fe));
 
-    sim.system_matrix.compress(VectorOperation::add);
+    if (explicit_volume_fraction_update)
+      explicit_update_diagonal.compress(VectorOperation::add);
+    else
+      sim.system_matrix.compress(VectorOperation::add);
     sim.system_rhs.compress(VectorOperation::add);
   }
 
@@ -610,6 +644,31 @@ namespace aspect
   template <int dim>
   void VolumeOfFluidHandler<dim>::copy_local_to_global_volume_of_fluid_system (const internal::Assembly::CopyData::VolumeOfFluidSystem<dim> &data)
   {
+    if (explicit_volume_fraction_update)
+      {
+        // The volume fractions are piecewise constant, so each cell has a
+        // single degree of freedom, the local matrices are the diagonal
+        // entries of the global matrix, and there are no constraints.
+        // The diagonal only stores the block of the current field, so
+        // convert the global indices into indices within that block.
+        Assert (data.local_dof_indices.size() == 1, ExcInternalError());
+        const BlockIndices &block_indices = sim.system_rhs.get_block_indices();
+
+        sim.system_rhs(data.local_dof_indices[0]) += data.local_rhs[0];
+        explicit_update_diagonal(block_indices.global_to_local(data.local_dof_indices[0]).second)
+          += data.local_matrix(0,0);
+
+        for (unsigned int f=0; f<GeometryInfo<dim>::max_children_per_face
+             * GeometryInfo<dim>::faces_per_cell; ++f)
+          if (data.face_contributions_mask[f])
+            {
+              sim.system_rhs(data.neighbor_dof_indices[f][0]) += data.local_face_rhs[f][0];
+              explicit_update_diagonal(block_indices.global_to_local(data.neighbor_dof_indices[f][0]).second)
+                += data.local_face_matrices_ext_ext[f](0,0);
+            }
+        return;
+      }
+
     // copy entries into the global matrix. note that these local contributions
     // only correspond to the advection dofs, as assembled above
     sim.current_constraints.distribute_local_to_global (data.local_matrix,
@@ -39,6 +39,24 @@ namespace aspect
     const unsigned int block_idx = field.volume_fraction.block_index;
 
     TimerOutput::Scope timer (sim.computing_timer, "Solve volume of fluid system");
+
+    if (explicit_volume_fraction_update)
+      {
+        this->get_pcout() << "   Updating volume of fluid system explicitly." << std::endl;
+
+        // Only the diagonal of the matrix has been assembled, so the
+        // solution of the linear system is the right hand side divided by it.
+        // The diagonal is not needed afterwards, so overwrite it with the
+        // solution rather than allocating another vector.
+        for (const types::global_dof_index i : explicit_update_diagonal.locally_owned_elements())
+          explicit_update_diagonal(i) = sim.system_rhs.block(block_idx)(i)
+                                        / explicit_update_diagonal(i);
+
+        explicit_update_diagonal.compress(VectorOperation::insert);
+        sim.solution.block(block_idx) = explicit_update_diagonal;
+        return;
+      }
+
     this->get_pcout() << "   Solving volume of fluid system... " << std::flush;
 
     const double tolerance = std::max(1e-50,
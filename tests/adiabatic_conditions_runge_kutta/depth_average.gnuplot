@@ -0,0 +1,77 @@
+# This file was generated by the deal.II library.
+
+
+#
+# For a description of the GNUPLOT format see the GNUPLOT manual.
+#
+# <depth> <time> <temperature> <adiabatic_temperature> <adiabatic_pressure> <adiabatic_density> <adiabatic_density_derivative> <velocity_magnitude> <sinking_velocity> <viscosity> <vertical_heat_flux> <vertical_mass_flux> 
+0 0 500.046 0 0 3319.34 0 0.00412132 0.000439247 1e+21 4.92451e-05 9.14854e-08 
+66000 0 500.046 0 0 3319.34 0 0.00412132 0.000439247 1e+21 4.92451e-05 9.14854e-08 
+
+0 0 500.046 0 0 3319.34 0 0.00412132 0.000439247 1e+21 4.92451e-05 9.14854e-08 
+66000 0 500.046 0 0 3319.34 0 0.00412132 0.000439247 1e+21 4.92451e-05 9.14854e-08 
+
+
+66000 0 508.385 0 2.43418e+09 3319.34 0 0.00476706 0.00129721 1e+21 0.00805529 2.70072e-07 
+132000 0 508.385 0 2.43418e+09 3319.34 0 0.00476706 0.00129721 1e+21 0.00805529 2.70072e-07 
+
+66000 0 508.385 0 2.43418e+09 3319.34 0 0.00476706 0.00129721 1e+21 0.00805529 2.70072e-07 
+132000 0 508.385 0 2.43418e+09 3319.34 0 0.00476706 0.00129721 1e+21 0.00805529 2.70072e-07 
+
+
+132000 0 568.438 0 4.84643e+09 3319.34 0 0.0053465 0.00205591 1e+21 0.0334793 4.27466e-07 
+198000 0 568.438 0 4.84643e+09 3319.34 0 0.0053465 0.00205591 1e+21 0.0334793 4.27466e-07 
+
+132000 0 568.438 0 4.84643e+09 3319.34 0 0.0053465 0.00205591 1e+21 0.0334793 4.27466e-07 
+198000 0 568.438 0 4.84643e+09 3319.34 0 0.0053465 0.00205591 1e+21 0.0334793 4.27466e-07 
+
+
+198000 0 668.738 0 7.30254e+09 3319.34 0 0.00561315 0.00258227 1e+21 0.0444044 5.35854e-07 
+264000 0 668.738 0 7.30254e+09 3319.34 0 0.00561315 0.00258227 1e+21 0.0444044 5.35854e-07 
+
+198000 0 668.738 0 7.30254e+09 3319.34 0 0.00561315 0.00258227 1e+21 0.0444044 5.35854e-07 
+264000 0 668.738 0 7.30254e+09 3319.34 0 0.00561315 0.00258227 1e+21 0.0444044 5.35854e-07 
+
+
+264000 0 770.478 0 9.7148e+09 3319.34 0 0.00563745 0.00279627 1e+21 0.0502407 5.79086e-07 
+330000 0 770.478 0 9.7148e+09 3319.34 0 0.00563745 0.00279627 1e+21 0.0502407 5.79086e-07 
+
+264000 0 770.478 0 9.7148e+09 3319.34 0 0.00563745 0.00279627 1e+21 0.0502407 5.79086e-07 
+330000 0 770.478 0 9.7148e+09 3319.34 0 0.00563745 0.00279627 1e+21 0.0502407 5.79086e-07 
+
+
+330000 0 871.522 0 1.21709e+10 3319.34 0 0.00565524 0.00267249 1e+21 0.0494723 5.52351e-07 
+396000 0 871.522 0 1.21709e+10 3319.34 0 0.00565524 0.00267249 1e+21 0.0494723 5.52351e-07 
+
+330000 0 871.522 0 1.21709e+10 3319.34 0 0.00565524 0.00267249 1e+21 0.0494723 5.52351e-07 
+396000 0 871.522 0 1.21709e+10 3319.34 0 0.00565524 0.00267249 1e+21 0.0494723 5.52351e-07 
+
+
+396000 0 957.53 0 1.46051e+10 3319.34 0 0.00534555 0.002235 1e+21 0.0273663 4.61247e-07 
+462000 0 957.53 0 1.46051e+10 3319.34 0 0.00534555 0.002235 1e+21 0.0273663 4.61247e-07 
+
+396000 0 957.53 0 1.46051e+10 3319.34 0 0.00534555 0.002235 1e+21 0.0273663 4.61247e-07 
+462000 0 957.53 0 1.46051e+10 3319.34 0 0.00534555 0.002235 1e+21 0.0273663 4.61247e-07 
+
+
+462000 0 996.914 0 1.70173e+10 3319.34 0 0.0045438 0.00160008 1e+21 0.00282741 3.29953e-07 
+528000 0 996.914 0 1.70173e+10 3319.34 0 0.0045438 0.00160008 1e+21 0.00282741 3.29953e-07 
+
+462000 0 996.914 0 1.70173e+10 3319.34 0 0.0045438 0.00160008 1e+21 0.00282741 3.29953e-07 
+528000 0 996.914 0 1.70173e+10 3319.34 0 0.0045438 0.00160008 1e+21 0.00282741 3.29953e-07 
+
+
+528000 0 1000 0 1.94515e+10 3319.34 0 0.00360955 0.000938747 1e+21 5.84509e-08 1.93559e-07 
+594000 0 1000 0 1.94515e+10 3319.34 0 0.00360955 0.000938747 1e+21 5.84509e-08 1.93559e-07 
+
+528000 0 1000 0 1.94515e+10 3319.34 0 0.00360955 0.000938747 1e+21 5.84509e-08 1.93559e-07 
+594000 0 1000 0 1.94515e+10 3319.34 0 0.00360955 0.000938747 1e+21 5.84509e-08 1.93559e-07 
+
+
+594000 0 1000 0 2.19076e+10 3319.34 0 0.00294339 0.000309557 1e+21 -1.90582e-08 6.38271e-08 
+660000 0 1000 0 2.19076e+10 3319.34 0 0.00294339 0.000309557 1e+21 -1.90582e-08 6.38271e-08 
+
+594000 0 1000 0 2.19076e+10 3319.34 0 0.00294339 0.000309557 1e+21 -1.90582e-08 6.38271e-08 
+660000 0 1000 0 2.19076e+10 3319.34 0 0.00294339 0.000309557 1e+21 -1.90582e-08 6.38271e-08 
+
+
@@ -0,0 +1,127 @@
+#include <aspect/simulator/anderson_acceleration.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+  using namespace aspect;
+
+  const unsigned int n = 8;
+
+  /**
+   * Iterate the affine fixed point map g(x) = M x + b, starting from zero,
+   * until the norm of g(x)-x is smaller than 1e-8 times its initial value,
+   * and return the number of times the map was evaluated. If
+   * @p acceleration is not a null pointer, every iterate is passed through
+   * it, the same way the Stokes iterates are in the iterated Stokes solver
+   * schemes.
+   */
+  unsigned int
+  iterate (const double (&M)[n][n],
+           const double (&b)[n],
+           internal::AndersonAcceleration *acceleration)
+  {
+    const std::vector<IndexSet> partitioning (1, complete_index_set(n));
+    LinearAlgebra::BlockVector x (partitioning, MPI_COMM_WORLD);
+    LinearAlgebra::BlockVector g (partitioning, MPI_COMM_WORLD);
+    x = 0;
+
+    double initial_residual = 0;
+    for (unsigned int k=1; k<=1000; ++k)
+      {
+        for (unsigned int i=0; i<n; ++i)
+          {
+            double value = 0;
+            for (unsigned int j=0; j<n; ++j)
+              value += M[i][j] * x(j);
+            g(i) = value + b[i];
+          }
+        g.compress (VectorOperation::insert);
+
+        LinearAlgebra::BlockVector residual (g);
+        residual -= x;
+        if (k == 1)
+          initial_residual = residual.l2_norm();
+        if (residual.l2_norm() / initial_residual < 1e-8)
+          return k;
+
+        if (acceleration != nullptr)
+          acceleration->apply (x, g);
+        x = g;
+      }
+
+    return numbers::invalid_unsigned_int;
+  }
+}
+
+
+
+int f()
+{
+  using namespace aspect;
+
+  // Set up a non-normal contraction M = Q D Q, where Q is a Householder
+  // reflection and D is upper bidiagonal with eigenvalues between 0.09 and
+  // 0.9. Because M is not normal, the residuals of the accelerated
+  // iterations do not always decrease, so the history is discarded from
+  // time to time. The fixed point of the map is (1,2,...,8).
+  double v[n], vv = 0;
+  for (unsigned int i=0; i<n; ++i)
+    {
+      v[i] = std::sin(1.7*(i+1)) + 0.3;
+      vv += v[i]*v[i];
+    }
+
+  double Q[n][n], D[n][n], QD[n][n], M[n][n];
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+        Q[i][j] = (i==j ? 1. : 0.) - 2*v[i]*v[j]/vv;
+        D[i][j] = (i==j ? 0.9*(1-0.9*i/(n-1)) : (j==i+1 ? 0.4 : 0.));
+      }
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+        QD[i][j] = 0;
+        for (unsigned int k=0; k<n; ++k)
+          QD[i][j] += Q[i][k]*D[k][j];
+      }
+  for (unsigned int i=0; i<n; ++i)
+    for (unsigned int j=0; j<n; ++j)
+      {
+        M[i][j] = 0;
+        for (unsigned int k=0; k<n; ++k)
+          M[i][j] += QD[i][k]*Q[k][j];
+      }
+
+  double b[n];
+  for (unsigned int i=0; i<n; ++i)
+    {
+      b[i] = i+1;
+      for (unsigned int j=0; j<n; ++j)
+        b[i] -= M[i][j] * (j+1);
+    }
+
+  std::cout << "Without acceleration: "
+            << iterate (M, b, nullptr) << " iterations" << std::endl;
+
+  for (unsigned int depth=1; depth<=3; ++depth)
+    {
+      internal::AndersonAcceleration acceleration (depth);
+      const unsigned int n_iterations = iterate (M, b, &acceleration);
+      std::cout << "Anderson acceleration with depth " << depth << ": "
+                << n_iterations << " iterations, "
+                << acceleration.n_accelerated_steps() << " accelerated iterations, "
+                << acceleration.n_restarts() << " restarts" << std::endl;
+    }
+
+  exit(0);
+  return 42;
+}
+// run this function by initializing a global variable by it
+int i = f();
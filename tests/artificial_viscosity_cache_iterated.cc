@@ -0,0 +1,75 @@
+#include <aspect/simulator_signals.h>
+#include <aspect/simulator_access.h>
+
+#include <map>
+
+namespace aspect
+{
+  // The artificial viscosity of each advection field in the first nonlinear
+  // iteration of the current time step, indexed by the compositional index
+  // (or numbers::invalid_unsigned_int for the temperature).
+  std::map<unsigned int, Vector<float> > first_iteration_viscosity;
+
+  /**
+   * Recompute the artificial viscosity of the field that was just solved,
+   * bypassing the cache the simulator uses to assemble the advection
+   * systems, and report how much it differs from the one of the first
+   * nonlinear iteration of this time step. The cached viscosity is only
+   * correct if this difference is zero.
+   */
+  template <int dim>
+  void post_advection_solver (const SimulatorAccess<dim> &simulator_access,
+                              const bool solved_temperature_field,
+                              const unsigned int compositional_index,
+                              const SolverControl &)
+  {
+    Vector<float> viscosity_per_cell (simulator_access.get_triangulation().n_active_cells());
+    if (solved_temperature_field)
+      simulator_access.get_artificial_viscosity (viscosity_per_cell);
+    else
+      simulator_access.get_artificial_viscosity_composition (viscosity_per_cell, compositional_index);
+
+    const unsigned int field_index = (solved_temperature_field
+                                      ?
+                                      numbers::invalid_unsigned_int
+                                      :
+                                      compositional_index);
+
+    if (simulator_access.get_nonlinear_iteration() == 0)
+      {
+        first_iteration_viscosity[field_index] = viscosity_per_cell;
+        return;
+      }
+
+    const Vector<float> &first_viscosity_per_cell = first_iteration_viscosity[field_index];
+    AssertThrow (first_viscosity_per_cell.size() == viscosity_per_cell.size(),
+                 ExcMessage ("The mesh changed within a time step."));
+
+    double max_difference = 0;
+    for (unsigned int i=0; i<viscosity_per_cell.size(); ++i)
+      max_difference = std::max (max_difference,
+                                 std::abs (static_cast<double>(viscosity_per_cell[i])
+                                           - first_viscosity_per_cell[i]));
+    max_difference = Utilities::MPI::max (max_difference, simulator_access.get_mpi_communicator());
+
+    const std::string field_name = (solved_temperature_field
+                                    ?
+                                    "temperature"
+                                    :
+                                    simulator_access.introspection().name_for_compositional_index(compositional_index));
+    simulator_access.get_pcout() << "   Change of the " << field_name
+                                 << " artificial viscosity since the first nonlinear iteration: "
+                                 << max_difference << std::endl;
+  }
+
+
+  template <int dim>
+  void signal_connector (SimulatorSignals<dim> &signals)
+  {
+    signals.post_advection_solver.connect (&post_advection_solver<dim>);
+  }
+
+
+  ASPECT_REGISTER_SIGNALS_CONNECTOR(signal_connector<2>,
+                                    signal_connector<3>)
+}
@@ -0,0 +1,15 @@
+#!/usr/bin/env perl
+
+# Only keep the time step headers and the lines that report the change
+# of the artificial viscosity, the rest of the screen output is already
+# checked by the iterated_advection_and_stokes test.
+
+$filename=$ARGV[0];
+while(<STDIN>)
+{
+    if ($filename eq "screen-output")
+    {
+	next unless m/\*\*\* Timestep|artificial viscosity/;
+    }
+    print $_;
+}
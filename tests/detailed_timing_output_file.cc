@@ -0,0 +1,80 @@
+#include <aspect/postprocess/interface.h>
+#include <aspect/simulator_access.h>
+#include <aspect/global.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+namespace aspect
+{
+  using namespace dealii;
+
+  /**
+   * Read the timing.jsonl file written in the previous time steps and
+   * report how many lines it has, which time step the last line belongs to,
+   * and how many cells the threads that assembled the Stokes system have
+   * evaluated the material model on in that time step.
+   */
+  template <int dim>
+  class TimingFilePostprocessor : public Postprocess::Interface<dim>, public ::aspect::SimulatorAccess<dim>
+  {
+    public:
+      virtual
+      std::pair<std::string,std::string>
+      execute (TableHandler &statistics);
+  };
+
+  template <int dim>
+  std::pair<std::string,std::string>
+  TimingFilePostprocessor<dim>::execute (TableHandler &)
+  {
+    // The file is written after the postprocessors have run, so there
+    // is nothing to check yet in the first time step
+    if (this->get_timestep_number() == 0)
+      return std::make_pair ("", "");
+
+    std::ifstream in ((this->get_output_directory() + "timing.jsonl").c_str());
+    AssertThrow (in, ExcMessage ("Could not open timing.jsonl."));
+
+    unsigned int n_lines = 0;
+    std::string line, last_line;
+    while (std::getline (in, line))
+      {
+        ++n_lines;
+        last_line = line;
+      }
+
+    const std::string timestep_key = "{\"timestep\": ";
+    AssertThrow (last_line.compare (0, timestep_key.size(), timestep_key) == 0,
+                 ExcMessage ("Unexpected line in timing.jsonl: " + last_line));
+    const unsigned int last_timestep = std::stoi (last_line.substr (timestep_key.size()));
+
+    const std::string stokes_key = "\"Assemble Stokes system\": {";
+    const std::string material_model_key = "\"Material model evaluation\": {\"calls\": ";
+    const std::size_t stokes_position = last_line.find (stokes_key);
+    AssertThrow (stokes_position != std::string::npos,
+                 ExcMessage ("No Stokes assembly in timing.jsonl: " + last_line));
+    const std::size_t material_model_position = last_line.find (material_model_key, stokes_position);
+    AssertThrow (material_model_position != std::string::npos,
+                 ExcMessage ("No material model evaluation in timing.jsonl: " + last_line));
+    const unsigned int n_calls = std::stoi (last_line.substr (material_model_position + material_model_key.size()));
+
+    std::ostringstream output;
+    output << n_lines << " lines, last time step " << last_timestep
+           << ", " << n_calls << " material model evaluations";
+    return std::make_pair ("Timing file:", output.str());
+  }
+}
+
+
+
+// explicit instantiations
+namespace aspect
+{
+  ASPECT_REGISTER_POSTPROCESSOR(TimingFilePostprocessor,
+                                "timing file",
+                                "A postprocessor that checks the contents of "
+                                "the timing.jsonl file.")
+}
@@ -0,0 +1,14 @@
+#!/usr/bin/env perl
+
+# Only keep the lines that describe the contents of the timing file, the
+# rest of the screen output is not of interest for this test.
+
+$filename=$ARGV[0];
+while(<STDIN>)
+{
+    if ($filename eq "screen-output")
+    {
+	next unless m/Timing file:/;
+    }
+    print $_;
+}
@@ -0,0 +1,29 @@
+#include <aspect/simulator.h>
+#include <iostream>
+
+/*
+ * Launch the following function when this plugin is created. Run ASPECT
+ * once with the input file of this test to fill the cache directory, and
+ * then let the current ASPECT run continue, which reads the velocity data
+ * from the cache.
+ */
+int f()
+{
+  // call ASPECT with "--" and pipe an existing input file into it. The
+  // output of this first run is not compared, so write it into a
+  // separate directory.
+  const std::string command = ("(cat " ASPECT_SOURCE_DIR "/tests/gplates_1_4_cache.prm "
+                               " ; "
+                               " echo 'set Output directory = output-gplates_1_4_cache/first_run' "
+                               ") "
+                               "| ../aspect -- > /dev/null");
+  const int ret = system (command.c_str());
+  if (ret!=0)
+    std::cout << "system() returned error " << ret << std::endl;
+
+  return 0;
+}
+
+
+// run this function by initializing a global variable by it
+int i = f();
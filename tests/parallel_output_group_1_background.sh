@@ -0,0 +1,14 @@
+#!/usr/bin/env perl
+
+# Only keep the lines that show where the graphical output was written,
+# the rest of the screen output is not of interest for this test.
+
+$filename=$ARGV[0];
+while(<STDIN>)
+{
+    if ($filename eq "screen-output")
+    {
+	next unless m/Writing graphical output/;
+    }
+    print $_;
+}
@@ -0,0 +1 @@
+#include "prescribed_dilation.cc"
@@ -0,0 +1,14 @@
+#!/usr/bin/env perl
+
+# Only keep the lines that show the size of the mesh, the rest of the
+# screen output is not of interest for this test.
+
+$filename=$ARGV[0];
+while(<STDIN>)
+{
+    if ($filename eq "screen-output")
+    {
+	next unless m/Number of active cells/;
+    }
+    print $_;
+}
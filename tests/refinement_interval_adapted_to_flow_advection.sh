@@ -0,0 +1,15 @@
+#!/usr/bin/env perl
+
+# Only keep the time step headers and the lines that show that the mesh
+# refinement was attempted, the rest of the screen output is not of
+# interest for this test.
+
+$filename=$ARGV[0];
+while(<STDIN>)
+{
+    if ($filename eq "screen-output")
+    {
+	next unless m/\*\*\* Timestep|No cells were flagged/;
+    }
+    print $_;
+}
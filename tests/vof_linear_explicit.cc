@@ -0,0 +1 @@
+#include "vof_linear.cc"